@@ -8,56 +8,13 @@
 # this version also compiles with Qt 5.x, but there are crashes with Qt 5.x on all
 #   platforms (Linux i386, Mac x64, Windows x86) which don't occur with Qt 4.x.
 
-TARGET = FUGE-LC
-TEMPLATE = app
+# core : static library with the fuzzy engine, libGGA, the coevolution, the scripts and the I/O
+# gui  : FUGE-LC, the application with its main window
+# cli  : fuge-cli, runs scripts, evaluations and predictions with QtCore only
 
-QT += core gui widgets xml
+TEMPLATE = subdirs
 
-include(libGGA/libGGA.pri)
-include(fuzzy/Fuzzy.pri)
-include(coev/Coev.pri)
-include(Dependencies/qwt/qwt.pri)
-include(Dependencies/duktape/duktape.pri)
-
-SOURCES += main.cpp \
-    fugemain.cpp \
-    aboutdialog.cpp \
-    errordialog.cpp \
-    fuzzymembershipssingle.cpp \
-    statsplot.cpp \
-    computethread.cpp \
-    systemparameters.cpp \
-    editparamsdialog.cpp \
-    evalplot.cpp \
-    infodialog.cpp \
-    fuzzyeditor.cpp \
-    scriptmanager.cpp \
-    helpdialog.cpp
-
-HEADERS += fugemain.h \
-    aboutdialog.h \
-    errordialog.h \
-    fuzzymembershipssingle.h \
-    statsplot.h \
-    computethread.h \
-    systemparameters.h \
-    editparamsdialog.h \
-    evalplot.h \
-    infodialog.h \
-    fuzzyeditor.h \
-    scriptmanager.h \
-    helpdialog.h
-
-FORMS += fugemain.ui \
-    aboutdialog.ui \
-    errordialog.ui \
-    statsplot.ui \
-    editparamsdialog.ui \
-    evalplot.ui \
-    infodialog.ui \
-    evalplotframe.ui \
-    fuzzyeditor.ui \
-    helpdialog.ui
-
-RESOURCES += fuzzyResources.qrc
+SUBDIRS = core gui cli
 
+gui.depends = core
+cli.depends = core
@@ -0,0 +1,418 @@
+/**
+  * @file   batchrunner.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  * @class BatchRunner
+  * @brief Runs a script, an evaluation, a prediction or an export from the command line
+  * without any widget.
+  */
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QtDebug>
+#include <iostream>
+
+#include "batchrunner.h"
+#include "computethread.h"
+#include "csourceexporter.h"
+#include "evaluationworker.h"
+#include "fuzzysystem.h"
+#include "genealogyarchive.h"
+#include "genealogyreader.h"
+#include "predictionclient.h"
+#include "predictionserver.h"
+#include "scriptmanager.h"
+#include "systemparameters.h"
+
+/**
+  * Constructor, a QCoreApplication must exist.
+  *
+  * @param commandLine Arguments parsed, runFromCmd must be set
+  */
+BatchRunner::BatchRunner(const CommandLine &commandLine) :
+    QObject(), commandLine(commandLine), scriptManager(NULL), computeThread(NULL), fSystemVars(NULL), fSystemRules(NULL)
+{
+}
+
+BatchRunner::~BatchRunner()
+{
+    delete scriptManager;
+    delete computeThread;
+    delete fSystemVars;
+    delete fSystemRules;
+}
+
+/**
+  * Read a dataset, each line split at the semicolons.
+  *
+  * @return false if the file cannot be opened
+  */
+bool BatchRunner::readDataset(const QString &fileName, QList<QStringList> *dataset)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Cannot open the dataset" << fileName;
+        return false;
+    }
+    QTextStream csvFile(&file);
+    while (!csvFile.atEnd())
+        dataset->append(csvFile.readLine().split(';'));
+    return true;
+}
+
+/**
+  * Perform the task of the command line.
+  *
+  * @return The exit code of the application
+  */
+int BatchRunner::exec()
+{
+    SystemParameters::getInstance().setVerbose(commandLine.verbose);
+    // An export needs no dataset
+    if (!commandLine.datasetFile.isEmpty() && !readDataset(commandLine.datasetFile, &dataset))
+        return 1;
+    if (commandLine.exportC)
+        return exportSource();
+    if (commandLine.eval)
+        return evaluate();
+    if (commandLine.predict)
+        return predict();
+    return runScript();
+}
+
+/**
+  * Load the fuzzy system of the command line, to be used on its dataset.
+  *
+  * @return The system, or NULL if the file cannot be loaded
+  */
+FuzzySystem *BatchRunner::loadFuzzySystem()
+{
+    FuzzySystem *fSystem = new FuzzySystem();
+    if (!fSystem->loadFromFile(commandLine.fuzzyFile)) {
+        qCritical() << "Cannot load the fuzzy system" << commandLine.fuzzyFile;
+        delete fSystem;
+        return NULL;
+    }
+    // The file names the dataset the system was evolved on, the one given replaces it
+    SystemParameters::getInstance().setDatasetName(commandLine.datasetFile);
+    fSystem->loadData(&dataset);
+    ComputeThread::bestFSystem = fSystem;
+    fSystemVars = fSystem;
+    return fSystem;
+}
+
+/**
+  * Evaluate the fuzzy system on the dataset and print its fitness and metrics.
+  */
+int BatchRunner::evaluate()
+{
+    FuzzySystem *fSystem = loadFuzzySystem();
+    if (fSystem == NULL)
+        return 1;
+    fSystem->doEvaluateFitness();
+    std::cout << "[Fitness] : " << fSystem->getFitness() << std::endl;
+    std::cout << "[Sensitivity] : " << fSystem->getSensitivity() << std::endl;
+    std::cout << "[Specificity] : " << fSystem->getSpecificity() << std::endl;
+    std::cout << "[Accuracy] : " << fSystem->getAccuracy() << std::endl;
+    std::cout << "[PPV] : " << fSystem->getPpv() << std::endl;
+    std::cout << "[RMSE] : " << fSystem->getRmse() << std::endl;
+    std::cout << "[RRSE] : " << fSystem->getRrse() << std::endl;
+    std::cout << "[RAE] : " << fSystem->getRae() << std::endl;
+    std::cout << "[MSE] : " << fSystem->getMse() << std::endl;
+    std::cout << "[ADM] : " << fSystem->getDistanceThreshold() << std::endl;
+    std::cout << "[MDM] : " << fSystem->getDistanceMinThreshold() << std::endl;
+    std::cout << "[SIZE] : " << fSystem->getDontCare() << std::endl;
+    std::cout << "[OverLearn] : " << fSystem->getOverLearn() << std::endl;
+    return 0;
+}
+
+/**
+  * Compute the outputs of the fuzzy system on the dataset and add them as columns to the
+  * dataset file, as the prediction dialog saves them.
+  */
+int BatchRunner::predict()
+{
+    FuzzySystem *fSystem = loadFuzzySystem();
+    if (fSystem == NULL)
+        return 1;
+    const int nbOutVars = SystemParameters::getInstance().getNbOutVars();
+    const QVector<float> computedResults = fSystem->doEvaluateFitness();
+
+    QFile file(commandLine.datasetFile);
+    file.remove();
+    if (!file.open(QIODevice::ReadWrite | QIODevice::Text)) {
+        qCritical() << "Cannot write the predictions to" << commandLine.datasetFile;
+        return 1;
+    }
+    QTextStream contents(&file);
+    for (int i = 0; i < dataset.size(); i++) {
+        // Fill the file with the original data
+        for (int k = 0; k < dataset.at(i).size(); k++)
+            contents << dataset.at(i).at(k) << ";";
+        // Add the output predictions to the file
+        for (int l = 0; l < nbOutVars; l++) {
+            if (i == 0)
+                contents << "Predicted output " << l << ";";
+            else
+                contents << fSystem->threshold(l, computedResults.at((i-1)*nbOutVars + l)) << ";";
+        }
+        contents << "\n";
+    }
+    contents.flush();
+    file.close();
+    return 0;
+}
+
+/**
+  * Write the fuzzy system as C source, see CSourceExporter. With a dataset, the outputs of
+  * the system on its samples are written too, for the self test of the source.
+  */
+int BatchRunner::exportSource()
+{
+    FuzzySystem *fSystem;
+    QVector<float> computedResults;
+    if (dataset.isEmpty()) {
+        fSystem = new FuzzySystem();
+        fSystemVars = fSystem;
+        if (!fSystem->loadFromFile(commandLine.fuzzyFile)) {
+            qCritical() << "Cannot load the fuzzy system" << commandLine.fuzzyFile;
+            return 1;
+        }
+    }
+    else {
+        fSystem = loadFuzzySystem();
+        if (fSystem == NULL)
+            return 1;
+        computedResults = fSystem->doEvaluateFitness();
+    }
+
+    CSourceExporter exporter(fSystem, QFileInfo(commandLine.fuzzyFile).fileName());
+    if (!dataset.isEmpty())
+        exporter.setTestSamples(&dataset, computedResults);
+    if (!exporter.write(commandLine.exportFile))
+        return 1;
+    std::cout << "Fuzzy system written to " << commandLine.exportFile.toStdString() << std::endl;
+    return 0;
+}
+
+/**
+  * Start the script and wait until all its runs are finished.
+  */
+int BatchRunner::runScript()
+{
+    scriptManager = new ScriptManager();
+    connect(scriptManager, SIGNAL(startRun()), this, SLOT(onStartRun()));
+    connect(scriptManager, SIGNAL(scriptFinished()), this, SLOT(onScriptFinished()));
+    scriptManager->setScriptFileName(commandLine.scriptFile);
+    scriptManager->readScript();
+    if (!scriptManager->isScriptReady())
+        return 1;
+    scriptManager->start();
+    return QCoreApplication::exec();
+}
+
+/**
+  * Slot called by the script manager when a run must be performed.
+  */
+void BatchRunner::onStartRun()
+{
+    delete fSystemVars;
+    delete fSystemRules;
+    fSystemVars = ComputeThread::newFuzzySystem(&dataset);
+    fSystemRules = ComputeThread::newFuzzySystem(&dataset);
+    ComputeThread::bestFSystem = fSystemVars;
+    ComputeThread::bestFitness = 0;
+    ComputeThread::bestFuzzySystemDescription.clear();
+
+    computeThread = new ComputeThread();
+    connect(computeThread, SIGNAL(computeFinished()), this, SLOT(onComputeFinished()));
+    computeThread->setFuzzySystem(fSystemVars, fSystemRules);
+    computeThread->start();
+}
+
+/**
+  * Slot called by the computational thread when a run is finished, the script goes on.
+  */
+void BatchRunner::onComputeFinished()
+{
+    computeThread->wait();
+    delete computeThread;
+    computeThread = NULL;
+    scriptSema.release();
+}
+
+/**
+  * Slot called by the script manager when the script is finished.
+  */
+void BatchRunner::onScriptFinished()
+{
+    scriptManager->wait();
+    QCoreApplication::quit();
+}
+
+/**
+  * Serve fitness evaluations until killed, see EvaluationWorker. A worker needs no display.
+  */
+int BatchRunner::runWorker(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    CommandLine commandLine;
+    if (!commandLine.parse(a.arguments()))
+        return 1;
+
+    // Read the csv file and store info in a double dimension list, once for all the runs.
+    QList<QStringList> *dataset = new QList<QStringList>;
+    if (!readDataset(commandLine.datasetFile, dataset))
+        return 1;
+
+    EvaluationWorker evaluationWorker(dataset);
+    if (!evaluationWorker.listen(commandLine.workerAddress))
+        return 1;
+    return a.exec();
+}
+
+/**
+  * Serve the predictions of fuzzy systems until killed, see PredictionServer. A server
+  * needs neither a dataset nor a display.
+  */
+int BatchRunner::runServer(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    const QStringList args = a.arguments();
+    if (args.size() < 4) {
+        std::cout << std::endl << "ERROR : Invalid parameters format !" << std::endl << std::endl;
+        std::cout << "Usage : " << args.at(0).toStdString() << " --serve socket fuzzyFile [fuzzyFile ...]" << std::endl << std::endl;
+        return 1;
+    }
+
+    PredictionServer server;
+    for (int i = 3; i < args.size(); i++) {
+        if (!server.addModel(args.at(i)))
+            return 1;
+    }
+    if (!server.listen(args.at(2)))
+        return 1;
+    return a.exec();
+}
+
+/**
+  * Measure the latency and the throughput of a prediction server with the samples of a
+  * dataset, see PredictionClient::loadTest().
+  */
+int BatchRunner::runLoadTest(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    const QStringList args = a.arguments();
+    bool clientsOk = true;
+    bool requestsOk = true;
+    const int clients = args.size() > 5 ? args.at(5).toInt(&clientsOk) : 1;
+    const int requests = args.size() > 6 ? args.at(6).toInt(&requestsOk) : 10000;
+    if (args.size() < 5 || args.size() > 7 || !clientsOk || !requestsOk) {
+        std::cout << std::endl << "ERROR : Invalid parameters format !" << std::endl << std::endl;
+        std::cout << "Usage : " << args.at(0).toStdString() << " --load-test socket system datasetFile [clients [requests]]" << std::endl << std::endl;
+        return 1;
+    }
+
+    QList<QStringList> dataset;
+    if (!readDataset(args.at(4), &dataset))
+        return 1;
+    return PredictionClient::loadTest(args.at(2), args.at(3), dataset, clients, requests);
+}
+
+/**
+  * Print a line of CSV for an individual of a genealogy archive.
+  */
+static void printIndividual(const GenealogyReader::Generation &generation, quint32 position)
+{
+    std::cout << generation.generation << "," << position << ","
+              << GenealogyReader::operatorNames(generation.operators[position]).toStdString() << ",";
+    if (generation.firstParents[position] != GenealogyArchive::NO_PARENT)
+        std::cout << generation.firstParents[position];
+    std::cout << ",";
+    if (generation.secondParents[position] != GenealogyArchive::NO_PARENT)
+        std::cout << generation.secondParents[position];
+    std::cout << "," << generation.fitness[position] << ",";
+    const QBitArray &genotype = generation.genotypes[position];
+    for (int k = 0; k < genotype.size(); k++)
+        std::cout << (genotype.testBit(k) ? '1' : '0');
+    std::cout << std::endl;
+}
+
+/**
+  * Print a generation of a genealogy archive as CSV, or the ancestors of one of its
+  * individuals, the oldest first. Needs neither a dataset nor a display.
+  */
+int BatchRunner::runGenealogy(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    const QStringList args = a.arguments();
+    if (args.size() < 5 || args.size() > 6) {
+        std::cout << std::endl << "ERROR : Invalid parameters format !" << std::endl << std::endl;
+        std::cout << "Usage : " << args.at(0).toStdString() << " --genealogy archive population generation [position]" << std::endl << std::endl;
+        return 1;
+    }
+
+    GenealogyReader reader;
+    if (!reader.open(args.at(2)))
+        return 1;
+    const int population = reader.findPopulation(args.at(3));
+    if (population < 0) {
+        std::cout << std::endl << "ERROR : no population \"" << args.at(3).toStdString() << "\" in the archive, it has :";
+        for (int i = 0; i < reader.getPopulations().size(); i++)
+            std::cout << " " << reader.getPopulations()[i].name.toStdString();
+        std::cout << std::endl << std::endl;
+        return 1;
+    }
+    bool ok = false;
+    const quint32 generation = args.at(4).toUInt(&ok);
+    if (!ok || !reader.hasGeneration(population, generation)) {
+        std::cout << std::endl << "ERROR : generation \"" << args.at(4).toStdString() << "\" not found, the last one is "
+                  << reader.getLastGeneration(population) << std::endl << std::endl;
+        return 1;
+    }
+
+    std::cout << "generation,position,operators,first_parent,second_parent,fitness,genotype" << std::endl;
+    GenealogyReader::Generation rebuilt;
+    if (args.size() == 5) {
+        if (!reader.readGeneration(population, generation, &rebuilt))
+            return 1;
+        for (quint32 i = 0; i < rebuilt.genotypes.size(); i++)
+            printIndividual(rebuilt, i);
+        return 0;
+    }
+
+    const quint32 position = args.at(5).toUInt(&ok);
+    QVector<GenealogyReader::Ancestor> ancestors;
+    if (!ok || !reader.readAncestry(population, generation, position, &ancestors)) {
+        std::cout << std::endl << "ERROR : invalid position \"" << args.at(5).toStdString() << "\"" << std::endl << std::endl;
+        return 1;
+    }
+    // The ancestors come newest first, the generations are rebuilt oldest first
+    for (int i = ancestors.size() - 1; i >= 0; i--) {
+        if (rebuilt.genotypes.empty() || rebuilt.generation != ancestors[i].generation) {
+            if (!reader.readGeneration(population, ancestors[i].generation, &rebuilt))
+                return 1;
+        }
+        printIndividual(rebuilt, ancestors[i].position);
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+  * @file   batchrunner.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  * @class BatchRunner
+  * @brief Runs a script, an evaluation, a prediction or an export from the command line
+  * without any widget.
+  *
+  * The runner does what the main window does in command line mode, but only needs a
+  * QCoreApplication : it starts the runs the script asks for one after the other and
+  * quits once the script is finished. fuge-cli always uses it, FUGE-LC uses it when the
+  * GUI is disabled with -g no. The workers, the prediction servers and the genealogy
+  * archives are served from here too.
+  */
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <QList>
+#include <QObject>
+#include <QStringList>
+
+#include "commandline.h"
+
+class ComputeThread;
+class FuzzySystem;
+class ScriptManager;
+
+class BatchRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    BatchRunner(const CommandLine &commandLine);
+    ~BatchRunner();
+
+    int exec();
+
+    static bool readDataset(const QString &fileName, QList<QStringList> *dataset);
+    static int runWorker(int argc, char *argv[]);
+    static int runGenealogy(int argc, char *argv[]);
+    static int runServer(int argc, char *argv[]);
+    static int runLoadTest(int argc, char *argv[]);
+
+private:
+    int evaluate();
+    int predict();
+    int exportSource();
+    int runScript();
+    FuzzySystem *loadFuzzySystem();
+
+    const CommandLine commandLine;
+    QList<QStringList> dataset;
+    ScriptManager *scriptManager;
+    ComputeThread *computeThread;
+    FuzzySystem *fSystemVars;
+    FuzzySystem *fSystemRules;
+
+private slots:
+    void onStartRun();
+    void onComputeFinished();
+    void onScriptFinished();
+};
+
+#endif // BATCHRUNNER_H
@@ -0,0 +1,12 @@
+# fuge-cli, runs scripts, evaluations and predictions without any widget nor display
+
+TARGET = fuge-cli
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+QT = core
+
+include(../core/core.pri)
+
+SOURCES += main.cpp
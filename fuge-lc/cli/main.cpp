@@ -0,0 +1,60 @@
+/**
+  * @file   main.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  * @brief fuge-cli main file. It takes the same arguments as FUGE-LC but only runs the
+  * tasks which need no window : scripts, evaluations, predictions, workers, prediction
+  * servers and genealogy archives.
+  */
+
+#include <QCoreApplication>
+#include <iostream>
+
+#include "batchrunner.h"
+#include "commandline.h"
+
+/**
+  * Main function.
+  */
+int main(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++) {
+        if (QString(argv[i]) == QString("--worker"))
+            return BatchRunner::runWorker(argc, argv);
+    }
+    if (argc > 1 && QString(argv[1]) == QString("--genealogy"))
+        return BatchRunner::runGenealogy(argc, argv);
+    if (argc > 1 && QString(argv[1]) == QString("--serve"))
+        return BatchRunner::runServer(argc, argv);
+    if (argc > 1 && QString(argv[1]) == QString("--load-test"))
+        return BatchRunner::runLoadTest(argc, argv);
+
+    CommandLine commandLine;
+    if (!commandLine.parse(CommandLine::arguments(argc, argv)))
+        return commandLine.help ? 0 : 1;
+    if (!commandLine.runFromCmd) {
+        std::cout << std::endl << "ERROR : fuge-cli needs a dataset and a script, or a fuzzy system to evaluate, see --help" << std::endl << std::endl;
+        return 1;
+    }
+
+    QCoreApplication a(argc, argv);
+    BatchRunner runner(commandLine);
+    return runner.exec();
+}
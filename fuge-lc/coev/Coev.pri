@@ -1,10 +1,28 @@
 INCLUDEPATH += $$PWD
 DEPENDPATH += $$PWD
 
-SOURCES += $$PWD/coevcooperator.cpp \
+SOURCES += $$PWD/bestsystemexporter.cpp \
+    $$PWD/bestsystemsnapshot.cpp \
+    $$PWD/coevcooperator.cpp \
+    $$PWD/coevevaluator.cpp \
     $$PWD/coevolution.cpp \
-    $$PWD/coevstats.cpp
+    $$PWD/coevstats.cpp \
+    $$PWD/evaluationfarm.cpp \
+    $$PWD/evaluationworker.cpp \
+    $$PWD/fitnesscache.cpp \
+    $$PWD/runcontext.cpp \
+    $$PWD/snapshotconsumer.cpp \
+    $$PWD/validationtracker.cpp
     
-HEADERS += $$PWD/coevcooperator.h \
+HEADERS += $$PWD/bestsystemexporter.h \
+    $$PWD/bestsystemsnapshot.h \
+    $$PWD/coevcooperator.h \
+    $$PWD/coevevaluator.h \
     $$PWD/coevolution.h \
-    $$PWD/coevstats.h
+    $$PWD/coevstats.h \
+    $$PWD/evaluationfarm.h \
+    $$PWD/evaluationworker.h \
+    $$PWD/fitnesscache.h \
+    $$PWD/runcontext.h \
+    $$PWD/snapshotconsumer.h \
+    $$PWD/validationtracker.h
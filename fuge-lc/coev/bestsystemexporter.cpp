@@ -0,0 +1,100 @@
+/**
+  * @file   bestsystemexporter.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  *
+  * @class BestSystemExporter
+  * @brief Exports the best system of a run to a .ffs file while the run goes on.
+  */
+
+#include <QFile>
+#include <QTextStream>
+
+#include "bestsystemexporter.h"
+#include "fileutility.h"
+#include "runcontext.h"
+
+/**
+  * Constructor. Call start() to begin exporting the submitted systems.
+  *
+  * @param context Run the systems belong to, its genome layout must be set
+  * @param fSystem Fuzzy system of the run, copied to rebuild the exported systems
+  * @param fileName .ffs file the best system is exported to, its metrics are written to
+  * the same name followed by .metrics
+  * @param interval Minimum time between two exports, in seconds
+  */
+BestSystemExporter::BestSystemExporter(RunContext *context, FuzzySystem *fSystem, const QString &fileName, int interval) :
+    SnapshotConsumer(new CoevEvaluator(context, fSystem->createEvaluationCopy(), true), qMax(0, interval) * 1000),
+    fileName(fileName)
+{
+}
+
+BestSystemExporter::~BestSystemExporter()
+{
+    finish();
+}
+
+/**
+  * Log the number of exports.
+  */
+void BestSystemExporter::report()
+{
+    qDebug() << "Best system exported " << getConsumed() << " times to " << fileName;
+}
+
+/**
+  * Rebuild the system of snapshot and write it, then its metrics. Each file replaces the
+  * previous one at once, the fitness of both tells whether they belong together.
+  */
+void BestSystemExporter::consume(BestSystemSnapshot *snapshot, int generation)
+{
+    evaluator->decodeMemberships(&snapshot->getMembershipsGenotype(), evaluator->getMembershipsPositions());
+    evaluator->decodeRules(&snapshot->getRulesGenotype(), evaluator->getRuleGenomes(), evaluator->getDefaultRules());
+    evaluator->evaluate(*evaluator->getMembershipsPositions(), evaluator->getRuleGenomes(), evaluator->getDefaultRules());
+
+    const QString tempName = fileName + ".tmp";
+    evaluator->getFuzzySystem()->saveToFile(tempName, snapshot->getFitness());
+    if (!FileUtility::replaceFileAtomically(tempName, fileName))
+        qCritical() << "Cannot replace the exported file" << fileName;
+
+    const QString metricsName = fileName + ".metrics";
+    QFile file(metricsName + ".tmp");
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qCritical() << "Cannot write the metrics of the best system to" << metricsName;
+        return;
+    }
+    QTextStream out(&file);
+    out << "generation " << generation << "\n";
+    out << "fitness " << snapshot->getFitness() << "\n";
+    out << "sensitivity " << snapshot->getSensitivity() << "\n";
+    out << "specificity " << snapshot->getSpecificity() << "\n";
+    out << "accuracy " << snapshot->getAccuracy() << "\n";
+    out << "ppv " << snapshot->getPpv() << "\n";
+    out << "rmse " << snapshot->getRmse() << "\n";
+    out << "rrse " << snapshot->getRrse() << "\n";
+    out << "rae " << snapshot->getRae() << "\n";
+    out << "mse " << snapshot->getMse() << "\n";
+    out << "size " << snapshot->getDontCare() << "\n";
+    out.flush();
+    file.close();
+    if (!FileUtility::replaceFileAtomically(metricsName + ".tmp", metricsName))
+        qCritical() << "Cannot replace the exported file" << metricsName;
+}
@@ -0,0 +1,55 @@
+/**
+  * @file   bestsystemexporter.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  *
+  * @class BestSystemExporter
+  * @brief Exports the best system of a run to a .ffs file while the run goes on.
+  *
+  * The exporter rebuilds the submitted systems and writes them with their metrics and
+  * generation. The files are written under a temporary name and renamed, so that a reader
+  * never sees a partial file.
+  */
+
+#ifndef BESTSYSTEMEXPORTER_H
+#define BESTSYSTEMEXPORTER_H
+
+#include <QString>
+
+#include "snapshotconsumer.h"
+
+class RunContext;
+
+class BestSystemExporter : public SnapshotConsumer
+{
+public:
+    BestSystemExporter(RunContext *context, FuzzySystem *fSystem, const QString &fileName, int interval);
+    ~BestSystemExporter();
+
+protected:
+    void consume(BestSystemSnapshot *snapshot, int generation);
+    void report();
+
+private:
+    const QString fileName;
+};
+
+#endif // BESTSYSTEMEXPORTER_H
@@ -0,0 +1,68 @@
+/**
+  * @file   bestsystemsnapshot.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class BestSystemSnapshot
+  * @brief Immutable copy of the best fuzzy system found so far.
+  */
+
+#include "bestsystemsnapshot.h"
+
+/**
+  * Copy the metrics and the description of a freshly evaluated fuzzy system.
+  *
+  * @param fSystem Fuzzy system which has just been evaluated
+  * @param fitness Fitness of the system
+  * @param membershipsGenotype Genotype of the membership functions individual
+  * @param rulesGenotype Genotype of the rules individual
+  */
+BestSystemSnapshot::BestSystemSnapshot(FuzzySystem *fSystem, qreal fitness, const QBitArray &membershipsGenotype, const QBitArray &rulesGenotype) :
+    fitness(fitness),
+    sensitivity(fSystem->getSensitivity()),
+    specificity(fSystem->getSpecificity()),
+    accuracy(fSystem->getAccuracy()),
+    ppv(fSystem->getPpv()),
+    rmse(fSystem->getRmse()),
+    rrse(fSystem->getRrse()),
+    rae(fSystem->getRae()),
+    mse(fSystem->getMse()),
+    distanceThreshold(fSystem->getDistanceThreshold()),
+    distanceMinThreshold(fSystem->getDistanceMinThreshold()),
+    dontCare(fSystem->getDontCare()),
+    overLearn(fSystem->getOverLearn()),
+    description(fSystem->getSystemDescritpion()),
+    membershipsGenotype(membershipsGenotype),
+    rulesGenotype(rulesGenotype),
+    references(1)
+{
+}
+
+/**
+  * Return true if a system of the given fitness and genotypes replaces this one. Of two
+  * systems of the same fitness the last one is kept, unless it is the same system : a
+  * plateau does not publish the same system again every generation.
+  */
+bool BestSystemSnapshot::isReplacedBy(qreal fitness, const QBitArray &membershipsGenotype, const QBitArray &rulesGenotype) const
+{
+    if (fitness != this->fitness)
+        return fitness > this->fitness;
+    return membershipsGenotype != this->membershipsGenotype || rulesGenotype != this->rulesGenotype;
+}
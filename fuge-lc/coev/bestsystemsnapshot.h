@@ -0,0 +1,93 @@
+/**
+  * @file   bestsystemsnapshot.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class BestSystemSnapshot
+  * @brief Immutable copy of the best fuzzy system found so far.
+  *
+  * The evolution threads keep rebuilding their fuzzy system for every evaluated pair, so
+  * the best system is never kept by pointer. A snapshot holds the fitness, the metrics,
+  * the description and the two genotypes the system was built from. It is never modified
+  * once published, readers can use it without any lock.
+  *
+  * A published snapshot is reference counted : the run holds one reference while it is the
+  * best system or may still be read by an evolver, the background consumers hold one until
+  * they are done with it. The last release() deletes it.
+  */
+
+#ifndef BESTSYSTEMSNAPSHOT_H
+#define BESTSYSTEMSNAPSHOT_H
+
+#include <QAtomicInt>
+#include <QBitArray>
+#include <QString>
+
+#include "fuzzysystem.h"
+
+class BestSystemSnapshot
+{
+public:
+    BestSystemSnapshot(FuzzySystem *fSystem, qreal fitness, const QBitArray &membershipsGenotype, const QBitArray &rulesGenotype);
+
+    inline qreal getFitness() const {return fitness;}
+    inline float getSensitivity() const {return sensitivity;}
+    inline float getSpecificity() const {return specificity;}
+    inline float getAccuracy() const {return accuracy;}
+    inline float getPpv() const {return ppv;}
+    inline float getRmse() const {return rmse;}
+    inline float getRrse() const {return rrse;}
+    inline float getRae() const {return rae;}
+    inline float getMse() const {return mse;}
+    inline float getDistanceThreshold() const {return distanceThreshold;}
+    inline float getDistanceMinThreshold() const {return distanceMinThreshold;}
+    inline float getDontCare() const {return dontCare;}
+    inline float getOverLearn() const {return overLearn;}
+    inline const QString &getDescription() const {return description;}
+    inline const QBitArray &getMembershipsGenotype() const {return membershipsGenotype;}
+    inline const QBitArray &getRulesGenotype() const {return rulesGenotype;}
+
+    bool isReplacedBy(qreal fitness, const QBitArray &membershipsGenotype, const QBitArray &rulesGenotype) const;
+
+    inline void retain() const {references.ref();}
+    inline void release() const {if (!references.deref()) delete this;}
+
+private:
+    const qreal fitness;
+    const float sensitivity;
+    const float specificity;
+    const float accuracy;
+    const float ppv;
+    const float rmse;
+    const float rrse;
+    const float rae;
+    const float mse;
+    const float distanceThreshold;
+    const float distanceMinThreshold;
+    const float dontCare;
+    const float overLearn;
+    const QString description;
+    const QBitArray membershipsGenotype;
+    const QBitArray rulesGenotype;
+    // Starts at one, the reference of the code which created the snapshot
+    mutable QAtomicInt references;
+};
+
+#endif // BESTSYSTEMSNAPSHOT_H
@@ -29,6 +29,8 @@
 
 CoevCooperator::CoevCooperator()
 {
+    coop = 0;
+    fitness = 0.0;
 }
 
 /**
@@ -43,8 +45,30 @@ CoevCooperator::CoevCooperator(PopEntity *coop, double fitness)
     this->fitness = fitness;
 }
 
+/**
+  * Alternate constructor. Allocates the storage needed to hold the decoded
+  * form of a cooperator of the given fuzzy system.
+  *
+  * @param fSystem Fuzzy system the cooperator will be evaluated with
+  */
+CoevCooperator::CoevCooperator(FuzzySystem *fSystem)
+{
+    coop = 0;
+    fitness = 0.0;
+    ruleGenomes.resize(fSystem->getNbRules());
+    for (int i = 0; i < ruleGenomes.size(); i++) {
+        ruleGenomes[i] = new FuzzyRuleGenome(fSystem->getNbVarPerRule(), fSystem->getNbInVars(),fSystem->getNbOutVars(),
+                                             fSystem->getInVarsCodeSize(),fSystem->getOutVarsCodeSize(),
+                                             fSystem->getInSetsCodeSize(), fSystem->getOutSetsCodeSize());
+    }
+    defRules.resize(fSystem->getDefaultRulesBitStringSize());
+}
+
 CoevCooperator::~CoevCooperator()
 {
+    for (int i = 0; i < ruleGenomes.size(); i++) {
+        delete ruleGenomes[i];
+    }
 }
 
 /**
@@ -85,3 +109,30 @@ void CoevCooperator::setFitness(double fit)
 {
     fitness = fit;
 }
+
+/**
+  * Return the decoded positions of the membership functions of the cooperator
+  *
+  */
+QVector<float>* CoevCooperator::getMembershipsPositions()
+{
+    return &membPositions;
+}
+
+/**
+  * Return the decoded rules of the cooperator
+  *
+  */
+FuzzyRuleGenome** CoevCooperator::getRuleGenomes()
+{
+    return ruleGenomes.data();
+}
+
+/**
+  * Return the decoded default rules bits of the cooperator
+  *
+  */
+int* CoevCooperator::getDefaultRules()
+{
+    return defRules.data();
+}
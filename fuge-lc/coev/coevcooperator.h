@@ -22,19 +22,25 @@
   *
   * @class CoevCooperator
   * @brief This class implements a coevolution cooperator. A cooperator is an individual who
-  * has been selected for its good fitness.
+  * has been selected for its good fitness. It also holds the decoded form of the individual
+  * so that it is decoded only once per generation and shared by all the pairings.
   */
 
 #ifndef COEVCOOPERATORS_H
 #define COEVCOOPERATORS_H
 
+#include <QVector>
+
 #include "popentity.h"
+#include "fuzzysystem.h"
+#include "fitnesscache.h"
 
 class CoevCooperator
 {
 public:
     CoevCooperator();
     CoevCooperator(PopEntity *coop, double fitness);
+    CoevCooperator(FuzzySystem *fSystem);
     virtual ~CoevCooperator();
 
     PopEntity *getCoop();
@@ -44,10 +50,23 @@ public:
     inline void setId(int value) {id = value;}
     inline int getId() {return id;}
 
+    QVector<float>* getMembershipsPositions();
+    FuzzyRuleGenome** getRuleGenomes();
+    int* getDefaultRules();
+    inline void setCacheKey(const FitnessCache::Key &key) {cacheKey = key;}
+    inline const FitnessCache::Key &getCacheKey() const {return cacheKey;}
+
 private:
     PopEntity *coop;
     double fitness;
     int id;
+
+    // Decoded phenotype, only one of the two halves is used
+    QVector<float> membPositions;
+    QVector<FuzzyRuleGenome*> ruleGenomes;
+    QVector<int> defRules;
+    // Hash of the genotype, used to look up the fitness cache
+    FitnessCache::Key cacheKey;
 };
 
 #endif // COEVCOOPERATOR_H
@@ -0,0 +1,123 @@
+/**
+  * @file   coevevaluator.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class CoevEvaluator
+  * @brief Everything needed to decode and evaluate pairs in one thread.
+  */
+
+#include "coevevaluator.h"
+
+/**
+  * Constructor
+  *
+  * @param context Run the pairs belong to, its genome layout must be set
+  * @param fSystem Fuzzy system the pairs are evaluated with
+  * @param ownsSystem True if the fuzzy system is deleted with the evaluator
+  */
+CoevEvaluator::CoevEvaluator(RunContext *context, FuzzySystem *fSystem, bool ownsSystem) :
+    fSystem(fSystem), ownsSystem(ownsSystem), layout(context->getGenomeLayout()), evaluationCount(0)
+{
+    membGen = new FuzzyMembershipsGenome(fSystem->getNbInVars(),fSystem->getNbOutVars(),
+                                         fSystem->getNbInSets(),fSystem->getNbOutSets(),
+                                         fSystem->getInSetsPosCodeSize(), fSystem->getOutSetsPosCodeSize());
+    ruleGenTab.resize(fSystem->getNbRules());
+    for (int i = 0; i < ruleGenTab.size(); i++) {
+        ruleGenTab[i] = new FuzzyRuleGenome(fSystem->getNbVarPerRule(), fSystem->getNbInVars(),fSystem->getNbOutVars(),
+                                            fSystem->getInVarsCodeSize(),fSystem->getOutVarsCodeSize(),
+                                            fSystem->getInSetsCodeSize(), fSystem->getOutSetsCodeSize());
+    }
+    defRules.resize(fSystem->getDefaultRulesBitStringSize());
+
+    // Large datasets are split in sample ranges evaluated in parallel
+    if (context->getSamplePool() != NULL)
+        fSystem->setSampleShards(context->getSamplePool(), context->getSampleShards());
+}
+
+CoevEvaluator::~CoevEvaluator()
+{
+    delete membGen;
+    for (int i = 0; i < ruleGenTab.size(); i++) {
+        delete ruleGenTab[i];
+    }
+    if (ownsSystem)
+        delete fSystem;
+    else
+        fSystem->setSampleShards(NULL, 0);
+}
+
+/**
+  * Decode a membership functions genotype into the absolute positions of its sets.
+  *
+  * @param genotypeData Genotype of population 1 (membership functions)
+  * @param positions Vector receiving the positions
+  */
+void CoevEvaluator::decodeMemberships(const QBitArray *genotypeData, QVector<float> *positions)
+{
+    membGen->readGenomeBitString(genotypeData, layout.membersGenSize);
+    fSystem->computeMembershipsPositions(membGen, positions);
+}
+
+/**
+  * Decode a rules genotype into rule genomes and default rules bits.
+  *
+  * @param genotypeData Genotype of population 2 (rules)
+  * @param ruleGens Array of nbRules rule genomes to be filled
+  * @param defRulesBits Array receiving the default rules bits
+  */
+void CoevEvaluator::decodeRules(const QBitArray *genotypeData, FuzzyRuleGenome **ruleGens, int *defRulesBits)
+{
+    // Rules are decoded straight from the packed genotype, each one starting
+    // at k*ruleBitStringSize. The fixed vars layout only encodes the sets.
+    if (layout.fixedVars) {
+        for (int k = 0; k < layout.nbRules; k++)
+            ruleGens[k]->readGenomeFixedVarsBitArray(genotypeData, k*layout.ruleBitStringSize);
+    }
+    else {
+        for (int k = 0; k < layout.nbRules; k++)
+            ruleGens[k]->readGenomeBitArray(genotypeData, k*layout.ruleBitStringSize);
+    }
+
+    // Default rules transcription
+    for (int i = 0; i < layout.defRulesSize; i++) {
+        defRulesBits[i] = genotypeData->testBit(layout.defRulesPos+i);
+    }
+}
+
+/**
+  * Build the fuzzy system from already decoded halves and evaluate it against the dataset.
+  *
+  * @param positions Positions of the membership functions
+  * @param ruleGens Decoded rules
+  * @param defRulesBits Default rules bits
+  * @return Fitness of the system
+  */
+float CoevEvaluator::evaluate(const QVector<float> &positions, FuzzyRuleGenome **ruleGens, int *defRulesBits)
+{
+    // Reset the previous fuzzy system
+    fSystem->reset();
+
+    // Load the genomes
+    fSystem->loadMembershipsPositions(positions);
+    fSystem->loadRulesGenome(ruleGens, defRulesBits);
+    evaluationCount++;
+    return fSystem->evaluateFitness();
+}
@@ -0,0 +1,73 @@
+/**
+  * @file   coevevaluator.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class CoevEvaluator
+  * @brief Everything needed to decode and evaluate pairs in one thread.
+  *
+  * An evaluator holds a fuzzy system and the genomes the individuals are decoded into.
+  * Each evolver has one on its own fuzzy system and each worker of the evaluation pool
+  * has one on a copy of it, so that several pairs can be evaluated at the same time.
+  */
+
+#ifndef COEVEVALUATOR_H
+#define COEVEVALUATOR_H
+
+#include <QBitArray>
+#include <QVector>
+
+#include "fuzzysystem.h"
+#include "fuzzymembershipsgenome.h"
+#include "fuzzyrulegenome.h"
+#include "runcontext.h"
+
+class CoevEvaluator
+{
+public:
+    CoevEvaluator(RunContext *context, FuzzySystem *fSystem, bool ownsSystem);
+    ~CoevEvaluator();
+
+    void decodeMemberships(const QBitArray *genotypeData, QVector<float> *positions);
+    void decodeRules(const QBitArray *genotypeData, FuzzyRuleGenome **ruleGens, int *defRulesBits);
+    float evaluate(const QVector<float> &positions, FuzzyRuleGenome **ruleGens, int *defRulesBits);
+
+    inline FuzzySystem *getFuzzySystem() {return fSystem;}
+    inline QVector<float> *getMembershipsPositions() {return &membPositions;}
+    inline FuzzyRuleGenome **getRuleGenomes() {return ruleGenTab.data();}
+    inline int *getDefaultRules() {return defRules.data();}
+    inline quint64 getEvaluationCount() const {return evaluationCount;}
+
+private:
+    FuzzySystem *fSystem;
+    bool ownsSystem;
+    // Copied from the run context, read for every decoded individual
+    RunContext::GenomeLayout layout;
+
+    // Genomes the evaluated individual is decoded into, allocated once per run
+    FuzzyMembershipsGenome* membGen;
+    QVector<FuzzyRuleGenome*> ruleGenTab;
+    QVector<int> defRules;
+    QVector<float> membPositions;
+    // Number of systems evaluated, read once the evaluating thread is done
+    quint64 evaluationCount;
+};
+
+#endif // COEVEVALUATOR_H
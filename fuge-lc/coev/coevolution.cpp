@@ -34,13 +34,48 @@ int counterCoops = 0;
 /**
   * Constructor
   *
-  * @param ComputeThread::fSystem Pointer to an existing fuzzy system
+  * @param context Run the evolver belongs to
+  * @param fSystem Pointer to an existing fuzzy system
   */
-CoEvolution::CoEvolution(FuzzySystem *fSystem, QMutex *leftLock, QMutex *rightLock, Population *left, Population *right, quint32 generationCount, qreal crossoverProbability, qreal mutationProbability, qreal mutationPerBitProbability, quint32 eliteSize, quint32 cooperatorsCount, QObject *parent) : EvolutionEngine(left, generationCount, crossoverProbability, mutationProbability, mutationPerBitProbability), QThread(parent), fSystem(fSystem), leftLock(leftLock), rightLock(rightLock), eliteSize(eliteSize), left(left), right(right), generationCount(generationCount), cooperatorsCount(cooperatorsCount)
+CoEvolution::CoEvolution(RunContext *context, FuzzySystem *fSystem, SpeciesScheduler *scheduler, int species, Population *left, Population *right, quint32 generationCount, qreal crossoverProbability, qreal mutationProbability, qreal mutationPerBitProbability, quint32 eliteSize, quint32 cooperatorsCount, QObject *parent) : EvolutionEngine(left, generationCount, crossoverProbability, mutationProbability, mutationPerBitProbability), QThread(parent), context(context), fSystem(fSystem), scheduler(scheduler), species(species), eliteSize(eliteSize), left(left), right(right), generationCount(generationCount), cooperatorsCount(cooperatorsCount), evaluationJob(this)
 {
     isFirst = true;
     needToSave = false;
     fileName.clear();
+
+    evaluator = new CoevEvaluator(context, fSystem, false);
+    cooperatorsInUse = 0;
+    evaluatedEntities = 0;
+    evaluatingMemberships = false;
+    farmClient = NULL;
+    farmDown = false;
+    snapshotReader = -1;
+
+    // Parents selection method chosen in the script, the rank based one by default
+    const bool isMemberships = (left->getName() == "MEMBERSHIPS");
+    const QString method = context->getSelection(species);
+    const float param = context->getSelectionParam(species);
+    EntitySelection *selection = EntitySelection::fromName(method, param);
+    if (selection != NULL)
+        replaceEntitySelector(1, selection);
+    else
+        qCritical() << "Unknown selection method" << method << ", using the rank based selection";
+
+    // Crossover chosen in the script, the one point crossover by default
+    const QString crossover = context->getCrossover(species);
+    if (crossover == "uniform") {
+        replaceCrossoverMethod(0, new Uniform());
+    }
+    else if (crossover == "arithmetic" && isMemberships) {
+        // Blend the decoded membership positions, laid out as in FuzzyMembershipsGenome
+        Arithmetic *arithmetic = new Arithmetic();
+        arithmetic->addFields(fSystem->getNbInVars()*fSystem->getNbInSets(), fSystem->getInSetsPosCodeSize());
+        arithmetic->addFields(fSystem->getNbOutVars()*fSystem->getNbOutSets(), fSystem->getOutSetsPosCodeSize());
+        replaceCrossoverMethod(0, arithmetic);
+    }
+    else if (crossover != "onepoint") {
+        qCritical() << "Invalid crossover method" << crossover << ", using the one point crossover";
+    }
 }
 
 /**
@@ -48,6 +83,10 @@ CoEvolution::CoEvolution(FuzzySystem *fSystem, QMutex *leftLock, QMutex *rightLo
  */
 CoEvolution::~CoEvolution()
 {
+    delete evaluator;
+    for (int i = 0; i < cooperators.size(); i++) {
+        delete cooperators[i];
+    }
 }
 
 /**
@@ -57,11 +96,29 @@ void CoEvolution::run(){
     // Command the verbose output print
     qDebug() << "RUN : " << left->getName() << " : left_getsize : " << left->getSize();
 
+    // The best snapshot this evolver and its evaluation jobs read stays valid until
+    // the next generation
+    snapshotReader = context->registerSnapshotReader();
+
+    // The connections to the evaluation workers belong to this thread
+    if (context->getEvaluationFarm() != NULL)
+        farmClient = new EvaluationFarm::Client(context->getEvaluationFarm());
+
+    // Every evolver of a seeded run draws from its own stream, derived from the seed, its
+    // island and its species
+    if (context->getRandomSeed() >= 0)
+        RandomGenerator::getGeneratorInstance()->seed(((quint64) context->getRandomSeed() << 16) + 1 + 2 * getIsland() + species);
+
     //TODO set generation values trough the interface.
-    startEvolution(leftLock,rightLock, generationCount,
+    startEvolution(scheduler, species, generationCount,
                    getEntitySelectors().at(0),eliteSize,
                    getEntitySelectors().at(1),left->getSize()-eliteSize,
                    getMutationMethods().at(0),getCrossoverMethods().at(0), cooperatorsCount);
+
+    delete farmClient;
+    farmClient = NULL;
+    context->unregisterSnapshotReader(snapshotReader);
+    snapshotReader = -1;
 }
 
 /**
@@ -72,189 +129,404 @@ void CoEvolution::run(){
  */
 bool CoEvolution::evaluatePopulation(Population* population, quint32 generation){
 
-    //Evaluate our population with the other cooperators(elites)
-    vector<PopEntity *> leftPopEntities = population->getAllEntities();
-    vector<PopEntity *> RightRepresentative;
-
-    // Due to multithreading representatives from the other population might not be ready.
-    RightRepresentative = right->getRepresentativesCopy();
+    // No best snapshot read during the previous generation is used any more
+    context->snapshotReaderQuiescent(snapshotReader);
 
-    vector<PopEntity *>::iterator itLeftPop, itRepresentative;
-
-    PopEntity *bestCurrGenRepresentative = 0;
-    PopEntity *bestCurrGenLeftPopEntity = 0;
-    qreal currentIndBestFit = 0.0;
-    qreal overallBestFit = 0.0;
-    for(itLeftPop=leftPopEntities.begin(); itLeftPop!=leftPopEntities.end(); itLeftPop++)
-    {
-        currentIndBestFit = 0.0;
-        // Loop through all cooperators
-        for(itRepresentative=RightRepresentative.begin(); itRepresentative!=RightRepresentative.end(); itRepresentative++)
-        {
-            fitness = 0.0;
-            if(left->getName() == "MEMBERSHIPS")
-                calcFitness((*itLeftPop),(*itRepresentative));
-            else
-                calcFitness((*itRepresentative), (*itLeftPop));
-            if (fitness > currentIndBestFit) {
-                currentIndBestFit = fitness;
-                if(fitness > overallBestFit) {
-                    overallBestFit = fitness;
-                    bestCurrGenRepresentative = *itRepresentative;
-                    bestCurrGenLeftPopEntity = *itLeftPop;
-                }
-                (*itLeftPop)->setFitness(fitness); // choose the best fit, between ind & all coops
-            }
-            if(ComputeThread::stop)
-                break;
-        }
-        if(currentIndBestFit)
-            getStatisticEngine()->addFitness(fitness);
-        if(ComputeThread::stop)
-            break;
+    //Evaluate our population with the other cooperators(elites)
+    const vector<PopEntity *> &leftPopEntities = population->getAllEntities();
+    const quint32 size = leftPopEntities.size();
+
+    // Representatives published by the other population, they stay unchanged until
+    // released even if the other population publishes new ones meanwhile.
+    const Population::Representatives *rightRepresentatives = right->acquireRepresentatives();
+
+    // The representatives are the same for every individual of this generation,
+    // decode them once and only decode the evaluated individual per pairing.
+    decodeCooperators(rightRepresentatives->getEntities());
+
+    evaluatedEntities = &leftPopEntities;
+    evaluatingMemberships = (left->getName() == "MEMBERSHIPS");
+    entityBestFitness.fill(0.0, size);
+
+    // The individuals are evaluated by chunks on the shared pool, a few chunks per
+    // worker so that the workers done first steal from the others.
+    // The worker processes are preferred, the pool only takes over if none answers.
+    WorkStealingPool *pool = context->getEvaluationPool();
+    if (farmClient != NULL && evaluateOnFarm(size)) {
+        // Done by the workers
+    }
+    else if (pool != NULL && size > 1) {
+        const quint32 grain = qMax((quint32) 1, size / (4 * pool->getWorkerCount()));
+        chunkCandidates.resize(WorkStealingPool::getChunkCount(size, grain));
+        pool->run(&evaluationJob, size, grain);
+    }
+    else {
+        chunkCandidates.resize(1);
+        evaluateRange(evaluator, 0, 0, size);
     }
 
-    // FIXME: HOT fix because the best fuzzy system is the last generation best fuzzy system
-    // which is wrong, but until we continue to use ELITISM it will work.
-    // This should not be needed, instead the whole fuzzy system object should be saved on computeThread !
-    if( bestCurrGenLeftPopEntity )
-    {
-        if(left->getName() == "MEMBERSHIPS")
-            calcFitness(bestCurrGenLeftPopEntity, bestCurrGenRepresentative);
-        else
-            calcFitness(bestCurrGenRepresentative, bestCurrGenLeftPopEntity);
+    // Reduce in chunk order, so that the best system does not depend on the scheduling.
+    // Of the pairs of the same fitness, the last one in evaluation order is kept.
+    int bestChunk = -1;
+    for (int i = 0; i < chunkCandidates.size(); i++) {
+        if (chunkCandidates[i].fitness >= 0.0 && (bestChunk < 0 || chunkCandidates[i].fitness >= chunkCandidates[bestChunk].fitness))
+            bestChunk = i;
+    }
+    if (bestChunk >= 0) {
+        const PairCandidate &best = chunkCandidates[bestChunk];
+        const QBitArray *entityData = (*evaluatedEntities)[best.entity]->getGenotype()->getData();
+        const QBitArray *coopData = cooperators[best.cooperator]->getCoop()->getGenotype()->getData();
+        const QBitArray *memberships = evaluatingMemberships ? entityData : coopData;
+        const QBitArray *rules = evaluatingMemberships ? coopData : entityData;
+        if (context->isBetterSystem(best.fitness, memberships, rules))
+            offerPair(memberships, rules);
+    }
+    for (quint32 i = 0; i < size; i++) {
+        if (entityBestFitness[i] > 0.0)
+            getStatisticEngine()->addFitness(entityBestFitness[i]);
     }
 
-    // Delete representatives
-    for(int i = 0; i < RightRepresentative.size(); i++)
-        delete RightRepresentative[i];
+    // Release the cooperators
+    for(int i = 0; i < cooperatorsInUse; i++)
+        cooperators[i]->setCoop(0);
+    cooperatorsInUse = 0;
+    right->releaseRepresentatives(rightRepresentatives);
 
     // Print the output in verbose mode if needed
-    if (ComputeThread::sysParams->getVerbose()) {
-        std::cout << "verbose (evalop) is " << ComputeThread::sysParams->getVerbose() << std::endl;
+    if (context->getVerbose()) {
+        std::cout << "verbose (evalop) is " << context->getVerbose() << std::endl;
         fSystem->printVerboseOutput();
     }
 
     // Build stats
     statsEngine.buildStats();
-    // Plot stats and save fuzzy system
-    ComputeThread::saveSystemStats(population->getName(), statsEngine.getMinFitness(),statsEngine.getMaxFitness(),statsEngine.getMeanFitness(),statsEngine.getStandardDeviation(),population->getSize(), generation);
+    // Plot stats and save fuzzy system, the first island stands for the others
+    if (getIsland() == 0)
+        context->saveSystemStats(population->getName(), statsEngine.getMinFitness(),statsEngine.getMaxFitness(),statsEngine.getMeanFitness(),statsEngine.getStandardDeviation(),population->getSize(), generation);
 
     // Reset stats engine
     statsEngine.reset();
 
-    // Stop in case max fitness reached.
-    if( ComputeThread::bestFSystem != NULL && ComputeThread::sysParams != NULL )
-    {
-        if (left->getName() == "MEMBERSHIPS"){
-            if(ComputeThread::bestFSystem->getFitness() >= ComputeThread::sysParams->getMaxFitPop1())
-                emit fitnessThreshReached();
-        }else{
-            if(ComputeThread::bestFSystem->getFitness() >= ComputeThread::sysParams->getMaxFitPop2())
-                emit fitnessThreshReached();
-        }
+    // A save requested from the GUI during the run is done between two generations,
+    // by the thread which owns the fuzzy system of the memberships population.
+    if (evaluatingMemberships && getIsland() == 0) {
+        QString saveFileName = context->takePendingSave();
+        if (!saveFileName.isEmpty())
+            onSaveSystem(saveFileName);
     }
 
-    return !ComputeThread::stop;
+    // Stop once the best systems no longer improve on the validation dataset
+    context->endGeneration(generation);
+
+    // Stop in case max fitness reached.
+    const BestSystemSnapshot *best = context->getBestSnapshot();
+    if (best != NULL && best->getFitness() >= context->getMaxFitness(species))
+        emit fitnessThreshReached();
+
+    return !context->isStopRequested();
 }
 
 
 
 /**
-  * @brief CoEvolution::calcFitness Compute the fitness of a couple of two individuals, which form a fuzzy system. The fuzzy
-  * system is evaluated against the dataset.
+  * @brief CoEvolution::EvaluationJob::execute Evaluate a chunk on a worker of the pool, or in
+  * the evolver thread while it waits for the pool.
+  */
+void CoEvolution::EvaluationJob::execute(int worker, quint32 chunk, quint32 begin, quint32 end)
+{
+    CoevEvaluator *threadEvaluator = worker < 0 ? owner->evaluator : owner->context->getEvaluator(worker);
+    owner->evaluateRange(threadEvaluator, chunk, begin, end);
+}
+
+/**
+  * @brief CoEvolution::evaluateRange Evaluate the individuals [begin, end) of the current
+  * generation against all the cooperators. The fitness of an individual is the best one
+  * of its pairs. The best pair of the range is kept as the candidate of the chunk for the
+  * best system.
   *
-  * @param inX Individual of population 1 (membership functions)
-  * @param inY Individual of population 2 (rules)
+  * @param threadEvaluator Evaluator of the calling thread
+  * @param chunk Index of the chunk in chunkCandidates
+  * @param begin First individual
+  * @param end Past the last individual
   */
-void CoEvolution::calcFitness(PopEntity *inX, PopEntity *inY)
+void CoEvolution::evaluateRange(CoevEvaluator *threadEvaluator, quint32 chunk, quint32 begin, quint32 end)
 {
-    Q_ASSERT( inX != NULL && inY != NULL );
-    Genotype* genX = inX->getGenotype();
-    Genotype* genY = inY->getGenotype();
-    if( genX == NULL || genY == NULL )
-        return;
-    QBitArray *genotypeDataX = genX->getData();
-    QBitArray *genotypeDataY = genY->getData();
-    QVector<quint16> ruleBitString(ComputeThread::ruleGenSize);
-
-    FuzzyMembershipsGenome* membGen = new FuzzyMembershipsGenome(fSystem->getNbInVars(),fSystem->getNbOutVars(),
-                                                fSystem->getNbInSets(),fSystem->getNbOutSets(),
-                                                fSystem->getInSetsPosCodeSize(), fSystem->getOutSetsPosCodeSize());
-    QVector<FuzzyRuleGenome*> ruleGenTab(ComputeThread::nbRules);
-
-    for (int i = 0; i < ComputeThread::nbRules; i++) {
-        ruleGenTab[i] = new FuzzyRuleGenome(fSystem->getNbVarPerRule(), fSystem->getNbInVars(),fSystem->getNbOutVars(),
-                                            fSystem->getInVarsCodeSize(),fSystem->getOutVarsCodeSize(),
-                                            fSystem->getInSetsCodeSize(), fSystem->getOutSetsCodeSize());
-    }
+    FitnessCache &cache = context->getFitnessCache();
+    const bool useCache = cache.isEnabled();
+    FitnessCache::Key entityKey;
+    FitnessCache::Key pairKey;
+
+    PairCandidate candidate;
+    candidate.fitness = -1.0;
+    candidate.entity = 0;
+    candidate.cooperator = 0;
+    for (quint32 i = begin; i < end && !context->isStopRequested(); i++)
+    {
+        PopEntity *entity = (*evaluatedEntities)[i];
+        Genotype *gen = entity->getGenotype();
+        if (gen == NULL)
+            continue;
+        const QBitArray *entityData = gen->getData();
+        if (evaluatingMemberships)
+            threadEvaluator->decodeMemberships(entityData, threadEvaluator->getMembershipsPositions());
+        else
+            threadEvaluator->decodeRules(entityData, threadEvaluator->getRuleGenomes(), threadEvaluator->getDefaultRules());
+        if (useCache)
+            entityKey = FitnessCache::hashGenotype(entityData);
 
-    // Read the memberships genome
-    membGen->readGenomeBitString(genotypeDataX, ComputeThread::membersGenSize);
-
-    // Rules genome transcription with FIXED VARS
-
-    // FIXME: Fixed vars were never used on any test case provided, is it still necessary ? From : Yvan Da Silva.
-    if (ComputeThread::sysParams->getFixedVars()) {
-        qDebug() << "FIXED";
-        // Transcript each rule one by one
-        for (int k = 0; k < ComputeThread::nbRules; k++) {
-            // Variables d'entrée : le code des variables d'entrée est toujours 0
-            for (int l = 0; l < ComputeThread::nbVarPerRule; l++) {
-                ruleBitString[l*(ComputeThread::inSetsCodeSize+1)] = 0;
-                for (int m = 1; m < ComputeThread::inSetsCodeSize+1; m++) {
-                    ruleBitString[l*(ComputeThread::inSetsCodeSize+1) + m] = genotypeDataY->at(k*fSystem->getRuleBitStringSize() + (l*ComputeThread::inSetsCodeSize) + m-1);
-                }
+        // Loop through all cooperators
+        qreal currentIndBestFit = 0.0;
+        for (int j = 0; j < cooperatorsInUse && !context->isStopRequested(); j++)
+        {
+            CoevCooperator *coop = cooperators[j];
+            qreal pairFitness = 0.0;
+            // Elites and unchanged offspring meet the same cooperators again, their
+            // fitness is taken from the cache. A cached pair was already offered as
+            // best system when it was evaluated.
+            if (useCache) {
+                if (evaluatingMemberships)
+                    pairKey = FitnessCache::combine(entityKey, coop->getCacheKey());
+                else
+                    pairKey = FitnessCache::combine(coop->getCacheKey(), entityKey);
             }
-            // Variables de sortie
-            int outBase = ComputeThread::nbVarPerRule * (ComputeThread::inSetsCodeSize+1);
-            for (int l = 0; l < ComputeThread::nbOutVars; l++) {
-                // Le code des variables de sortie est toujours 0
-                ruleBitString[outBase + l*(ComputeThread::outSetsCodeSize+1)] = 0;
-                for (int m = 1; m < ComputeThread::outSetsCodeSize+1; m++) {
-                    ruleBitString[outBase + l*(ComputeThread::outSetsCodeSize+1) + m] = genotypeDataY->at(k*fSystem->getRuleBitStringSize()
-                                                                                                          + ComputeThread::nbVarPerRule*ComputeThread::inSetsCodeSize + l*ComputeThread::outSetsCodeSize + m-1);
+            if (!useCache || !cache.lookup(pairKey, &pairFitness)) {
+                if (evaluatingMemberships)
+                    pairFitness = threadEvaluator->evaluate(*threadEvaluator->getMembershipsPositions(), coop->getRuleGenomes(), coop->getDefaultRules());
+                else
+                    pairFitness = threadEvaluator->evaluate(*coop->getMembershipsPositions(), threadEvaluator->getRuleGenomes(), threadEvaluator->getDefaultRules());
+                if (useCache)
+                    cache.insert(pairKey, pairFitness);
+
+                // Of the pairs of the same fitness, the last one evaluated is kept
+                if (pairFitness >= candidate.fitness) {
+                    candidate.fitness = pairFitness;
+                    candidate.entity = i;
+                    candidate.cooperator = j;
                 }
             }
-            // Read the rule
-            ruleGenTab[k]->readGenomeBitString(ruleBitString.data(), ComputeThread::ruleGenSize);
+            if (pairFitness > currentIndBestFit) {
+                currentIndBestFit = pairFitness;
+                entity->setFitness(pairFitness); // choose the best fit, between ind & all coops
+            }
         }
+        entityBestFitness[i] = currentIndBestFit;
     }
-    // Genome transcription with EVOLVING VARS
-    else {
-        // FIXME: ReadGenomeBitString should be able to decode QbitArray directly avoid this N2 operation. From : Yvan Da Silva.
-        for (int k = 0; k < ComputeThread::nbRules; k++) {
-            for (int l = 0; l < ComputeThread::ruleGenSize; l++) {
-                ruleBitString[l] = genotypeDataY->at(l + k*ComputeThread::ruleGenSize);
+    chunkCandidates[chunk] = candidate;
+}
+
+/**
+  * @brief CoEvolution::evaluateOnFarm Evaluate the individuals of the current generation
+  * against all the cooperators on the worker processes, in a single batch per worker. Only
+  * the best pair is evaluated again locally, to snapshot it as a candidate best system.
+  *
+  * @param size Number of individuals
+  * @return false if no worker is available, nothing is evaluated then
+  */
+bool CoEvolution::evaluateOnFarm(quint32 size)
+{
+    FitnessCache &cache = context->getFitnessCache();
+    const bool useCache = cache.isEnabled();
+    FitnessCache::Key entityKey;
+    FitnessCache::Key pairKey;
+
+    chunkCandidates.clear();
+    farmEntities.clear();
+    farmMemberships.clear();
+    farmRules.clear();
+    farmKeys.clear();
+
+    // Pairs already in the cache are not sent
+    for (quint32 i = 0; i < size; i++) {
+        Genotype *gen = (*evaluatedEntities)[i]->getGenotype();
+        if (gen == NULL)
+            continue;
+        const QBitArray *entityData = gen->getData();
+        if (useCache)
+            entityKey = FitnessCache::hashGenotype(entityData);
+        for (int j = 0; j < cooperatorsInUse; j++) {
+            CoevCooperator *coop = cooperators[j];
+            const QBitArray *coopData = coop->getCoop()->getGenotype()->getData();
+            qreal pairFitness;
+            if (useCache) {
+                if (evaluatingMemberships)
+                    pairKey = FitnessCache::combine(entityKey, coop->getCacheKey());
+                else
+                    pairKey = FitnessCache::combine(coop->getCacheKey(), entityKey);
+                if (cache.lookup(pairKey, &pairFitness)) {
+                    if (pairFitness > entityBestFitness[i]) {
+                        entityBestFitness[i] = pairFitness;
+                        (*evaluatedEntities)[i]->setFitness(pairFitness);
+                    }
+                    continue;
+                }
             }
-            ruleGenTab[k]->readGenomeBitString(ruleBitString.data(), ComputeThread::ruleGenSize);
+            farmEntities.append(i);
+            farmMemberships.append(evaluatingMemberships ? entityData : coopData);
+            farmRules.append(evaluatingMemberships ? coopData : entityData);
+            if (useCache)
+                farmKeys.append(pairKey);
         }
     }
-    // Default rules transcription
-    int defRulesSize = fSystem->getDefaultRulesBitStringSize();
-    int defRulesPos = fSystem->getRuleBitStringSize()*ComputeThread::nbRules;
-    QVector<int> defRules(defRulesSize);
-    for (int i = 0; i < defRulesSize; i++) {
-        defRules[i] = genotypeDataY->at(defRulesPos+i);
-    }
 
-    // Reset the previous fuzzy system
-    fSystem->reset();
+    if (!farmEntities.isEmpty() && !farmClient->evaluate(farmMemberships, farmRules, &farmFitness)) {
+        if (!farmDown)
+            qCritical() << "No evaluation worker available, evaluating" << left->getName() << "locally";
+        farmDown = true;
+        entityBestFitness.fill(0.0, size);
+        return false;
+    }
+    farmDown = false;
+
+    int best = -1;
+    for (int k = 0; k < farmEntities.size(); k++) {
+        const qreal pairFitness = farmFitness[k];
+        if (useCache)
+            cache.insert(farmKeys[k], pairFitness);
+        if (pairFitness > entityBestFitness[farmEntities[k]]) {
+            entityBestFitness[farmEntities[k]] = pairFitness;
+            (*evaluatedEntities)[farmEntities[k]]->setFitness(pairFitness);
+        }
+        // Of the pairs of the same fitness, the last one evaluated is kept, as in evaluateRange()
+        if (best < 0 || pairFitness >= farmFitness[best])
+            best = k;
+    }
 
-    // Load the genomes
-    fSystem->loadMembershipsGenome(membGen);
-    fSystem->loadRulesGenome(ruleGenTab.data(), defRules.data());
-    // Get the textual systemDescription
-    fitness = fSystem->evaluateFitness();
+    if (best >= 0 && context->isBetterSystem(farmFitness[best], farmMemberships[best], farmRules[best]))
+        offerPair(farmMemberships[best], farmRules[best]);
+    return true;
+}
 
-    ComputeThread::saveFuzzyAndFitness(fSystem,fitness);
+/**
+  * @brief CoEvolution::offerPair Offer a pair of the current generation as best system. The
+  * snapshot needs the metrics of the system, the pair is evaluated again in fSystem.
+  *
+  * @param memberships Genotype of the membership functions individual
+  * @param rules Genotype of the rules individual
+  */
+void CoEvolution::offerPair(const QBitArray *memberships, const QBitArray *rules)
+{
+    evaluator->decodeMemberships(memberships, evaluator->getMembershipsPositions());
+    evaluator->decodeRules(rules, evaluator->getRuleGenomes(), evaluator->getDefaultRules());
+    const float fitness = evaluator->evaluate(*evaluator->getMembershipsPositions(), evaluator->getRuleGenomes(), evaluator->getDefaultRules());
+    context->offerBestSystem(new BestSystemSnapshot(fSystem, fitness, *memberships, *rules));
+}
 
-    // Delete everything we don't need anymore ( Created in this functio ).
-    delete membGen;
-    for (int i = 0; i < ComputeThread::nbRules; i++) {
-        delete ruleGenTab[i];
+/**
+  * @brief CoEvolution::decodeCooperators Decode the representatives of the other population
+  * for the current generation. The cooperators storage is reused from one generation to the next.
+  *
+  * @param representatives Representatives of the other population
+  */
+void CoEvolution::decodeCooperators(const vector<PopEntity *> &representatives)
+{
+    bool isMemberships = (left->getName() == "MEMBERSHIPS");
+
+    while (cooperators.size() < (int) representatives.size())
+        cooperators.append(new CoevCooperator(fSystem));
+
+    cooperatorsInUse = 0;
+    for (unsigned int i = 0; i < representatives.size(); i++) {
+        CoevCooperator *coop = cooperators[cooperatorsInUse];
+        bool decoded;
+        // Our representatives come from the other population
+        if (isMemberships)
+            decoded = decodeRules(representatives[i], coop->getRuleGenomes(), coop->getDefaultRules());
+        else
+            decoded = decodeMemberships(representatives[i], coop->getMembershipsPositions());
+        if (!decoded)
+            continue;
+        if (context->getFitnessCache().isEnabled())
+            coop->setCacheKey(FitnessCache::hashGenotype(representatives[i]->getGenotype()->getData()));
+        coop->setCoop(representatives[i]);
+        coop->setId(i);
+        cooperatorsInUse++;
     }
+}
+
+/**
+  * @brief CoEvolution::decodeMemberships Decode a membership functions individual into the
+  * absolute positions of its sets.
+  *
+  * @param entity Individual of population 1 (membership functions)
+  * @param positions Vector receiving the positions
+  * @return false if the individual has no genotype
+  */
+bool CoEvolution::decodeMemberships(PopEntity *entity, QVector<float> *positions)
+{
+    Q_ASSERT( entity != NULL );
+    Genotype* gen = entity->getGenotype();
+    if( gen == NULL )
+        return false;
+
+    evaluator->decodeMemberships(gen->getData(), positions);
+    return true;
+}
+
+/**
+  * @brief CoEvolution::decodeRules Decode a rules individual into rule genomes and default rules bits.
+  *
+  * @param entity Individual of population 2 (rules)
+  * @param ruleGens Array of nbRules rule genomes to be filled
+  * @param defRulesBits Array receiving the default rules bits
+  * @return false if the individual has no genotype
+  */
+bool CoEvolution::decodeRules(PopEntity *entity, FuzzyRuleGenome **ruleGens, int *defRulesBits)
+{
+    Q_ASSERT( entity != NULL );
+    Genotype* gen = entity->getGenotype();
+    if( gen == NULL )
+        return false;
 
+    evaluator->decodeRules(gen->getData(), ruleGens, defRulesBits);
+    return true;
+}
 
+/**
+  * @brief CoEvolution::calcFitness Compute the fitness of a couple of two individuals, which form a fuzzy
+  * system. The fuzzy system is evaluated against the dataset.
+  *
+  * @param inX Individual of population 1 (membership functions)
+  * @param inY Individual of population 2 (rules)
+  */
+void CoEvolution::calcFitness(PopEntity *inX, PopEntity *inY)
+{
+    Q_ASSERT( inX != NULL && inY != NULL );
+    if (!decodeMemberships(inX, evaluator->getMembershipsPositions()) ||
+        !decodeRules(inY, evaluator->getRuleGenomes(), evaluator->getDefaultRules()))
+        return;
 
+    fitness = evaluator->evaluate(*evaluator->getMembershipsPositions(), evaluator->getRuleGenomes(), evaluator->getDefaultRules());
+    context->saveFuzzyAndFitness(fSystem, fitness, inX->getGenotype()->getData(), inY->getGenotype()->getData());
+}
+
+/**
+  * @brief CoEvolution::loadBestSystem Rebuild the fuzzy system of this evolver from a best
+  * system snapshot and evaluate it, so that its metrics and description are available.
+  * Must be called from the thread running this evolver, or once it is finished.
+  *
+  * @param snapshot Best system snapshot
+  * @return false if there is no snapshot
+  */
+bool CoEvolution::loadBestSystem(const BestSystemSnapshot *snapshot)
+{
+    if (snapshot == NULL)
+        return false;
+
+    evaluator->decodeMemberships(&snapshot->getMembershipsGenotype(), evaluator->getMembershipsPositions());
+    evaluator->decodeRules(&snapshot->getRulesGenotype(), evaluator->getRuleGenomes(), evaluator->getDefaultRules());
+    evaluator->evaluate(*evaluator->getMembershipsPositions(), evaluator->getRuleGenomes(), evaluator->getDefaultRules());
+    return true;
+}
+
+/**
+  * @brief CoEvolution::onSaveSystem Save the best system found so far. The fuzzy system of
+  * this evolver is rebuilt from the best snapshot, it is rebuilt again by the next evaluation.
+  *
+  * @param fileName Name of the .ffs file
+  */
+void CoEvolution::onSaveSystem(QString fileName)
+{
+    const BestSystemSnapshot *snapshot = context->getBestSnapshot();
+    if (loadBestSystem(snapshot))
+        fSystem->saveToFile(fileName, snapshot->getFitness());
 }
@@ -44,12 +44,16 @@
 #include "../fuzzy/fuzzymembershipsgenome.h"
 #include "../fuzzy/fuzzyrulegenome.h"
 #include "../systemparameters.h"
-#include "../fugemain.h"
 #include "../computethread.h"
 
+#include "bestsystemsnapshot.h"
 #include "coevcooperator.h"
+#include "coevevaluator.h"
 #include "coevstats.h"
+#include "evaluationfarm.h"
 #include "qbitarrayutility.h"
+#include "runcontext.h"
+#include "workstealingpool.h"
 
 // Number of cooperators to be used
 #define COOP_SIZE 2
@@ -58,12 +62,13 @@ class CoEvolution : public QThread, public EvolutionEngine {
 
     Q_OBJECT
 public:
-    CoEvolution(FuzzySystem *fSystem, QMutex *leftLock, QMutex *rightLock, Population* left, Population* right, quint32 generationCount, qreal crossoverProbability, qreal mutationProbability, qreal mutationPerBitProbability, quint32 eliteSize, quint32 cooperatorsCount, QObject *parent = 0);
+    CoEvolution(RunContext *context, FuzzySystem *fSystem, SpeciesScheduler *scheduler, int species, Population* left, Population* right, quint32 generationCount, qreal crossoverProbability, qreal mutationProbability, qreal mutationPerBitProbability, quint32 eliteSize, quint32 cooperatorsCount, QObject *parent = 0);
 
     ~CoEvolution();
 
     void run();
     bool evaluatePopulation(Population* population, quint32 generation);
+    bool loadBestSystem(const BestSystemSnapshot *snapshot);
     void onSaveSystem(QString fileName);
 
 signals :
@@ -71,14 +76,20 @@ signals :
     void sendData();
 
 protected:
-    static SystemParameters *sysParams;
     void calcFitness(PopEntity *inInd1, PopEntity *inInd2);
+    bool decodeMemberships(PopEntity *entity, QVector<float> *positions);
+    bool decodeRules(PopEntity *entity, FuzzyRuleGenome **ruleGens, int *defRulesBits);
+    void decodeCooperators(const vector<PopEntity *> &representatives);
+    void evaluateRange(CoevEvaluator *threadEvaluator, quint32 chunk, quint32 begin, quint32 end);
+    bool evaluateOnFarm(quint32 size);
+    void offerPair(const QBitArray *memberships, const QBitArray *rules);
     float fixedToFloat(quint32 fixedInt, int pointPos) const;
 
 private:
+    RunContext *context;
     FuzzySystem *fSystem;
-    QMutex *leftLock;
-    QMutex *rightLock;
+    SpeciesScheduler *scheduler;
+    int species;
     Population *left;
     Population *right;
     quint32 generationCount;
@@ -87,6 +98,49 @@ private:
     quint32 cooperatorsCount;
     qreal fitness;
 
+    // Evaluator on fSystem, used for the cooperators and when no pool is available
+    CoevEvaluator *evaluator;
+    // Representatives of the other population, decoded once per generation
+    QVector<CoevCooperator*> cooperators;
+    int cooperatorsInUse;
+
+    // Runs evaluateRange() on the workers of the evaluation pool and in this thread
+    class EvaluationJob : public WorkStealingPool::Job
+    {
+    public:
+        EvaluationJob(CoEvolution *owner) : owner(owner) {}
+        void execute(int worker, quint32 chunk, quint32 begin, quint32 end);
+    private:
+        CoEvolution *owner;
+    };
+    EvaluationJob evaluationJob;
+    // State of the generation being evaluated, shared with the workers
+    const vector<PopEntity *> *evaluatedEntities;
+    bool evaluatingMemberships;
+    QVector<qreal> entityBestFitness;
+    // Best evaluated pair of a chunk, its fitness is negative if the chunk evaluated none
+    struct PairCandidate
+    {
+        qreal fitness;
+        quint32 entity;
+        int cooperator;
+    };
+    // Best pair of each chunk, reduced in chunk order once all are done
+    QVector<PairCandidate> chunkCandidates;
+
+    // Index of this evolver among the readers of the best snapshot while it runs
+    int snapshotReader;
+
+    // Connections of this evolver to the evaluation workers, NULL without workers
+    EvaluationFarm::Client *farmClient;
+    bool farmDown;
+    // Pairs of the generation sent to the workers
+    QVector<quint32> farmEntities;
+    QVector<const QBitArray *> farmMemberships;
+    QVector<const QBitArray *> farmRules;
+    QVector<FitnessCache::Key> farmKeys;
+    QVector<float> farmFitness;
+
     QString fileName;
     qreal finalFit;
     bool isFirst;
@@ -25,7 +25,10 @@
   */
 #include "coevstats.h"
 
-CoevStats::CoevStats() : QObject()
+// Samples kept for the plot, many seconds of generations of a small run
+static const int SAMPLE_CAPACITY = 1024;
+
+CoevStats::CoevStats() : QObject(), samples(SAMPLE_CAPACITY)
 {
     fitMaxPop1 = -1.0;
     fitMinPop1 = -1.0;
@@ -48,6 +51,7 @@ CoevStats::CoevStats() : QObject()
     distanceMinThreshold = 0.0;
     dontCare = 0.0;
     overLearn = 0.0;
+    validationFitness = -1.0;
     sizePop1 = 0;
     sizePop2 = 0;
     genNumber = 0;
@@ -58,9 +62,22 @@ CoevStats::~CoevStats()
 }
 
 /**
-  * Send a signal to the statistics plots when new data is available
+  * Queue the statistics of a generation for the plot. Never waits, the publishers must
+  * be serialized by the caller.
+  *
+  * @return false if the ring is full, the sample is then dropped
+  */
+bool CoevStats::publishSample(const Sample &sample)
+{
+    return samples.push(sample);
+}
+
+/**
+  * Remove up to count samples, oldest first. Called by the plot only.
+  *
+  * @return The number of samples copied to taken
   */
-void CoevStats::transmitData(QString name)
+int CoevStats::takeSamples(Sample *taken, int count)
 {
-    emit this->transmit(name);
+    return samples.pop(taken, count);
 }
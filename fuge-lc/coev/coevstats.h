@@ -22,6 +22,10 @@
   *
   * @class CoevStats
   * @brief Singleton class which holds the coevolution statistics
+  *
+  * The statistics of each generation are also queued as samples in a ring, from which
+  * the statistics plot takes them at its own pace. The evolvers never wait for the GUI,
+  * the samples published while the ring is full are dropped.
   */
 
 #ifndef COEVSTATS_H
@@ -29,10 +33,26 @@
 
 #include <QObject>
 
+#include "spscring.h"
+
 class CoevStats : public QObject
 {
     Q_OBJECT
 
+public:
+    // Statistics of a generation of a species, species 1 for the rules
+    struct Sample
+    {
+        int species;
+        unsigned int generation;
+        unsigned int populationSize;
+        double fitMax;
+        double fitMin;
+        double fitAvg;
+        double fitStd;
+        float validationFitness;
+    };
+
 private:
     CoevStats();
     ~CoevStats();
@@ -63,12 +83,17 @@ private:
     float dontCare;
     float overLearn;
     // FIN - MODIF - Bujard - 18.03.2010
+    // Fitness of the best system on the validation dataset, negative without one
+    float validationFitness;
 
     unsigned int sizePop1;
     unsigned int sizePop2;
     unsigned int genNumber;
     QString bestSystemDescription;
 
+    // Ring of the samples not taken yet, written by one publisher at a time
+    SpscRing<Sample> samples;
+
 public:
     static CoevStats& getInstance()
     {
@@ -98,6 +123,7 @@ public:
     inline void setDontCare (float value ){dontCare = value;}
     inline void setOverLearn (float value){overLearn = value;}
     // FIN - MODIF - Bujard - 18.03.2010
+    inline void setValidationFitness(float value) {validationFitness = value;}
     inline void setSizePop1(unsigned int value) {sizePop1 = value;}
     inline void setSizePop2(unsigned int value) {sizePop2 = value;}
     inline void setBestSysDesc(QString desc) {bestSystemDescription = desc;}
@@ -126,15 +152,15 @@ public:
     float getDontCare () {return dontCare;}
     float getOverLearn () {return overLearn;}
     // FIN - MODIF - Bujard - 18.03.2010
+    inline float getValidationFitness() {return validationFitness;}
     inline double getSizePop1() {return sizePop1;}
     inline double getSizePop2() {return sizePop2;}
     inline QString* getBestSysDesc(void) {return &bestSystemDescription;}
     inline unsigned int getGenNumber() {return genNumber;}
 
-    void transmitData(QString name);
-
-signals:
-    void transmit(QString name);
+    bool publishSample(const Sample &sample);
+    int takeSamples(Sample *taken, int count);
+    inline int getDroppedSamples() const {return samples.getDropped();}
 };
 
 #endif // COEVSTATS_H
@@ -0,0 +1,404 @@
+/**
+  * @file   evaluationfarm.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class EvaluationFarm
+  * @brief Evaluates the pairs of a generation on worker processes, see EvaluationWorker.
+  */
+
+#include <cstring>
+#include <QLocalSocket>
+#include <QTcpSocket>
+#include <QtEndian>
+#include <QDebug>
+
+#include "evaluationfarm.h"
+
+// Larger messages are considered corrupted
+static const quint32 MAX_PAYLOAD_SIZE = 0x10000000;
+
+/**
+  * Constructor
+  *
+  * @param addresses Addresses of the workers
+  * @param fSystem Fuzzy system of the run, its layout, dataset and evaluation parameters
+  * are sent to the workers
+  */
+EvaluationFarm::EvaluationFarm(const QStringList &addresses, FuzzySystem *fSystem) : addresses(addresses)
+{
+    const EvaluationParameters *params = fSystem->getEvaluationParameters();
+    QList<QStringList> *dataset = fSystem->getSystemData();
+
+    // The workers check that they loaded the same dataset
+    appendUInt(&setup, dataset->size());
+    appendUInt(&setup, dataset->isEmpty() ? 0 : dataset->at(0).size());
+
+    appendUInt(&setup, fSystem->getNbRules());
+    appendUInt(&setup, fSystem->getNbVarPerRule());
+    appendUInt(&setup, fSystem->getNbOutVars());
+    appendUInt(&setup, fSystem->getNbInSets());
+    appendUInt(&setup, fSystem->getNbOutSets());
+    appendUInt(&setup, fSystem->getInVarsCodeSize());
+    appendUInt(&setup, fSystem->getOutVarsCodeSize());
+    appendUInt(&setup, fSystem->getInSetsCodeSize());
+    appendUInt(&setup, fSystem->getOutSetsCodeSize());
+    appendUInt(&setup, fSystem->getInSetsPosCodeSize());
+    appendUInt(&setup, fSystem->getOutSetsPosCodeSize());
+    appendUInt(&setup, params->fixedVars);
+
+    appendUInt(&setup, params->threshActivated);
+    appendFloat(&setup, params->sensiW);
+    appendFloat(&setup, params->speciW);
+    appendFloat(&setup, params->accuracyW);
+    appendFloat(&setup, params->ppvW);
+    appendFloat(&setup, params->rmseW);
+    appendFloat(&setup, params->rrseW);
+    appendFloat(&setup, params->raeW);
+    appendFloat(&setup, params->mseW);
+    appendFloat(&setup, params->dontCareW);
+    for (int i = 0; i < fSystem->getNbOutVars(); i++)
+        appendFloat(&setup, params->getThresholdVal(i));
+
+    // A pair costs about one rule per sample, a millisecond per 10000 of them is a few
+    // times the time a loaded worker takes
+    pairTimeout = 1 + (qint64) dataset->size() * fSystem->getNbRules() / 10000;
+}
+
+/**
+  * Return the time allowed to a worker to answer a batch of the given number of pairs,
+  * in milliseconds.
+  */
+int EvaluationFarm::getReplyTimeout(int pairs) const
+{
+    return (int) qMin((qint64) ReplyTimeout + (qint64) pairs * pairTimeout, (qint64) 0x7fffffff);
+}
+
+/**
+  * Tell whether address designates a TCP endpoint, "port" or "host:port", rather than
+  * a local socket.
+  *
+  * @param address Address of a worker
+  * @param host Receives the host, empty if only a port is given
+  * @param port Receives the port
+  */
+bool EvaluationFarm::isTcpAddress(const QString &address, QString *host, quint16 *port)
+{
+    const int colon = address.lastIndexOf(':');
+    bool ok;
+    const uint value = address.mid(colon + 1).toUInt(&ok);
+    if (!ok || value == 0 || value > 65535)
+        return false;
+    *host = (colon < 0) ? QString() : address.left(colon);
+    *port = value;
+    return true;
+}
+
+/**
+  * Connect to a worker.
+  *
+  * @return The connected socket, or NULL
+  */
+QIODevice *EvaluationFarm::connectTo(const QString &address, int timeout)
+{
+    QString host;
+    quint16 port;
+
+    if (isTcpAddress(address, &host, &port)) {
+        QTcpSocket *socket = new QTcpSocket();
+        socket->connectToHost(host.isEmpty() ? QString("localhost") : host, port);
+        if (socket->waitForConnected(timeout)) {
+            // Batches are request and answer, do not delay them
+            socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+            return socket;
+        }
+        delete socket;
+    }
+    else {
+        QLocalSocket *socket = new QLocalSocket();
+        socket->connectToServer(address);
+        if (socket->waitForConnected(timeout))
+            return socket;
+        delete socket;
+    }
+    return NULL;
+}
+
+/**
+  * Send a message and wait until it is written.
+  *
+  * @return false if the connection failed
+  */
+bool EvaluationFarm::writeMessage(QIODevice *socket, quint32 type, const QByteArray &payload, int timeout)
+{
+    QByteArray header;
+    appendUInt(&header, type);
+    appendUInt(&header, payload.size());
+    if (socket->write(header) != header.size() || socket->write(payload) != payload.size())
+        return false;
+    while (socket->bytesToWrite() > 0) {
+        if (!socket->waitForBytesWritten(timeout))
+            return false;
+    }
+    return true;
+}
+
+static bool readExactly(QIODevice *socket, char *data, qint64 size, int timeout)
+{
+    qint64 done = 0;
+    while (done < size) {
+        if (socket->bytesAvailable() == 0 && !socket->waitForReadyRead(timeout))
+            return false;
+        const qint64 count = socket->read(data + done, size - done);
+        if (count < 0)
+            return false;
+        done += count;
+    }
+    return true;
+}
+
+/**
+  * Wait for a complete message.
+  *
+  * @param timeout Time allowed for each part of the message, -1 to wait forever
+  * @return false if the connection failed, timed out or the message is corrupted
+  */
+bool EvaluationFarm::readMessage(QIODevice *socket, quint32 *type, QByteArray *payload, int timeout)
+{
+    QByteArray header(8, 0);
+    if (!readExactly(socket, header.data(), header.size(), timeout))
+        return false;
+
+    int pos = 0;
+    quint32 size;
+    readUInt(header, &pos, type);
+    readUInt(header, &pos, &size);
+    if (size > MAX_PAYLOAD_SIZE)
+        return false;
+    payload->resize(size);
+    return readExactly(socket, payload->data(), size, timeout);
+}
+
+void EvaluationFarm::appendUInt(QByteArray *data, quint32 value)
+{
+    uchar word[4];
+    qToLittleEndian(value, word);
+    data->append((const char *) word, 4);
+}
+
+void EvaluationFarm::appendFloat(QByteArray *data, float value)
+{
+    quint32 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    appendUInt(data, bits);
+}
+
+/**
+  * Append the bits packed 8 per byte, the size is not written.
+  */
+void EvaluationFarm::appendBits(QByteArray *data, const QBitArray &bits)
+{
+    const int size = bits.size();
+    for (int i = 0; i < size; i += 8) {
+        uchar byte = 0;
+        for (int j = 0; j < 8 && i + j < size; j++) {
+            if (bits.testBit(i + j))
+                byte |= 1 << j;
+        }
+        data->append((const char *) &byte, 1);
+    }
+}
+
+bool EvaluationFarm::readUInt(const QByteArray &data, int *pos, quint32 *value)
+{
+    if (*pos + 4 > data.size())
+        return false;
+    *value = qFromLittleEndian<quint32>((const uchar *) data.constData() + *pos);
+    *pos += 4;
+    return true;
+}
+
+bool EvaluationFarm::readFloat(const QByteArray &data, int *pos, float *value)
+{
+    quint32 bits;
+    if (!readUInt(data, pos, &bits))
+        return false;
+    memcpy(value, &bits, sizeof(bits));
+    return true;
+}
+
+/**
+  * Read bits->size() bits packed by appendBits().
+  */
+bool EvaluationFarm::readBits(const QByteArray &data, int *pos, QBitArray *bits)
+{
+    const int size = bits->size();
+    const int bytes = (size + 7) / 8;
+    if (*pos + bytes > data.size())
+        return false;
+    const uchar *packed = (const uchar *) data.constData() + *pos;
+    for (int i = 0; i < size; i++)
+        bits->setBit(i, (packed[i / 8] >> (i % 8)) & 1);
+    *pos += bytes;
+    return true;
+}
+
+/**
+  * Constructor, the workers are connected on the first batch.
+  */
+EvaluationFarm::Client::Client(EvaluationFarm *farm) : farm(farm), nextBatch(0)
+{
+    for (int i = 0; i < farm->getAddresses().size(); i++) {
+        Connection connection;
+        connection.address = farm->getAddresses().at(i);
+        connection.socket = NULL;
+        connection.backoff = 0;
+        connection.skipped = 0;
+        connections.append(connection);
+    }
+}
+
+EvaluationFarm::Client::~Client()
+{
+    for (int i = 0; i < connections.size(); i++)
+        delete connections[i].socket;
+}
+
+/**
+  * Evaluate pairs on the workers. The pairs are split evenly between the live workers,
+  * the pairs of a failing worker are sent again to the remaining ones.
+  *
+  * @param memberships Membership functions genotype of each pair
+  * @param rules Rules genotype of each pair
+  * @param fitness Receives the fitness of each pair
+  * @return false if no worker could evaluate the pairs
+  */
+bool EvaluationFarm::Client::evaluate(const QVector<const QBitArray *> &memberships, const QVector<const QBitArray *> &rules, QVector<float> *fitness)
+{
+    Q_ASSERT(memberships.size() == rules.size());
+    fitness->resize(memberships.size());
+    pending.resize(memberships.size());
+    for (int i = 0; i < pending.size(); i++)
+        pending[i] = i;
+
+    while (!pending.isEmpty()) {
+        QVector<Connection *> live;
+        for (int i = 0; i < connections.size(); i++) {
+            if (open(&connections[i]))
+                live.append(&connections[i]);
+        }
+        if (live.isEmpty())
+            return false;
+
+        // Send a share of the pending pairs to every worker, then collect the answers
+        // so that the workers evaluate in parallel.
+        QVector<int> shares(live.size() + 1);
+        for (int k = 0; k <= live.size(); k++)
+            shares[k] = (qint64) pending.size() * k / live.size();
+        QVector<quint32> batches(live.size());
+        QVector<bool> sent(live.size(), false);
+        for (int k = 0; k < live.size(); k++) {
+            if (shares[k] == shares[k+1])
+                continue;
+            batches[k] = nextBatch++;
+            message.clear();
+            appendUInt(&message, batches[k]);
+            appendUInt(&message, shares[k+1] - shares[k]);
+            appendUInt(&message, memberships[pending[shares[k]]]->size());
+            appendUInt(&message, rules[pending[shares[k]]]->size());
+            for (int p = shares[k]; p < shares[k+1]; p++) {
+                appendBits(&message, *memberships[pending[p]]);
+                appendBits(&message, *rules[pending[p]]);
+            }
+            sent[k] = writeMessage(live[k]->socket, Evaluate, message, farm->getReplyTimeout(shares[k+1] - shares[k]));
+        }
+
+        unresolved.clear();
+        for (int k = 0; k < live.size(); k++) {
+            if (shares[k] == shares[k+1])
+                continue;
+            bool done = false;
+            quint32 type, batch, count;
+            int pos = 0;
+            if (sent[k] && readMessage(live[k]->socket, &type, &message, farm->getReplyTimeout(shares[k+1] - shares[k])) && type == Fitness &&
+                readUInt(message, &pos, &batch) && readUInt(message, &pos, &count) &&
+                batch == batches[k] && count == (quint32) (shares[k+1] - shares[k])) {
+                done = true;
+                for (int p = shares[k]; p < shares[k+1] && done; p++)
+                    done = readFloat(message, &pos, &(*fitness)[pending[p]]);
+            }
+            if (done) {
+                live[k]->backoff = 0;
+            }
+            else {
+                qCritical() << "Evaluation worker" << live[k]->address << "failed, its pairs are sent to the other workers";
+                close(live[k]);
+                for (int p = shares[k]; p < shares[k+1]; p++)
+                    unresolved.append(pending[p]);
+            }
+        }
+        pending.swap(unresolved);
+    }
+    return true;
+}
+
+/**
+  * Make sure the connection is up, reconnecting and sending the setup if needed.
+  *
+  * @return false if the worker is not available
+  */
+bool EvaluationFarm::Client::open(Connection *connection)
+{
+    if (connection->socket != NULL)
+        return true;
+    if (connection->skipped < connection->backoff) {
+        connection->skipped++;
+        return false;
+    }
+
+    connection->socket = connectTo(connection->address, ConnectTimeout);
+    if (connection->socket == NULL) {
+        qDebug() << "Could not connect to evaluation worker" << connection->address;
+        close(connection);
+        return false;
+    }
+
+    quint32 type, status;
+    int pos = 0;
+    if (!writeMessage(connection->socket, Setup, farm->getSetup(), ConnectTimeout) ||
+        !readMessage(connection->socket, &type, &message, ReplyTimeout) || type != Ready ||
+        !readUInt(message, &pos, &status) || status != 0) {
+        qCritical() << "Evaluation worker" << connection->address << "refused the run";
+        close(connection);
+        return false;
+    }
+    return true;
+}
+
+/**
+  * Drop a connection, it is retried after a number of batches doubled on every failure.
+  */
+void EvaluationFarm::Client::close(Connection *connection)
+{
+    delete connection->socket;
+    connection->socket = NULL;
+    connection->backoff = (connection->backoff == 0) ? 1 : qMin(2 * connection->backoff, 64);
+    connection->skipped = 0;
+}
@@ -0,0 +1,121 @@
+/**
+  * @file   evaluationfarm.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class EvaluationFarm
+  * @brief Evaluates the pairs of a generation on worker processes, see EvaluationWorker.
+  *
+  * Workers are addressed by a local socket name or path, or by host:port for TCP. Every
+  * evolver opens its own connections through a Client and sends the pairs it did not find
+  * in the fitness cache as one batch per live worker. A worker which fails or times out is
+  * dropped and its pairs are sent to the others, the time allowed to answer grows with the
+  * size of the batch and of the dataset. The connection is retried at a later batch,
+  * so a restarted worker joins the run again.
+  *
+  * Messages are [type][payload size][payload], every number is a little endian 32 bits word
+  * and a genotype is packed 8 bits per byte :
+  *  - Setup : dataset rows and columns, the fuzzy system layout and the fitness parameters.
+  *  - Ready : 0 if the worker accepted the setup.
+  *  - Evaluate : batch id, pair count, bits of both genotypes, then the genotype pairs.
+  *  - Fitness : batch id, pair count, then the fitness of every pair.
+  */
+
+#ifndef EVALUATIONFARM_H
+#define EVALUATIONFARM_H
+
+#include <QBitArray>
+#include <QByteArray>
+#include <QIODevice>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "../fuzzy/fuzzysystem.h"
+
+class EvaluationFarm
+{
+public:
+    enum MessageType {Setup = 1, Ready = 2, Evaluate = 3, Fitness = 4};
+
+    /**
+      * Connections of one evolver to the workers. Sockets belong to the thread which
+      * created them, a client must be created, used and deleted by the same thread.
+      */
+    class Client
+    {
+    public:
+        Client(EvaluationFarm *farm);
+        ~Client();
+
+        bool evaluate(const QVector<const QBitArray *> &memberships, const QVector<const QBitArray *> &rules, QVector<float> *fitness);
+
+    private:
+        struct Connection
+        {
+            QString address;
+            QIODevice *socket;
+            // Batches to skip before reconnecting, doubled after each failure
+            int backoff;
+            int skipped;
+        };
+
+        bool open(Connection *connection);
+        void close(Connection *connection);
+
+        EvaluationFarm *farm;
+        QVector<Connection> connections;
+        quint32 nextBatch;
+        QByteArray message;
+        QVector<quint32> pending;
+        QVector<quint32> unresolved;
+    };
+
+    EvaluationFarm(const QStringList &addresses, FuzzySystem *fSystem);
+
+    inline const QStringList &getAddresses() const {return addresses;}
+    inline const QByteArray &getSetup() const {return setup;}
+    int getReplyTimeout(int pairs) const;
+
+    static bool isTcpAddress(const QString &address, QString *host, quint16 *port);
+    static QIODevice *connectTo(const QString &address, int timeout);
+    static bool writeMessage(QIODevice *socket, quint32 type, const QByteArray &payload, int timeout);
+    static bool readMessage(QIODevice *socket, quint32 *type, QByteArray *payload, int timeout);
+
+    static void appendUInt(QByteArray *data, quint32 value);
+    static void appendFloat(QByteArray *data, float value);
+    static void appendBits(QByteArray *data, const QBitArray &bits);
+    static bool readUInt(const QByteArray &data, int *pos, quint32 *value);
+    static bool readFloat(const QByteArray &data, int *pos, float *value);
+    static bool readBits(const QByteArray &data, int *pos, QBitArray *bits);
+
+    // Time allowed to connect to a worker, and to a worker to answer the setup. A batch
+    // is allowed this time plus some time per pair, see getReplyTimeout().
+    static const int ConnectTimeout = 3000;
+    static const int ReplyTimeout = 120000;
+
+private:
+    QStringList addresses;
+    QByteArray setup;
+    // Time allowed per pair of a batch, in milliseconds
+    int pairTimeout;
+};
+
+#endif // EVALUATIONFARM_H
@@ -0,0 +1,242 @@
+/**
+  * @file   evaluationworker.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class EvaluationWorker
+  * @brief Serves the evaluation of genotype pairs to the evolutions of other processes.
+  */
+
+#include <iostream>
+#include <QHostAddress>
+#include <QLocalSocket>
+#include <QTcpSocket>
+#include <QDebug>
+
+#include "evaluationworker.h"
+#include "evaluationfarm.h"
+
+/**
+  * Constructor
+  *
+  * @param dataset Dataset the pairs are evaluated on
+  */
+EvaluationWorker::EvaluationWorker(QList<QStringList> *dataset, QObject *parent) :
+    QObject(parent), dataset(dataset), localServer(NULL), tcpServer(NULL)
+{
+}
+
+/**
+  * Start listening for masters.
+  *
+  * @param address Local socket name, or [host:]port to listen on TCP
+  * @return false if the address cannot be listened on
+  */
+bool EvaluationWorker::listen(const QString &address)
+{
+    QString host;
+    quint16 port;
+
+    if (EvaluationFarm::isTcpAddress(address, &host, &port)) {
+        QHostAddress hostAddress(QHostAddress::Any);
+        if (host == "localhost")
+            hostAddress = QHostAddress(QHostAddress::LocalHost);
+        else if (!host.isEmpty())
+            hostAddress.setAddress(host);
+        tcpServer = new TcpServer(this);
+        if (!tcpServer->listen(hostAddress, port)) {
+            qCritical() << "Evaluation worker : cannot listen on" << address << ":" << tcpServer->errorString();
+            return false;
+        }
+    }
+    else {
+        // The socket of a worker which crashed is left behind, a restarted worker replaces it
+        QLocalServer::removeServer(address);
+        localServer = new LocalServer(this);
+        if (!localServer->listen(address)) {
+            qCritical() << "Evaluation worker : cannot listen on" << address << ":" << localServer->errorString();
+            return false;
+        }
+    }
+    std::cout << "Evaluation worker listening on " << address.toStdString() << std::endl;
+    return true;
+}
+
+void EvaluationWorker::startConnection(quintptr socketDescriptor, bool local)
+{
+    Connection *connection = new Connection(this, socketDescriptor, local);
+    connect(connection, SIGNAL(finished()), connection, SLOT(deleteLater()));
+    connection->start();
+}
+
+void EvaluationWorker::LocalServer::incomingConnection(quintptr socketDescriptor)
+{
+    worker->startConnection(socketDescriptor, true);
+}
+
+#if QT_VERSION >= 0x050000
+void EvaluationWorker::TcpServer::incomingConnection(qintptr socketDescriptor)
+#else
+void EvaluationWorker::TcpServer::incomingConnection(int socketDescriptor)
+#endif
+{
+    worker->startConnection(socketDescriptor, false);
+}
+
+EvaluationWorker::Connection::Connection(EvaluationWorker *worker, quintptr socketDescriptor, bool local) :
+    worker(worker), socketDescriptor(socketDescriptor), local(local), context(NULL), evaluator(NULL)
+{
+}
+
+/**
+  * Answer the messages of the master until it disconnects.
+  */
+void EvaluationWorker::Connection::run()
+{
+    QIODevice *socket;
+    if (local) {
+        QLocalSocket *localSocket = new QLocalSocket();
+        localSocket->setSocketDescriptor(socketDescriptor);
+        socket = localSocket;
+    }
+    else {
+        QTcpSocket *tcpSocket = new QTcpSocket();
+        tcpSocket->setSocketDescriptor(socketDescriptor);
+        tcpSocket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        socket = tcpSocket;
+    }
+
+    quint32 type;
+    QByteArray message;
+    QByteArray reply;
+    // The master may stay idle for long between two batches, wait without timeout
+    while (EvaluationFarm::readMessage(socket, &type, &message, -1)) {
+        reply.clear();
+        if (type == EvaluationFarm::Setup) {
+            EvaluationFarm::appendUInt(&reply, applySetup(message) ? 0 : 1);
+            if (!EvaluationFarm::writeMessage(socket, EvaluationFarm::Ready, reply, EvaluationFarm::ReplyTimeout))
+                break;
+        }
+        else if (type == EvaluationFarm::Evaluate && evaluator != NULL && evaluateBatch(message, &reply)) {
+            if (!EvaluationFarm::writeMessage(socket, EvaluationFarm::Fitness, reply, EvaluationFarm::ReplyTimeout))
+                break;
+        }
+        else {
+            qCritical() << "Evaluation worker : invalid message" << type << ", closing the connection";
+            break;
+        }
+    }
+
+    delete evaluator;
+    evaluator = NULL;
+    delete context;
+    context = NULL;
+    delete socket;
+}
+
+/**
+  * Build the fuzzy system of this connection from the setup sent by the master.
+  *
+  * @return false if the setup is invalid or was made for another dataset
+  */
+bool EvaluationWorker::Connection::applySetup(const QByteArray &setup)
+{
+    int pos = 0;
+    quint32 rows, columns;
+    quint32 layout[12];
+    quint32 threshActivated;
+    float weights[9];
+    bool valid = EvaluationFarm::readUInt(setup, &pos, &rows) && EvaluationFarm::readUInt(setup, &pos, &columns);
+    for (int i = 0; i < 12 && valid; i++)
+        valid = EvaluationFarm::readUInt(setup, &pos, &layout[i]);
+    valid = valid && EvaluationFarm::readUInt(setup, &pos, &threshActivated);
+    for (int i = 0; i < 9 && valid; i++)
+        valid = EvaluationFarm::readFloat(setup, &pos, &weights[i]);
+    // layout[2] is the number of output variables, one threshold each
+    QVector<float> thresholds(valid ? layout[2] : 0);
+    for (int i = 0; i < thresholds.size() && valid; i++)
+        valid = EvaluationFarm::readFloat(setup, &pos, &thresholds[i]);
+    if (!valid) {
+        qCritical() << "Evaluation worker : invalid setup";
+        return false;
+    }
+    if (rows != (quint32) worker->dataset->size() || (rows > 0 && columns != (quint32) worker->dataset->at(0).size())) {
+        qCritical() << "Evaluation worker : the master runs on another dataset";
+        return false;
+    }
+
+    EvaluationParameters params;
+    params.fixedVars = layout[11];
+    params.threshActivated = threshActivated;
+    params.sensiW = weights[0];
+    params.speciW = weights[1];
+    params.accuracyW = weights[2];
+    params.ppvW = weights[3];
+    params.rmseW = weights[4];
+    params.rrseW = weights[5];
+    params.raeW = weights[6];
+    params.mseW = weights[7];
+    params.dontCareW = weights[8];
+    params.thresholds = thresholds;
+
+    delete evaluator;
+    delete context;
+    context = new RunContext(params);
+
+    FuzzySystem *fSystem = new FuzzySystem();
+    fSystem->setParameters(layout[0], layout[1], layout[2], layout[3], layout[4], layout[5],
+                           layout[6], layout[7], layout[8], layout[9], layout[10]);
+    fSystem->setEvaluationParameters(context->getEvaluationParameters());
+    fSystem->loadData(worker->dataset);
+    context->setGenomeLayout(fSystem);
+
+    evaluator = new CoevEvaluator(context, fSystem, true);
+    memberships.resize(context->getGenomeLayout().membersGenSize);
+    rules.resize(context->getGenomeLayout().defRulesPos + context->getGenomeLayout().defRulesSize);
+    return true;
+}
+
+/**
+  * Evaluate a batch of pairs.
+  *
+  * @param batch Evaluate message
+  * @param fitness Receives the Fitness message
+  * @return false if the batch is invalid
+  */
+bool EvaluationWorker::Connection::evaluateBatch(const QByteArray &batch, QByteArray *fitness)
+{
+    int pos = 0;
+    quint32 id, count, membershipsSize, rulesSize;
+    if (!EvaluationFarm::readUInt(batch, &pos, &id) || !EvaluationFarm::readUInt(batch, &pos, &count) ||
+        !EvaluationFarm::readUInt(batch, &pos, &membershipsSize) || !EvaluationFarm::readUInt(batch, &pos, &rulesSize) ||
+        membershipsSize != (quint32) memberships.size() || rulesSize != (quint32) rules.size())
+        return false;
+
+    EvaluationFarm::appendUInt(fitness, id);
+    EvaluationFarm::appendUInt(fitness, count);
+    for (quint32 i = 0; i < count; i++) {
+        if (!EvaluationFarm::readBits(batch, &pos, &memberships) || !EvaluationFarm::readBits(batch, &pos, &rules))
+            return false;
+        evaluator->decodeMemberships(&memberships, evaluator->getMembershipsPositions());
+        evaluator->decodeRules(&rules, evaluator->getRuleGenomes(), evaluator->getDefaultRules());
+        EvaluationFarm::appendFloat(fitness, evaluator->evaluate(*evaluator->getMembershipsPositions(), evaluator->getRuleGenomes(), evaluator->getDefaultRules()));
+    }
+    return true;
+}
@@ -0,0 +1,106 @@
+/**
+  * @file   evaluationworker.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class EvaluationWorker
+  * @brief Serves the evaluation of genotype pairs to the evolutions of other processes.
+  *
+  * A worker is started with "--worker address" and loads the dataset once. It listens on
+  * a local socket or a TCP port and serves every master connection in its own thread with
+  * its own fuzzy system, see EvaluationFarm for the protocol. Each connection evaluates
+  * with the parameters of its own setup, a worker can serve several runs at a time.
+  */
+
+#ifndef EVALUATIONWORKER_H
+#define EVALUATIONWORKER_H
+
+#include <QBitArray>
+#include <QByteArray>
+#include <QLocalServer>
+#include <QObject>
+#include <QStringList>
+#include <QTcpServer>
+#include <QThread>
+
+#include "coevevaluator.h"
+
+class EvaluationWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    EvaluationWorker(QList<QStringList> *dataset, QObject *parent = 0);
+
+    bool listen(const QString &address);
+
+private:
+    class LocalServer : public QLocalServer
+    {
+    public:
+        LocalServer(EvaluationWorker *worker) : QLocalServer(worker), worker(worker) {}
+    protected:
+        void incomingConnection(quintptr socketDescriptor);
+    private:
+        EvaluationWorker *worker;
+    };
+
+    class TcpServer : public QTcpServer
+    {
+    public:
+        TcpServer(EvaluationWorker *worker) : QTcpServer(worker), worker(worker) {}
+    protected:
+#if QT_VERSION >= 0x050000
+        void incomingConnection(qintptr socketDescriptor);
+#else
+        void incomingConnection(int socketDescriptor);
+#endif
+    private:
+        EvaluationWorker *worker;
+    };
+
+    // Serves one master connection, deleted once the master disconnects
+    class Connection : public QThread
+    {
+    public:
+        Connection(EvaluationWorker *worker, quintptr socketDescriptor, bool local);
+        void run();
+    private:
+        bool applySetup(const QByteArray &setup);
+        bool evaluateBatch(const QByteArray &batch, QByteArray *fitness);
+
+        EvaluationWorker *worker;
+        quintptr socketDescriptor;
+        bool local;
+        // Context built from the setup of the master, owns the evaluation parameters
+        RunContext *context;
+        CoevEvaluator *evaluator;
+        QBitArray memberships;
+        QBitArray rules;
+    };
+
+    void startConnection(quintptr socketDescriptor, bool local);
+
+    QList<QStringList> *dataset;
+    QLocalServer *localServer;
+    QTcpServer *tcpServer;
+};
+
+#endif // EVALUATIONWORKER_H
@@ -0,0 +1,228 @@
+/**
+  * @file   fitnesscache.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  * @class FitnessCache
+  * @brief Bounded LRU cache of the fitness of already evaluated (memberships, rules) pairs.
+  */
+
+#include "fitnesscache.h"
+
+static inline quint64 mix64(quint64 x)
+{
+    x ^= x >> 30;
+    x *= Q_UINT64_C(0xbf58476d1ce4e5b9);
+    x ^= x >> 27;
+    x *= Q_UINT64_C(0x94d049bb133111eb);
+    x ^= x >> 31;
+    return x;
+}
+
+FitnessCache::FitnessCache() :
+    capacity(0)
+{
+}
+
+/**
+  * Hash a genotype. The bits are packed in 64 bit words which feed two independent
+  * hashes, so that two different genotypes practically never share the same key.
+  *
+  * @param bits Genotype to be hashed
+  */
+FitnessCache::Key FitnessCache::hashGenotype(const QBitArray *bits)
+{
+    Key key;
+    const int size = bits->size();
+    key.h1 = mix64(size);
+    key.h2 = Q_UINT64_C(0x9e3779b97f4a7c15) ^ size;
+    quint64 word = 0;
+    for (int i = 0; i < size; i++) {
+        if (bits->testBit(i))
+            word |= Q_UINT64_C(1) << (i & 63);
+        if ((i & 63) == 63 || i == size - 1) {
+            key.h1 = mix64(key.h1 ^ word);
+            key.h2 = (key.h2 ^ mix64(word + key.h2)) * Q_UINT64_C(0xff51afd7ed558ccd);
+            word = 0;
+        }
+    }
+    return key;
+}
+
+/**
+  * Key of a (memberships, rules) pair from the keys of its two genotypes.
+  */
+FitnessCache::Key FitnessCache::combine(const Key &membershipsKey, const Key &rulesKey)
+{
+    Key key;
+    key.h1 = mix64(membershipsKey.h1 ^ (rulesKey.h1 * Q_UINT64_C(0x9e3779b97f4a7c15)));
+    key.h2 = mix64(membershipsKey.h2 + mix64(rulesKey.h2));
+    return key;
+}
+
+/**
+  * Set the maximum number of entries and clear the cache. A capacity of 0 disables it.
+  * Each shard holds a share of the capacity, rounded up.
+  */
+void FitnessCache::setCapacity(int capacity)
+{
+    capacity = qMax(0, capacity);
+    const int shardCapacity = (capacity + SHARD_COUNT - 1) / SHARD_COUNT;
+    for (int i = 0; i < SHARD_COUNT; i++) {
+        QMutexLocker locker(&shards[i].mutex);
+        shards[i].reset(shardCapacity);
+    }
+    this->capacity.fetchAndStoreOrdered(capacity);
+}
+
+/**
+  * Remove all the entries and reset the statistics, keeping the capacity.
+  */
+void FitnessCache::clear()
+{
+    setCapacity(capacity.fetchAndAddOrdered(0));
+}
+
+void FitnessCache::Shard::reset(int capacity)
+{
+    this->capacity = capacity;
+    nodes.clear();
+    nodes.reserve(capacity);
+    index.clear();
+    index.reserve(capacity);
+    head = -1;
+    tail = -1;
+    hits = 0;
+    misses = 0;
+}
+
+void FitnessCache::Shard::unlink(int node)
+{
+    Node &n = nodes[node];
+    if (n.prev != -1)
+        nodes[n.prev].next = n.next;
+    else
+        head = n.next;
+    if (n.next != -1)
+        nodes[n.next].prev = n.prev;
+    else
+        tail = n.prev;
+}
+
+void FitnessCache::Shard::pushFront(int node)
+{
+    Node &n = nodes[node];
+    n.prev = -1;
+    n.next = head;
+    if (head != -1)
+        nodes[head].prev = node;
+    head = node;
+    if (tail == -1)
+        tail = node;
+}
+
+/**
+  * Look for the fitness of a pair.
+  *
+  * @param key Key of the pair, see combine()
+  * @param fitness Receives the cached fitness on success
+  * @return true if the pair was found
+  */
+bool FitnessCache::lookup(const Key &key, qreal *fitness)
+{
+    Shard &shard = shardOf(key);
+    QMutexLocker locker(&shard.mutex);
+    if (shard.capacity == 0)
+        return false;
+    const int node = shard.index.value(key, -1);
+    if (node == -1) {
+        shard.misses++;
+        return false;
+    }
+    shard.hits++;
+    *fitness = shard.nodes[node].fitness;
+    if (node != shard.head) {
+        shard.unlink(node);
+        shard.pushFront(node);
+    }
+    return true;
+}
+
+/**
+  * Store the fitness of a pair, evicting the least recently used entry of its shard when
+  * the shard is full.
+  */
+void FitnessCache::insert(const Key &key, qreal fitness)
+{
+    Shard &shard = shardOf(key);
+    QMutexLocker locker(&shard.mutex);
+    if (shard.capacity == 0)
+        return;
+    int node = shard.index.value(key, -1);
+    if (node != -1) {
+        shard.nodes[node].fitness = fitness;
+        return;
+    }
+
+    if (shard.nodes.size() < shard.capacity) {
+        node = shard.nodes.size();
+        shard.nodes.append(Node());
+    }
+    else {
+        node = shard.tail;
+        shard.index.remove(shard.nodes[node].key);
+        shard.unlink(node);
+    }
+    shard.nodes[node].key = key;
+    shard.nodes[node].fitness = fitness;
+    shard.pushFront(node);
+    shard.index.insert(key, node);
+}
+
+quint64 FitnessCache::getHits()
+{
+    quint64 hits = 0;
+    for (int i = 0; i < SHARD_COUNT; i++) {
+        QMutexLocker locker(&shards[i].mutex);
+        hits += shards[i].hits;
+    }
+    return hits;
+}
+
+quint64 FitnessCache::getMisses()
+{
+    quint64 misses = 0;
+    for (int i = 0; i < SHARD_COUNT; i++) {
+        QMutexLocker locker(&shards[i].mutex);
+        misses += shards[i].misses;
+    }
+    return misses;
+}
+
+/**
+  * Ratio of the lookups that found their pair since the last clear.
+  */
+qreal FitnessCache::getHitRate()
+{
+    const quint64 hits = getHits();
+    const quint64 misses = getMisses();
+    if (hits + misses == 0)
+        return 0.0;
+    return (qreal) hits / (qreal) (hits + misses);
+}
@@ -0,0 +1,109 @@
+/**
+  * @file   fitnesscache.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  * @class FitnessCache
+  * @brief Bounded LRU cache of the fitness of already evaluated (memberships, rules) pairs.
+  *
+  * Elites and unchanged offspring are paired again with the same cooperators generation
+  * after generation. The cache is keyed by a 128 bit hash of the two genotypes, shared by
+  * the evaluation threads of a run and cleared when a run starts, which is when the
+  * dataset or the fitness weights can change. The entries are spread over SHARD_COUNT
+  * shards by their key, each with its own lock and its own LRU list, so that threads
+  * looking up different pairs rarely wait for each other.
+  */
+
+#ifndef FITNESSCACHE_H
+#define FITNESSCACHE_H
+
+#include <QAtomicInt>
+#include <QBitArray>
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+
+class FitnessCache
+{
+public:
+    // Number of independently locked parts of the cache, a power of two
+    static const int SHARD_COUNT = 16;
+
+    struct Key {
+        quint64 h1;
+        quint64 h2;
+        bool operator==(const Key &other) const {return h1 == other.h1 && h2 == other.h2;}
+    };
+
+    FitnessCache();
+
+    static Key hashGenotype(const QBitArray *bits);
+    static Key combine(const Key &membershipsKey, const Key &rulesKey);
+
+    void setCapacity(int capacity);
+    void clear();
+    inline bool isEnabled() const {return capacity.fetchAndAddOrdered(0) > 0;}
+    bool lookup(const Key &key, qreal *fitness);
+    void insert(const Key &key, qreal fitness);
+
+    quint64 getHits();
+    quint64 getMisses();
+    qreal getHitRate();
+
+private:
+    struct Node {
+        Key key;
+        qreal fitness;
+        int prev;
+        int next;
+    };
+
+    // Entries whose key selects this shard, in a doubly linked list, most recently used first
+    struct Shard {
+        Shard() : head(-1), tail(-1), capacity(0), hits(0), misses(0) {}
+        void reset(int capacity);
+        void unlink(int node);
+        void pushFront(int node);
+
+        QMutex mutex;
+        QVector<Node> nodes;
+        QHash<Key, int> index;
+        int head;
+        int tail;
+        int capacity;
+        quint64 hits;
+        quint64 misses;
+        // Keeps the locks of two shards on different cache lines
+        char padding[64];
+    };
+
+    // The hash of the index uses h1, the shard is chosen with the independent h2
+    inline Shard &shardOf(const Key &key) {return shards[key.h2 & (SHARD_COUNT - 1)];}
+
+    Shard shards[SHARD_COUNT];
+    // Capacity of the whole cache, also read without lock by isEnabled()
+    mutable QAtomicInt capacity;
+};
+
+inline uint qHash(const FitnessCache::Key &key)
+{
+    return (uint) (key.h1 ^ (key.h1 >> 32));
+}
+
+#endif // FITNESSCACHE_H
@@ -0,0 +1,702 @@
+/**
+  * @file   runcontext.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class RunContext
+  * @brief State of one evolution run, shared by its evolvers and evaluators.
+  */
+
+#include <QDebug>
+#include <QDataStream>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+
+#include "runcontext.h"
+#include "bestsystemexporter.h"
+#include "coevevaluator.h"
+#include "coevstats.h"
+#include "evaluationfarm.h"
+#include "fuzzysystem.h"
+#include "systemparameters.h"
+#include "validationtracker.h"
+#include "workstealingpool.h"
+
+const quint32 RunContext::NO_READER;
+
+/**
+  * Constructor. Copy the parameters of the run from the system parameters, later changes
+  * of the system parameters do not affect the run.
+  *
+  * @param sysParams System parameters
+  */
+RunContext::RunContext(SystemParameters &sysParams) :
+    params(sysParams), layout(), stop(0), evaluationPool(NULL), evaluatorSetup(this), evaluatedSystem(NULL), sampleShards(1), samplePool(NULL), evaluationFarm(NULL), validation(NULL), exporter(NULL), checkpointData(this), saveEngine(NULL), stats(NULL), bestSnapshot(0), snapshotEpoch(0)
+{
+    verbose = sysParams.getVerbose();
+    maxFitness[0] = sysParams.getMaxFitPop1();
+    maxFitness[1] = sysParams.getMaxFitPop2();
+    selection[0] = sysParams.getSelectionPop1();
+    selection[1] = sysParams.getSelectionPop2();
+    selectionParam[0] = sysParams.getSelectionParamPop1();
+    selectionParam[1] = sysParams.getSelectionParamPop2();
+    crossover[0] = sysParams.getCrossoverPop1();
+    crossover[1] = sysParams.getCrossoverPop2();
+    randomSeed = sysParams.getRandomSeed();
+    fitnessCache.setCapacity(sysParams.getFitnessCacheSize());
+    sampleShards = qMax(1, sysParams.getSampleShards());
+    if (!NumaTopology::fromSpec(sysParams.getNumaNodes(), &numa))
+        qCritical() << "Invalid NUMA nodes" << sysParams.getNumaNodes() << ", the workers are not bound";
+}
+
+/**
+  * Constructor of a context which only evaluates pairs, such as the one of an evaluation
+  * worker. It has no fitness cache and never stops by itself.
+  *
+  * @param params Evaluation parameters
+  */
+RunContext::RunContext(const EvaluationParameters &params) :
+    params(params), layout(), verbose(false), stop(0), evaluationPool(NULL), evaluatorSetup(this), evaluatedSystem(NULL), sampleShards(1), samplePool(NULL), evaluationFarm(NULL), validation(NULL), exporter(NULL), checkpointData(this), saveEngine(NULL), stats(NULL), bestSnapshot(0), snapshotEpoch(0)
+{
+    randomSeed = -1;
+    for (int i = 0; i < 2; i++) {
+        maxFitness[i] = 1.0;
+        selectionParam[i] = 0.0;
+    }
+}
+
+RunContext::~RunContext()
+{
+    stopCheckpoints();
+    stopExport();
+    stopValidation();
+    stopEvaluation();
+    releaseSnapshots(false);
+}
+
+/**
+  * Set the statistics the run publishes to.
+  *
+  * @param stats Statistics of the GUI, NULL to publish none
+  */
+void RunContext::setStats(CoevStats *stats)
+{
+    this->stats = stats;
+    if (stats != NULL)
+        stats->setValidationFitness(-1.0);
+}
+
+/**
+  * Define some usefull vars to speed up the build fuzzy process. The fuzzy system must
+  * already be evaluated with the parameters of this context.
+  *
+  * @param fSystem Fuzzy system of the run
+  */
+void RunContext::setGenomeLayout(FuzzySystem *fSystem)
+{
+    layout.nbRules = fSystem->getNbRules();
+    layout.membersGenSize = fSystem->getMembershipsBitStringSize();
+    layout.ruleGenSize = fSystem->getRuleMaxBitStringSize();
+    layout.nbVarPerRule = fSystem->getNbVarPerRule();
+    layout.inSetsCodeSize = fSystem->getInSetsCodeSize();
+    layout.nbOutVars = fSystem->getNbOutVars();
+    layout.outSetsCodeSize = fSystem->getOutSetsCodeSize();
+    layout.fixedVars = params.fixedVars;
+    layout.ruleBitStringSize = fSystem->getRuleBitStringSize();
+    layout.defRulesPos = layout.ruleBitStringSize*layout.nbRules;
+    layout.defRulesSize = fSystem->getDefaultRulesBitStringSize();
+}
+
+/**
+  * Create the evaluation pool and the connections to the evaluation workers.
+  *
+  * @param fSystem Fuzzy system of the run, copied for every worker of the pool
+  * @param threads Number of workers of the pool, one per core if not positive. No pool
+  * is created for a single worker. The sample ranges are evaluated on the same pool, the
+  * evaluator waiting for them takes part. Without a pool, they get a pool of one worker
+  * less than the shards and the evolver evaluates the remaining shard.
+  * @param workers Addresses of the evaluation workers, may be empty
+  */
+void RunContext::startEvaluation(FuzzySystem *fSystem, int threads, const QStringList &workers)
+{
+    if (threads <= 0)
+        threads = QThread::idealThreadCount();
+    if (threads > 1) {
+        evaluatedSystem = fSystem;
+        evaluators.fill(NULL, threads);
+        replicas.fill(NULL, numa.getNodeCount());
+        evaluationTime.start();
+        // The workers create their evaluators once both pools are set
+        QMutexLocker locker(&replicaLock);
+        evaluationPool = new WorkStealingPool(threads, numa, &evaluatorSetup);
+        if (sampleShards > 1)
+            samplePool = evaluationPool;
+    }
+    else if (sampleShards > 1) {
+        samplePool = new WorkStealingPool(sampleShards - 1);
+    }
+    if (samplePool != NULL)
+        qDebug() << "Sample shards : " << sampleShards;
+    qDebug() << "Evaluation threads : " << threads;
+    if (numa.isEnabled())
+        qDebug() << "NUMA nodes : " << numa.getNodeCount();
+
+    // Worker processes, used instead of the pool while at least one of them answers
+    if (!workers.isEmpty()) {
+        evaluationFarm = new EvaluationFarm(workers, fSystem);
+        qDebug() << "Evaluation workers : " << workers.join(", ");
+    }
+}
+
+void RunContext::EvaluatorSetup::setupWorker(int worker, int node)
+{
+    context->createEvaluator(worker, node);
+}
+
+/**
+  * Create the evaluator of a worker of the evaluation pool, in the thread of the worker so
+  * that its fuzzy system is allocated on the node the worker is bound to. With NUMA nodes,
+  * the first worker of each node copies the dataset for the node.
+  *
+  * @param worker Index of the worker
+  * @param node NUMA node of the worker
+  */
+void RunContext::createEvaluator(int worker, int node)
+{
+    const NumericDataset *replica = NULL;
+    replicaLock.lock();
+    if (numa.isEnabled()) {
+        if (replicas[node] == NULL)
+            replicas[node] = new NumericDataset(*evaluatedSystem->getDataset());
+        replica = replicas[node];
+    }
+    replicaLock.unlock();
+    evaluators[worker] = new CoevEvaluator(this, evaluatedSystem->createEvaluationCopy(replica), true);
+}
+
+/**
+  * Log the number of pairs evaluated by the workers of each NUMA node since the start of
+  * the evaluation.
+  */
+void RunContext::reportNodeThroughput()
+{
+    const double seconds = qMax(1, evaluationTime.elapsed()) / 1000.0;
+    for (int node = 0; node < numa.getNodeCount(); node++) {
+        quint64 count = 0;
+        for (int i = 0; i < evaluators.size(); i++) {
+            if (numa.getNodeOfWorker(i) == node && evaluators[i] != NULL)
+                count += evaluators[i]->getEvaluationCount();
+        }
+        qDebug() << "NUMA node " << node << " : " << count << " evaluations, "
+                 << count / seconds << " per second";
+    }
+}
+
+/**
+  * Delete the evaluation pool and the connections to the workers. Must only be called
+  * when no evolver is running.
+  */
+void RunContext::stopEvaluation()
+{
+    if (samplePool != evaluationPool)
+        delete samplePool;
+    samplePool = NULL;
+    delete evaluationPool;
+    evaluationPool = NULL;
+    delete evaluationFarm;
+    evaluationFarm = NULL;
+    if (numa.isEnabled() && !evaluators.isEmpty())
+        reportNodeThroughput();
+    qDeleteAll(evaluators);
+    evaluators.clear();
+    qDeleteAll(replicas);
+    replicas.clear();
+}
+
+/**
+  * Load a validation dataset and start scoring the best systems on it in a low priority
+  * thread. The genome layout must be set.
+  *
+  * @param fSystem Fuzzy system of the run
+  * @param fileName Validation dataset, with the same columns as the one of the run
+  * @param patience Generations without improvement of the validation fitness after which
+  * the run stops, 0 to never stop
+  * @return false if the dataset could not be loaded, the run is then not validated
+  */
+bool RunContext::startValidation(FuzzySystem *fSystem, const QString &fileName, int patience)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Cannot open the validation dataset" << fileName;
+        return false;
+    }
+    QTextStream csvFile(&file);
+    QList<QStringList> *validationData = new QList<QStringList>;
+    while (!csvFile.atEnd())
+        validationData->append(csvFile.readLine().split(';'));
+
+    if (validationData->size() < 2 || validationData->at(0) != fSystem->getSystemData()->at(0)) {
+        qCritical() << "The validation dataset" << fileName << "does not have the columns of the training dataset";
+        delete validationData;
+        return false;
+    }
+
+    validation = new ValidationTracker(this, fSystem, validationData, patience);
+    validation->start(QThread::LowPriority);
+    qDebug() << "Validation dataset : " << fileName << ", " << validationData->size() - 1 << " samples";
+    return true;
+}
+
+/**
+  * Score the last submitted system and stop the validation thread. Must be called before
+  * the snapshots are released.
+  */
+void RunContext::stopValidation()
+{
+    delete validation;
+    validation = NULL;
+}
+
+/**
+  * Start exporting the best systems in a low priority thread, each time the best system
+  * improves. The genome layout must be set.
+  *
+  * @param fSystem Fuzzy system of the run
+  * @param fileName .ffs file the best system is exported to
+  * @param interval Minimum time between two exports, in seconds
+  */
+void RunContext::startExport(FuzzySystem *fSystem, const QString &fileName, int interval)
+{
+    exporter = new BestSystemExporter(this, fSystem, fileName, interval);
+    exporter->start(QThread::LowPriority);
+    qDebug() << "Best system exported to " << fileName << ", at most every " << interval << " s";
+}
+
+/**
+  * Export the last best system and stop the export thread. Must be called before the
+  * snapshots are released.
+  */
+void RunContext::stopExport()
+{
+    delete exporter;
+    exporter = NULL;
+}
+
+/**
+  * Start writing checkpoints of the run, the evolvers submit their populations to
+  * getSaveEngine().
+  *
+  * @param fileName Checkpoint file, replaced by each new checkpoint
+  * @param interval Generations between two checkpoints
+  * @param populationCount Number of evolved populations, two per island
+  * @param run Index of the run among the runs of the script
+  */
+void RunContext::startCheckpoints(const QString &fileName, int interval, int populationCount, int run)
+{
+    stopCheckpoints();
+    saveEngine = new SaveEngine(fileName, interval, populationCount, run, &checkpointData);
+    saveEngine->start();
+    qDebug() << "Checkpoint every " << interval << " generations to " << fileName;
+}
+
+/**
+  * Write the last complete checkpoint and stop the checkpoint thread. Must be called
+  * once the evolvers are done.
+  */
+void RunContext::stopCheckpoints()
+{
+    if (saveEngine == NULL)
+        return;
+    SaveEngine *engine = saveEngine;
+    saveEngine = NULL;
+    engine->finish();
+    engine->report();
+    delete engine;
+}
+
+/**
+  * Save the best system and the statistics history along the populations.
+  */
+QByteArray RunContext::CheckpointData::capture(quint32 generation)
+{
+    Q_UNUSED(generation);
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+
+    BestSystemSnapshot *best = context->getBestSnapshot();
+    out << (quint8) (best != NULL);
+    if (best != NULL)
+        out << best->getFitness() << best->getMembershipsGenotype() << best->getRulesGenotype();
+
+    context->statsLock.lock();
+    QVector<StatsRecord> history = context->statsHistory;
+    context->statsLock.unlock();
+    // The species record their statistics in any order within a generation
+    qStableSort(history.begin(), history.end());
+    out << (quint32) history.size();
+    for (int i = 0; i < history.size(); i++) {
+        const StatsRecord &record = history[i];
+        out << record.species << record.generation << record.populationSize << record.minFitness
+            << record.maxFitness << record.meanFitness << record.standardDeviation;
+    }
+    return data;
+}
+
+/**
+  * Restore the best system and the statistics saved with a checkpoint. The best system is
+  * evaluated again on a copy of fSystem for its metrics.
+  *
+  * @param data Data captured with the checkpoint
+  * @param generation Generation of the checkpoint, the statistics of later generations
+  * captured meanwhile are dropped
+  * @param fSystem Fuzzy system of the run
+  * @return false if the data is corrupted
+  */
+bool RunContext::restoreRunData(const QByteArray &data, quint32 generation, FuzzySystem *fSystem)
+{
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_4_6);
+
+    quint8 hasBest = 0;
+    qreal fitness = 0.0;
+    QBitArray memberships;
+    QBitArray rules;
+    in >> hasBest;
+    if (hasBest)
+        in >> fitness >> memberships >> rules;
+
+    QVector<StatsRecord> history;
+    quint32 count = 0;
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++) {
+        StatsRecord record;
+        in >> record.species >> record.generation >> record.populationSize >> record.minFitness
+           >> record.maxFitness >> record.meanFitness >> record.standardDeviation;
+        if (record.generation <= generation)
+            history.append(record);
+    }
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    if (hasBest) {
+        if (memberships.size() != layout.membersGenSize || rules.size() != layout.defRulesPos + layout.defRulesSize)
+            return false;
+        // On a copy, the evolvers already attached their evaluators to fSystem
+        CoevEvaluator evaluator(this, fSystem->createEvaluationCopy(), true);
+        evaluator.decodeMemberships(&memberships, evaluator.getMembershipsPositions());
+        evaluator.decodeRules(&rules, evaluator.getRuleGenomes(), evaluator.getDefaultRules());
+        evaluator.evaluate(*evaluator.getMembershipsPositions(), evaluator.getRuleGenomes(), evaluator.getDefaultRules());
+        offerBestSystem(new BestSystemSnapshot(evaluator.getFuzzySystem(), fitness, memberships, rules));
+    }
+
+    QMutexLocker locker(&statsLock);
+    statsHistory = history;
+    if (stats != NULL) {
+        for (int i = 0; i < history.size(); i++) {
+            const StatsRecord &record = history[i];
+            if (record.species == 1) {
+                stats->setFitMaxPop2(record.maxFitness);
+                stats->setFitAvgPop2(record.meanFitness);
+                stats->setFitMinPop2(record.minFitness);
+                stats->setFitStdPop2(record.standardDeviation);
+                stats->setSizePop2(record.populationSize);
+            }
+            else {
+                stats->setFitMaxPop1(record.maxFitness);
+                stats->setFitAvgPop1(record.meanFitness);
+                stats->setFitMinPop1(record.minFitness);
+                stats->setFitStdPop1(record.standardDeviation);
+                stats->setSizePop1(record.populationSize);
+            }
+            stats->setGenNumber(record.generation);
+        }
+    }
+    return true;
+}
+
+/**
+  * Return the best system found so far, or NULL. Lock free, the snapshot stays valid
+  * until the next quiescent state of the calling reader, see registerSnapshotReader().
+  */
+BestSystemSnapshot *RunContext::getBestSnapshot() const
+{
+    return loadAcquire(bestSnapshot);
+}
+
+/**
+  * Release the replaced snapshots, and the best one unless keepBest is set. Must only be
+  * called when no evolver is running.
+  */
+void RunContext::releaseSnapshots(bool keepBest)
+{
+    QMutexLocker locker(&snapshotLock);
+    if (!keepBest) {
+        BestSystemSnapshot *best = bestSnapshot.fetchAndStoreOrdered(0);
+        if (best != NULL)
+            best->release();
+    }
+    for (int i = 0; i < retiredSnapshots.size(); i++)
+        retiredSnapshots[i].snapshot->release();
+    retiredSnapshots.clear();
+}
+
+/**
+  * Register a thread which reads the best snapshot while the run goes on. The snapshots it
+  * reads stay valid until it calls snapshotReaderQuiescent(), replaced snapshots are only
+  * released once every registered reader has been quiescent since.
+  *
+  * @return Reader index, to pass to the other reader methods
+  */
+int RunContext::registerSnapshotReader()
+{
+    QMutexLocker locker(&snapshotLock);
+    int reader = readerEpochs.indexOf(NO_READER);
+    if (reader < 0) {
+        reader = readerEpochs.size();
+        readerEpochs.append(snapshotEpoch);
+    }
+    else {
+        readerEpochs[reader] = snapshotEpoch;
+    }
+    return reader;
+}
+
+/**
+  * Tell that reader no longer holds any snapshot, typically between two generations.
+  */
+void RunContext::snapshotReaderQuiescent(int reader)
+{
+    QMutexLocker locker(&snapshotLock);
+    readerEpochs[reader] = snapshotEpoch;
+    reclaimSnapshots();
+}
+
+/**
+  * Unregister a reader, it must not read any snapshot any more.
+  */
+void RunContext::unregisterSnapshotReader(int reader)
+{
+    QMutexLocker locker(&snapshotLock);
+    readerEpochs[reader] = NO_READER;
+    reclaimSnapshots();
+}
+
+/**
+  * Release the replaced snapshots no reader can hold any more. snapshotLock must be held.
+  */
+void RunContext::reclaimSnapshots()
+{
+    quint32 oldest = snapshotEpoch;
+    for (int i = 0; i < readerEpochs.size(); i++) {
+        if (readerEpochs[i] < oldest)
+            oldest = readerEpochs[i];
+    }
+    while (!retiredSnapshots.isEmpty() && retiredSnapshots.first().epoch <= oldest)
+        retiredSnapshots.takeFirst().snapshot->release();
+}
+
+/**
+  * Offer a freshly evaluated system as the best one. Called for every evaluated pair by
+  * both evolvers, the common case of a worse system only costs an atomic load.
+  *
+  * @param fSystem Evaluated fuzzy system
+  * @param fitness Fitness of the system
+  * @param membershipsGenotype Genotype the membership functions were decoded from
+  * @param rulesGenotype Genotype the rules were decoded from
+  */
+void RunContext::saveFuzzyAndFitness(FuzzySystem *fSystem, qreal fitness, const QBitArray *membershipsGenotype, const QBitArray *rulesGenotype)
+{
+    if (isBetterSystem(fitness, membershipsGenotype, rulesGenotype))
+        offerBestSystem(new BestSystemSnapshot(fSystem, fitness, *membershipsGenotype, *rulesGenotype));
+}
+
+/**
+  * Return true if a system of the given fitness and genotypes would replace the best one
+  * found so far, see BestSystemSnapshot::isReplacedBy().
+  */
+bool RunContext::isBetterSystem(qreal fitness, const QBitArray *membershipsGenotype, const QBitArray *rulesGenotype) const
+{
+    BestSystemSnapshot *current = getBestSnapshot();
+    return current == NULL || current->isReplacedBy(fitness, *membershipsGenotype, *rulesGenotype);
+}
+
+/**
+  * Publish snapshot as the best system unless the current one is better or is the same
+  * system, delete it otherwise. Of two systems of the same fitness, the last one offered
+  * is kept.
+  *
+  * @param snapshot Snapshot of an evaluated system, owned by this method
+  */
+void RunContext::offerBestSystem(BestSystemSnapshot *snapshot)
+{
+    const qreal fitness = snapshot->getFitness();
+    BestSystemSnapshot *current = getBestSnapshot();
+    for (;;) {
+        // Never replace a better system, the other evolver may have published first
+        if (current != NULL && !current->isReplacedBy(fitness, snapshot->getMembershipsGenotype(), snapshot->getRulesGenotype())) {
+            delete snapshot;
+            return;
+        }
+        if (bestSnapshot.testAndSetOrdered(current, snapshot))
+            break;
+        current = getBestSnapshot();
+    }
+
+    QMutexLocker locker(&snapshotLock);
+    if (current != NULL) {
+        RetiredSnapshot retired;
+        retired.snapshot = current;
+        retired.epoch = ++snapshotEpoch;
+        retiredSnapshots.append(retired);
+    }
+    // A better system may have been published meanwhile, its publisher updates the stats
+    if (getBestSnapshot() != snapshot)
+        return;
+    if (validation != NULL)
+        validation->submit(snapshot);
+    if (exporter != NULL)
+        exporter->submit(snapshot);
+    if (stats == NULL)
+        return;
+
+    stats->setSensi(snapshot->getSensitivity());
+    stats->setSpeci(snapshot->getSpecificity());
+    stats->setAccu(snapshot->getAccuracy());
+    stats->setPpv(snapshot->getPpv());
+    stats->setRmse(snapshot->getRmse());
+    stats->setRrse(snapshot->getRrse());
+    stats->setRae(snapshot->getRae());
+    stats->setMse(snapshot->getMse());
+    stats->setDistanceThreshold(snapshot->getDistanceThreshold());
+    stats->setDistanceMinThreshold(snapshot->getDistanceMinThreshold());
+    stats->setDontCare(snapshot->getDontCare());
+    stats->setOverLearn(snapshot->getOverLearn());
+    stats->setFitMaxPop1(fitness);
+    stats->setBestSysDesc(snapshot->getDescription());
+}
+
+/**
+  * Ask the evolvers to save the best system at the end of their current generation.
+  *
+  * @param fileName Name of the .ffs file
+  */
+void RunContext::requestSave(const QString &fileName)
+{
+    QMutexLocker locker(&snapshotLock);
+    pendingSaveFileName = fileName;
+}
+
+/**
+  * Return and clear the file name of a save requested during the run.
+  */
+QString RunContext::takePendingSave()
+{
+    QMutexLocker locker(&snapshotLock);
+    QString fileName = pendingSaveFileName;
+    pendingSaveFileName.clear();
+    return fileName;
+}
+
+/**
+  * Publish the statistics of a generation, if the run has statistics.
+  */
+void RunContext::saveSystemStats(QString name, qreal minFitness, qreal maxFitness, qreal meanFitness, qreal standardDeviation, int populationSize, int generation)
+{
+    QMutexLocker locker(&statsLock);
+    if (saveEngine != NULL) {
+        StatsRecord record;
+        record.species = (name == "RULES") ? 1 : 0;
+        record.generation = generation;
+        record.populationSize = populationSize;
+        record.minFitness = minFitness;
+        record.maxFitness = maxFitness;
+        record.meanFitness = meanFitness;
+        record.standardDeviation = standardDeviation;
+        statsHistory.append(record);
+    }
+    if (stats == NULL)
+        return;
+
+    if (name == "RULES") {
+        stats->setFitMaxPop2(maxFitness);
+        stats->setFitAvgPop2(meanFitness);
+        stats->setFitMinPop2(minFitness);
+        stats->setFitStdPop2(standardDeviation);
+        stats->setSizePop2(populationSize);
+    }
+    else {
+        stats->setFitMaxPop1(maxFitness);
+        stats->setFitAvgPop1(meanFitness);
+        stats->setFitMinPop1(minFitness);
+        stats->setFitStdPop1(standardDeviation);
+        stats->setSizePop1(populationSize);
+    }
+    stats->setGenNumber(generation);
+
+    // Queue the generation for the plot, which takes it at its next frame
+    CoevStats::Sample sample;
+    sample.species = (name == "RULES") ? 1 : 0;
+    sample.generation = generation;
+    sample.populationSize = populationSize;
+    sample.fitMax = maxFitness;
+    sample.fitMin = minFitness;
+    sample.fitAvg = meanFitness;
+    sample.fitStd = standardDeviation;
+    sample.validationFitness = stats->getValidationFitness();
+    stats->publishSample(sample);
+}
+
+/**
+  * Called by the evolvers at the end of each generation. Tell the background threads the
+  * generation reached, and stop the run if the validation fitness has not improved for
+  * too long.
+  */
+void RunContext::endGeneration(int generation)
+{
+    if (exporter != NULL)
+        exporter->setGeneration(generation);
+    if (validation == NULL)
+        return;
+    validation->setGeneration(generation);
+    if (validation->isStagnant()) {
+        qDebug() << "Validation fitness stagnant, stopping the run at generation " << generation;
+        requestStop();
+    }
+}
+
+/**
+  * Publish the validation fitness of a best system, called by the validation thread.
+  *
+  * @param generation Generation the system was found at
+  * @param trainingFitness Fitness of the system on the training dataset
+  * @param validationFitness Fitness of the system on the validation dataset
+  */
+void RunContext::publishValidation(int generation, qreal trainingFitness, float validationFitness)
+{
+    qDebug() << "Validation : generation " << generation << ", training fitness " << trainingFitness
+             << ", validation fitness " << validationFitness;
+    if (stats == NULL)
+        return;
+
+    QMutexLocker locker(&statsLock);
+    stats->setValidationFitness(validationFitness);
+}
@@ -0,0 +1,238 @@
+/**
+  * @file   runcontext.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class RunContext
+  * @brief State of one evolution run, shared by its evolvers and evaluators.
+  *
+  * The context holds the parameters of the run, copied from the system parameters when it
+  * is built, the genome layout, the best system found so far, the fitness cache and the
+  * evaluation resources. Every object of a run reaches them through its context instead of
+  * process wide statics, so that several runs can execute at the same time in one process.
+  * Only the GUI statistics remain shared, a context publishes them only if it is given the
+  * CoevStats instance.
+  */
+
+#ifndef RUNCONTEXT_H
+#define RUNCONTEXT_H
+
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QTime>
+#include <QVector>
+
+#include "atomicops.h"
+#include "bestsystemsnapshot.h"
+#include "evaluationparameters.h"
+#include "fitnesscache.h"
+#include "numatopology.h"
+#include "numericdataset.h"
+#include "saveengine.h"
+#include "workstealingpool.h"
+
+class BestSystemExporter;
+class CoevEvaluator;
+class CoevStats;
+class EvaluationFarm;
+class FuzzySystem;
+class SystemParameters;
+class ValidationTracker;
+
+class RunContext
+{
+public:
+    // Genome layout, constant for the whole run
+    struct GenomeLayout
+    {
+        int nbRules;
+        int membersGenSize;
+        int ruleGenSize;
+        int nbVarPerRule;
+        int inSetsCodeSize;
+        int nbOutVars;
+        int outSetsCodeSize;
+        int ruleBitStringSize;
+        int defRulesPos;
+        int defRulesSize;
+        bool fixedVars;
+    };
+
+    RunContext(SystemParameters &sysParams);
+    RunContext(const EvaluationParameters &params);
+    ~RunContext();
+
+    void setGenomeLayout(FuzzySystem *fSystem);
+    void startEvaluation(FuzzySystem *fSystem, int threads, const QStringList &workers);
+    void stopEvaluation();
+    bool startValidation(FuzzySystem *fSystem, const QString &fileName, int patience);
+    void stopValidation();
+    void startExport(FuzzySystem *fSystem, const QString &fileName, int interval);
+    void stopExport();
+    void startCheckpoints(const QString &fileName, int interval, int populationCount, int run);
+    void stopCheckpoints();
+    bool restoreRunData(const QByteArray &data, quint32 generation, FuzzySystem *fSystem);
+    void setStats(CoevStats *stats);
+
+    inline const EvaluationParameters *getEvaluationParameters() const {return &params;}
+    inline const GenomeLayout &getGenomeLayout() const {return layout;}
+    inline bool getVerbose() const {return verbose;}
+    inline qreal getMaxFitness(int species) const {return maxFitness[species];}
+    inline const QString &getSelection(int species) const {return selection[species];}
+    inline float getSelectionParam(int species) const {return selectionParam[species];}
+    inline const QString &getCrossover(int species) const {return crossover[species];}
+    // Seed of the random streams of the evolvers, negative for an unseeded run
+    inline qint64 getRandomSeed() const {return randomSeed;}
+
+    // Read by every evolver and evaluation worker between two pairs
+    inline void requestStop() {storeRelease(stop, 1);}
+    inline bool isStopRequested() const {return loadAcquire(stop) != 0;}
+
+    inline FitnessCache &getFitnessCache() {return fitnessCache;}
+    // Workers evaluating the pairs of both populations, NULL to evaluate in the evolver threads
+    inline WorkStealingPool *getEvaluationPool() const {return evaluationPool;}
+    // One evaluator per worker of the pool, on its own copy of the fuzzy system
+    inline CoevEvaluator *getEvaluator(int worker) const {return evaluators[worker];}
+    // Workers evaluating the sample ranges of each pair, the evaluation pool if there is
+    // one, NULL if the samples are not split
+    inline WorkStealingPool *getSamplePool() const {return samplePool;}
+    inline int getSampleShards() const {return sampleShards;}
+    // Worker processes evaluating the pairs, NULL if the script did not list any
+    inline EvaluationFarm *getEvaluationFarm() const {return evaluationFarm;}
+    // Writes the checkpoints of the run, NULL if the script did not ask for any
+    inline SaveEngine *getSaveEngine() const {return saveEngine;}
+
+    BestSystemSnapshot *getBestSnapshot() const;
+    bool isBetterSystem(qreal fitness, const QBitArray *membershipsGenotype, const QBitArray *rulesGenotype) const;
+    void offerBestSystem(BestSystemSnapshot *snapshot);
+    void saveFuzzyAndFitness(FuzzySystem *fSystem, qreal fitness, const QBitArray *membershipsGenotype, const QBitArray *rulesGenotype);
+    void releaseSnapshots(bool keepBest);
+    int registerSnapshotReader();
+    void snapshotReaderQuiescent(int reader);
+    void unregisterSnapshotReader(int reader);
+    void requestSave(const QString &fileName);
+    QString takePendingSave();
+    void saveSystemStats(QString name, qreal minFitness, qreal maxFitness, qreal meanFitness, qreal standardDeviation, int populationSize, int generation);
+    void endGeneration(int generation);
+    void publishValidation(int generation, qreal trainingFitness, float validationFitness);
+
+private:
+    RunContext(const RunContext&);
+    RunContext& operator=(const RunContext&);
+
+    EvaluationParameters params;
+    GenomeLayout layout;
+    bool verbose;
+    qreal maxFitness[2];
+    QString selection[2];
+    float selectionParam[2];
+    QString crossover[2];
+    qint64 randomSeed;
+
+    QAtomicInt stop;
+    FitnessCache fitnessCache;
+    WorkStealingPool *evaluationPool;
+    QVector<CoevEvaluator*> evaluators;
+
+    // Each worker of the evaluation pool creates its own evaluator, on its NUMA node
+    class EvaluatorSetup : public WorkStealingPool::WorkerSetup
+    {
+    public:
+        EvaluatorSetup(RunContext *context) : context(context) {}
+        void setupWorker(int worker, int node);
+    private:
+        RunContext *context;
+    };
+    EvaluatorSetup evaluatorSetup;
+    void createEvaluator(int worker, int node);
+    void reportNodeThroughput();
+    NumaTopology numa;
+    FuzzySystem *evaluatedSystem;
+    // One replica of the dataset per NUMA node, read by the evaluators of its workers
+    QVector<NumericDataset*> replicas;
+    // Also held by startEvaluation() until the pools are set
+    QMutex replicaLock;
+    QTime evaluationTime;
+
+    int sampleShards;
+    WorkStealingPool *samplePool;
+    EvaluationFarm *evaluationFarm;
+    // Scores the best systems on the validation dataset, NULL without one
+    ValidationTracker *validation;
+    // Exports the best systems while the run goes on, NULL if the script did not ask for it
+    BestSystemExporter *exporter;
+
+    // Captures the best system and the statistics of the run with each checkpoint
+    class CheckpointData : public SaveEngine::RunData
+    {
+    public:
+        CheckpointData(RunContext *context) : context(context) {}
+        QByteArray capture(quint32 generation);
+    private:
+        RunContext *context;
+    };
+    CheckpointData checkpointData;
+    SaveEngine *saveEngine;
+
+    // Statistics of the GUI, NULL if the run does not publish any
+    CoevStats *stats;
+    QMutex statsLock;
+    // Statistics of every generation, kept for the checkpoints
+    struct StatsRecord
+    {
+        qint32 species;
+        quint32 generation;
+        qint32 populationSize;
+        qreal minFitness;
+        qreal maxFitness;
+        qreal meanFitness;
+        qreal standardDeviation;
+
+        inline bool operator<(const StatsRecord &other) const {
+            return generation != other.generation ? generation < other.generation : species < other.species;
+        }
+    };
+    QVector<StatsRecord> statsHistory;
+
+    // Best system found so far, replaced with a compare and swap, never modified once published
+    QAtomicPointer<BestSystemSnapshot> bestSnapshot;
+    // Replaced snapshots, with the epoch they were replaced at. A snapshot is released once
+    // every registered reader has been quiescent since, it cannot hold it any more.
+    struct RetiredSnapshot
+    {
+        BestSystemSnapshot *snapshot;
+        quint32 epoch;
+    };
+    QList<RetiredSnapshot> retiredSnapshots;
+    quint32 snapshotEpoch;
+    // Epoch of the last quiescent state of each reader, NO_READER for a free slot
+    static const quint32 NO_READER = 0xffffffff;
+    QVector<quint32> readerEpochs;
+    void reclaimSnapshots();
+    // File requested by the GUI while the run is in progress
+    QString pendingSaveFileName;
+    QMutex snapshotLock;
+};
+
+#endif // RUNCONTEXT_H
@@ -0,0 +1,125 @@
+/**
+  * @file   snapshotconsumer.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  *
+  * @class SnapshotConsumer
+  * @brief Base of the threads that process the best systems of a run in the background.
+  */
+
+#include <QTime>
+
+#include "snapshotconsumer.h"
+
+/**
+  * Constructor. Call start() to begin processing the submitted systems.
+  *
+  * @param evaluator Evaluator the systems are rebuilt in, owned by the consumer
+  * @param interval Minimum time between two snapshots, in milliseconds
+  */
+SnapshotConsumer::SnapshotConsumer(CoevEvaluator *evaluator, int interval) :
+    evaluator(evaluator), interval(qMax(0, interval)), pending(NULL), pendingGeneration(0), busy(false),
+    quit(false), generation(0), consumed(0)
+{
+}
+
+/**
+  * Destructor. The subclasses must call finish() in theirs, before their members go away.
+  */
+SnapshotConsumer::~SnapshotConsumer()
+{
+    finish();
+    if (pending != NULL)
+        pending->release();
+    delete evaluator;
+}
+
+/**
+  * Hand a new best system over to the consumer. Never waits for the processing of the
+  * previous one.
+  *
+  * @param snapshot Published best system, the consumer takes a reference to it
+  */
+void SnapshotConsumer::submit(BestSystemSnapshot *snapshot)
+{
+    QMutexLocker locker(&lock);
+    snapshot->retain();
+    if (pending != NULL)
+        pending->release();
+    pending = snapshot;
+    pendingGeneration = generation;
+    wake.wakeAll();
+}
+
+/**
+  * Tell the consumer the generation an evolver has reached.
+  */
+void SnapshotConsumer::setGeneration(int generation)
+{
+    QMutexLocker locker(&lock);
+    if (generation > this->generation)
+        this->generation = generation;
+}
+
+/**
+  * Process the last submitted system, if any, without waiting for the interval, stop the
+  * thread and report.
+  */
+void SnapshotConsumer::finish()
+{
+    lock.lock();
+    const bool wasRunning = !quit;
+    quit = true;
+    wake.wakeAll();
+    lock.unlock();
+    wait();
+
+    if (wasRunning)
+        report();
+}
+
+void SnapshotConsumer::run()
+{
+    QTime sinceConsumed;
+    for (;;) {
+        lock.lock();
+        while (pending == NULL && !quit)
+            wake.wait(&lock);
+        // The systems published before the interval is over replace each other
+        while (!quit && consumed > 0 && sinceConsumed.elapsed() < interval)
+            wake.wait(&lock, interval - sinceConsumed.elapsed());
+        BestSystemSnapshot *snapshot = pending;
+        const int snapshotGeneration = pendingGeneration;
+        pending = NULL;
+        busy = snapshot != NULL;
+        lock.unlock();
+        if (snapshot == NULL)
+            return;
+
+        consume(snapshot, snapshotGeneration);
+        snapshot->release();
+        sinceConsumed.start();
+        lock.lock();
+        busy = false;
+        consumed++;
+        lock.unlock();
+    }
+}
@@ -0,0 +1,92 @@
+/**
+  * @file   snapshotconsumer.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  *
+  * @class SnapshotConsumer
+  * @brief Base of the threads that process the best systems of a run in the background.
+  *
+  * Each time the run publishes a better system, its snapshot is submitted to the
+  * consumer, which processes it in its own thread. The evolvers never wait for it : only
+  * the latest submitted snapshot is kept, the ones it replaces are skipped. Two snapshots
+  * are processed at least the given interval apart.
+  */
+
+#ifndef SNAPSHOTCONSUMER_H
+#define SNAPSHOTCONSUMER_H
+
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+#include "bestsystemsnapshot.h"
+#include "coevevaluator.h"
+
+class SnapshotConsumer : public QThread
+{
+public:
+    SnapshotConsumer(CoevEvaluator *evaluator, int interval);
+    virtual ~SnapshotConsumer();
+
+    void submit(BestSystemSnapshot *snapshot);
+    void setGeneration(int generation);
+    void finish();
+
+protected:
+    void run();
+
+    /**
+      * Process snapshot in the thread of the consumer. The snapshot is released after,
+      * retain it to keep it.
+      *
+      * @param generation Generation the system was found at
+      */
+    virtual void consume(BestSystemSnapshot *snapshot, int generation) = 0;
+
+    /**
+      * Log the outcome of the consumer, once its thread is stopped.
+      */
+    virtual void report() = 0;
+
+    // Both must be called with lock held
+    inline bool isIdle() const {return pending == NULL && !busy;}
+    inline int getGeneration() const {return generation;}
+
+    inline int getConsumed() const {return consumed;}
+
+    // Evaluator of the consumer, owns its fuzzy system
+    CoevEvaluator *evaluator;
+    QMutex lock;
+
+private:
+    // Minimum time between two snapshots, in milliseconds
+    const int interval;
+    QWaitCondition wake;
+    // Latest submitted system, not processed yet, and the generation it was found at
+    BestSystemSnapshot *pending;
+    int pendingGeneration;
+    bool busy;
+    bool quit;
+    int generation;
+    int consumed;
+};
+
+#endif // SNAPSHOTCONSUMER_H
@@ -0,0 +1,102 @@
+/**
+  * @file   validationtracker.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  *
+  * @class ValidationTracker
+  * @brief Scores the best systems of a run on a held-out dataset, in the background.
+  */
+
+#include "validationtracker.h"
+#include "runcontext.h"
+
+/**
+  * Constructor. Call start() to begin scoring the submitted systems.
+  *
+  * @param context Run the systems belong to, its genome layout must be set
+  * @param fSystem Fuzzy system of the run, copied with the validation dataset
+  * @param validationData Validation dataset, with the same columns as the one of fSystem. Owned by the tracker.
+  * @param patience Generations without improvement before the run is stagnant, 0 for never
+  */
+ValidationTracker::ValidationTracker(RunContext *context, FuzzySystem *fSystem, QList<QStringList> *validationData, int patience) :
+    SnapshotConsumer(new CoevEvaluator(context, fSystem->createDatasetCopy(validationData), true), 0),
+    context(context), validationData(validationData), patience(patience), bestFitness(-1.0), bestSystem(NULL),
+    bestGeneration(0)
+{
+}
+
+ValidationTracker::~ValidationTracker()
+{
+    finish();
+    if (bestSystem != NULL)
+        bestSystem->release();
+    // The evaluator still refers to the validation dataset
+    delete evaluator;
+    evaluator = NULL;
+    delete validationData;
+}
+
+/**
+  * Return true if the validation fitness has not improved for patience generations. A run
+  * is never stagnant while a system is waiting to be scored.
+  */
+bool ValidationTracker::isStagnant()
+{
+    QMutexLocker locker(&lock);
+    if (patience <= 0 || bestSystem == NULL || !isIdle())
+        return false;
+    return getGeneration() - bestGeneration >= patience;
+}
+
+/**
+  * Score snapshot on the validation dataset and keep it if it is the best so far.
+  */
+void ValidationTracker::consume(BestSystemSnapshot *snapshot, int generation)
+{
+    evaluator->decodeMemberships(&snapshot->getMembershipsGenotype(), evaluator->getMembershipsPositions());
+    evaluator->decodeRules(&snapshot->getRulesGenotype(), evaluator->getRuleGenomes(), evaluator->getDefaultRules());
+    const float fitness = evaluator->evaluate(*evaluator->getMembershipsPositions(), evaluator->getRuleGenomes(), evaluator->getDefaultRules());
+
+    BestSystemSnapshot *replaced = NULL;
+    lock.lock();
+    if (fitness > bestFitness) {
+        bestFitness = fitness;
+        replaced = bestSystem;
+        bestSystem = snapshot;
+        bestSystem->retain();
+        bestGeneration = generation;
+    }
+    lock.unlock();
+
+    context->publishValidation(generation, snapshot->getFitness(), fitness);
+    if (replaced != NULL)
+        replaced->release();
+}
+
+/**
+  * Log the best system on the validation dataset.
+  */
+void ValidationTracker::report()
+{
+    if (bestSystem != NULL)
+        qDebug() << "Best validation fitness : " << bestFitness << " at generation " << bestGeneration
+                 << ", training fitness " << bestSystem->getFitness();
+}
@@ -0,0 +1,66 @@
+/**
+  * @file   validationtracker.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  *
+  * @class ValidationTracker
+  * @brief Scores the best systems of a run on a held-out dataset, in the background.
+  *
+  * The tracker rebuilds the submitted systems on the validation dataset. The run is
+  * stagnant once the validation fitness has not improved for the given number of
+  * generations.
+  */
+
+#ifndef VALIDATIONTRACKER_H
+#define VALIDATIONTRACKER_H
+
+#include <QList>
+#include <QStringList>
+
+#include "snapshotconsumer.h"
+
+class RunContext;
+
+class ValidationTracker : public SnapshotConsumer
+{
+public:
+    ValidationTracker(RunContext *context, FuzzySystem *fSystem, QList<QStringList> *validationData, int patience);
+    ~ValidationTracker();
+
+    bool isStagnant();
+
+protected:
+    void consume(BestSystemSnapshot *snapshot, int generation);
+    void report();
+
+private:
+    RunContext *context;
+    QList<QStringList> *validationData;
+    // Generations without improvement of the validation fitness before the run is stagnant, 0 for never
+    const int patience;
+
+    // Best validation fitness so far, the system it was measured on and its generation
+    float bestFitness;
+    BestSystemSnapshot *bestSystem;
+    int bestGeneration;
+};
+
+#endif // VALIDATIONTRACKER_H
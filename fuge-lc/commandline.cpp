@@ -0,0 +1,285 @@
+/**
+  * @file   commandline.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  * @class CommandLine
+  * @brief Parses the command line arguments shared by FUGE-LC and fuge-cli.
+  */
+
+#include <QFile>
+#include <iostream>
+
+#include "commandline.h"
+#include "systemparameters.h"
+
+CommandLine::CommandLine() :
+    useGUI(true), runFromCmd(false), verbose(false), eval(false), predict(false), worker(false), exportC(false), help(false),
+    dataLoaded(false), scriptLoaded(false), fuzzyLoaded(false)
+{
+}
+
+/**
+  * Return the arguments of main(), they can be parsed before the application is created.
+  */
+QStringList CommandLine::arguments(int argc, char *argv[])
+{
+    QStringList args;
+    for (int i = 0; i < argc; i++)
+        args.append(QString::fromLocal8Bit(argv[i]));
+    return args;
+}
+
+/**
+  * Displays the command line help.
+  */
+void CommandLine::showHelp()
+{
+    std::cout << std::endl << "Valid parameters are :" << std::endl << std::endl;
+    std::cout << " --verbose : Verbose output" << std::endl << std::endl;
+    std::cout << " --evaluate : Perform an evaluation of the given fuzzy system on the specified database" << std::endl << std::endl;
+    std::cout << " --predict : Perform a prediction of the given fuzzy system on the specified database" << std::endl << std::endl;
+    std::cout << " -d  : Dataset  (required to run automatically from command line)" << std::endl;
+    std::cout << "       Value : Path to the dataset" << std::endl << std::endl;
+    std::cout << " -s  : Script   (required to run automatically from command line)" << std::endl;
+    std::cout << "       Value : Path to the execution script" << std::endl << std::endl;;
+    std::cout << " -f  : Fuzzy system   (required for evalation/prediction)" << std::endl;
+    std::cout << "       Value : Path to the fuzzy system file" << std::endl << std::endl;;
+    std::cout << " -g  : GUI  (optionnal)" << std::endl;
+    std::cout << "       Value : yes (Show the GUI) " << std::endl;
+    std::cout << "               no  (Do not show the GUI) " << std::endl << std::endl;
+    std::cout << " --export-c : Write the inference of the given fuzzy system as C source, checked against the dataset if one is given" << std::endl;
+    std::cout << "       Value : Path to the C file, a header is written next to it" << std::endl << std::endl;
+    std::cout << " --worker : Serve fitness evaluations to the runs of other instances (requires a dataset)" << std::endl;
+    std::cout << "       Value : Local socket name, or [host:]port to listen on TCP" << std::endl << std::endl;
+    std::cout << " --resume : Resume the runs of the script from a checkpoint (optionnal)" << std::endl;
+    std::cout << "       Value : Path to the checkpoint file" << std::endl << std::endl;
+    std::cout << " --serve : Serve the predictions of fuzzy systems kept loaded, reloaded when their files change" << std::endl;
+    std::cout << "       Values : socket fuzzyFile [fuzzyFile ...]" << std::endl << std::endl;
+    std::cout << " --load-test : Measure the latency and the throughput of a prediction server" << std::endl;
+    std::cout << "       Values : socket system datasetFile [clients [requests]]" << std::endl << std::endl;
+    std::cout << " --genealogy : Print a generation, or the ancestry of one of its individuals, from a genealogy archive" << std::endl;
+    std::cout << "       Values : archive population generation [position]" << std::endl << std::endl;
+    std::cout << " --help : this message" << std::endl << std::endl;;
+}
+
+/**
+  * Prompts the invalid usage error message.
+  *
+  * @param progName Name of this executable.
+  */
+static void invalidUsage(QString progName)
+{
+    std::cout << std::endl << "ERROR : Invalid parameters format !" << std::endl << std::endl;
+    std::cout << "Usage : " << progName.toStdString() << " -p1 value -p2 value ..." << std::endl << std::endl;
+    std::cout << "For parameter list run with --help" << std::endl << std::endl;
+}
+
+/**
+  * Prompts the invalid parameter error message.
+  */
+static void invalidParam()
+{
+    std::cout << std::endl << "ERROR : Invalid parameter !" << std::endl;
+    CommandLine::showHelp();
+}
+
+/**
+  * Parse the command line arguments.
+  *
+  * @param args Arguments passed in a StringList structure.
+  * @return false if the application must exit, see help
+  */
+bool CommandLine::parse(const QStringList &args)
+{
+    // Look if we run directly from cmdline
+    if (args.size() == 1) {
+        runFromCmd = false;
+        return true;
+    }
+
+    // Help parameter
+    if (args.at(1) == QString("--help")) {
+            showHelp();
+            help = true;
+            return false;
+    }
+    for (int i = 1; i < args.size(); i+=2) {
+        // Look for the argument marker : '-'
+        if (args.at(i).size() < 2 || args.at(i).at(0) != QChar('-')) {
+            invalidUsage(args.at(0));
+            return false;
+        }
+        // Dataset file parameter
+        else if (args.at(i).at(1) == QChar('d')) {
+            if (i+1 >= args.size()) {
+                invalidUsage(args.at(0));
+                return false;
+            }
+            QFile file(args.at(i+1));
+            if (file.exists()) {
+                datasetFile = args.at(i+1);
+                SystemParameters& sysParams = SystemParameters::getInstance();
+                sysParams.setDatasetName(datasetFile);
+                dataLoaded = true;
+            }
+            else {
+                std::cout << std::endl << "ERROR : file \"" << args.at(i+1).toStdString() << "\" not found !" << std::endl << std::endl;
+                return false;
+            }
+        }
+        // Script file parameter
+        else if (args.at(i).at(1) == QChar('s')) {
+            if (i+1 >= args.size()) {
+                invalidUsage(args.at(0));
+                return false;
+            }
+            QFile file(args.at(i+1));
+            if (file.exists()) {
+                scriptFile = args.at(i+1);
+                scriptLoaded = true;
+            }
+            else {
+                std::cout << std::endl << "ERROR : file \"" << args.at(i+1).toStdString() << "\" not found !" << std::endl << std::endl;
+                return false;
+            }
+        }
+        // Fuzzy file parameter
+        else if (args.at(i).at(1) == QChar('f')) {
+            if (i+1 >= args.size()) {
+                invalidUsage(args.at(0));
+                return false;
+            }
+            QFile file(args.at(i+1));
+            if (file.exists()) {
+                fuzzyFile = args.at(i+1);
+                fuzzyLoaded = true;
+            }
+            else {
+                std::cout << std::endl << "ERROR : file \"" << args.at(i+1).toStdString() << "\" not found !" << std::endl << std::endl;
+                return false;
+            }
+        }
+        // Gui parameter
+        else if (args.at(i).at(1) == QChar('g')) {
+            if (i+1 < args.size() && args.at(i+1) == QString("yes")) {
+                useGUI = true;
+            }
+            else if (i+1 < args.size() && args.at(i+1) == QString("no")) {
+                useGUI = false;
+            }
+            else {
+                std::cout << std::endl << "Error : incorrect value \"" << args.value(i+1).toStdString() << "\" !" << std::endl << std::endl;
+                return false;
+            }
+        }
+        // Worker address parameter
+        else if (args.at(i) == "--worker") {
+            if (i+1 >= args.size()) {
+                invalidUsage(args.at(0));
+                return false;
+            }
+            workerAddress = args.at(i+1);
+            worker = true;
+        }
+        // C source to export the fuzzy system to
+        else if (args.at(i) == "--export-c") {
+            if (i+1 >= args.size()) {
+                invalidUsage(args.at(0));
+                return false;
+            }
+            exportFile = args.at(i+1);
+            exportC = true;
+        }
+        // Checkpoint to resume from
+        else if (args.at(i) == "--resume") {
+            if (i+1 >= args.size()) {
+                invalidUsage(args.at(0));
+                return false;
+            }
+            QFile file(args.at(i+1));
+            if (file.exists()) {
+                SystemParameters::getInstance().setResumeFile(args.at(i+1));
+            }
+            else {
+                std::cout << std::endl << "ERROR : file \"" << args.at(i+1).toStdString() << "\" not found !" << std::endl << std::endl;
+                return false;
+            }
+        }
+        else if (args.at(i).at(1) == QChar('-')) {
+            if (args.at(i) == "--verbose") {
+                verbose = true;
+            }
+            else if (args.at(i) == "--evaluate") {
+                eval = true;
+            }
+            else if (args.at(i) == "--predict") {
+                predict = true;
+            }
+            else {
+                invalidParam();
+                return false;
+            }
+            i--;
+        }
+        else {
+            invalidParam();
+            return false;
+        }
+    }
+    if (worker) {
+        if (!dataLoaded) {
+            std::cout << std::endl << "ERROR : you must specify a dataset to run a worker !" << std::endl << std::endl;
+            return false;
+        }
+    }
+    else if (exportC) {
+        if (eval || predict) {
+            std::cout << std::endl << "ERROR : you cannot export a fuzzy system and perform an evaluation/prediction at the same time !" << std::endl << std::endl;
+            return false;
+        }
+        if (!fuzzyLoaded) {
+            std::cout << std::endl << "ERROR : you must specify a fuzzy system to export !" << std::endl << std::endl;
+            return false;
+        }
+    }
+    else if (eval || predict) {
+        if (eval && predict) {
+            std::cout << std::endl << "ERROR : yout cannot perform both a prediction and a evaluation !" << std::endl << std::endl;
+            return false;
+        }
+        if ((eval || predict) && !fuzzyLoaded) {
+            std::cout << std::endl << "ERROR : you must specify a fuzzy system to perform a evaluation/prediction !" << std::endl << std::endl;
+            return false;
+        }
+        if (!dataLoaded) {
+            std::cout << std::endl << "ERROR : yout must specify a dataset to perform a evaluation/prediction !" << std::endl << std::endl;
+            return false;
+        }
+    }
+    else {
+        if (!(dataLoaded && scriptLoaded)) {
+            std::cout << std::endl << "ERROR : you must load a dataset AND a script to run automatically from command line !" << std::endl << std::endl;
+            return false;
+        }
+    }
+
+    runFromCmd = true;
+    return true;
+}
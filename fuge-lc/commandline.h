@@ -0,0 +1,65 @@
+/**
+  * @file   commandline.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  * @class CommandLine
+  * @brief Parses the command line arguments shared by FUGE-LC and fuge-cli.
+  */
+
+#ifndef COMMANDLINE_H
+#define COMMANDLINE_H
+
+#include <QString>
+#include <QStringList>
+
+class CommandLine
+{
+public:
+    CommandLine();
+
+    static QStringList arguments(int argc, char *argv[]);
+    static void showHelp();
+    bool parse(const QStringList &args);
+
+    QString datasetFile;
+    QString scriptFile;
+    QString fuzzyFile;
+    QString workerAddress;
+    QString exportFile;
+    // Show the GUI, fuge-cli refuses it
+    bool useGUI;
+    // Run a script, an evaluation or a prediction instead of waiting for the user
+    bool runFromCmd;
+    bool verbose;
+    bool eval;
+    bool predict;
+    bool worker;
+    // Write the fuzzy system as C source instead of running anything
+    bool exportC;
+    // The help was asked for, parse() returned false without an error
+    bool help;
+
+private:
+    bool dataLoaded;
+    bool scriptLoaded;
+    bool fuzzyLoaded;
+};
+
+#endif // COMMANDLINE_H
@@ -27,29 +27,19 @@
   */
 
 #include "computethread.h"
-int ComputeThread::nbRules = 0;
-int ComputeThread::membersGenSize = 0;
-int ComputeThread::ruleGenSize = 0;
-int ComputeThread::nbVarPerRule = 0;
-int ComputeThread::inSetsCodeSize = 0;
-int ComputeThread::nbOutVars = 0;
-int ComputeThread::outSetsCodeSize = 0;
 FuzzySystem* ComputeThread::bestFSystem = 0;
 qreal ComputeThread::bestFitness = 0.0;
 QString ComputeThread::bestFuzzySystemDescription = "";
-SystemParameters *ComputeThread::sysParams = NULL;
-QMutex ComputeThread::mutex;
-QMutex ComputeThread::mutex2;
-bool ComputeThread::stop = false;
 
 ComputeThread::ComputeThread()
 {
     fuzzySystemLoaded = false;
-
+    context = NULL;
 }
 
 ComputeThread::~ComputeThread()
 {
+    delete context;
 }
 
 /**
@@ -64,6 +54,21 @@ void ComputeThread::setFuzzySystem(FuzzySystem *fSystemLeft, FuzzySystem *fSyste
     fuzzySystemLoaded = true;
 }
 
+/**
+  * Return a new fuzzy system with the parameters of the script, loaded with dataset.
+  */
+FuzzySystem *ComputeThread::newFuzzySystem(QList<QStringList> *dataset)
+{
+    FuzzySystem *fSystem = new FuzzySystem();
+    SystemParameters *sysParams = &SystemParameters::getInstance();
+    fSystem->setParameters(sysParams->getNbRules(), sysParams->getNbVarPerRule(), sysParams->getNbOutVars(),
+                      sysParams->getNbInSets(), sysParams->getNbOutSets(), sysParams->getInVarsCodeSize(),
+                      sysParams->getOutVarsCodeSize(), sysParams->getInSetsCodeSize(), sysParams->getOutSetsCodeSize(),
+                      sysParams->getInSetsPosCodeSize(), sysParams->getOutSetPosCodeSize());
+    fSystem->loadData(dataset);
+    return fSystem;
+}
+
 /**
   * Starts the thread.
   */
@@ -72,19 +77,34 @@ void ComputeThread::run()
     // Begin timer
     startTime = QTime::currentTime();
 
-    ComputeThread::stop = false;
     ComputeThread::bestFitness = 0.0;
     ComputeThread::bestFSystem = 0;
     ComputeThread::bestFuzzySystemDescription.clear();
-    // Define some usefull vars to speed up the build fuzzy process.
-    ComputeThread::nbRules = fSystemLeft->getNbRules();
-    ComputeThread::membersGenSize = fSystemLeft->getMembershipsBitStringSize();
-    ComputeThread::ruleGenSize = fSystemLeft->getRuleMaxBitStringSize();
-    ComputeThread::nbVarPerRule = fSystemLeft->getNbVarPerRule();
-    ComputeThread::inSetsCodeSize = fSystemLeft->getInSetsCodeSize();
-    ComputeThread::nbOutVars = fSystemLeft->getNbOutVars();
-    ComputeThread::outSetsCodeSize = fSystemLeft->getOutSetsCodeSize();
-    ComputeThread::sysParams = &SystemParameters::getInstance();
+
+    // The parameters are read once, the dialogs and the script may change them during the run
+    SystemParameters *sysParams = &SystemParameters::getInstance();
+    RunContext *runContext = new RunContext(*sysParams);
+    runContext->setStats(&CoevStats::getInstance());
+    fSystemLeft->setEvaluationParameters(runContext->getEvaluationParameters());
+    fSystemRight->setEvaluationParameters(runContext->getEvaluationParameters());
+    runContext->setGenomeLayout(fSystemLeft);
+    {
+        QMutexLocker locker(&contextLock);
+        delete context;
+        context = runContext;
+    }
+
+    // Evaluation pool, one worker per core unless the script asks otherwise. Worker
+    // processes are used instead of the pool while at least one of them answers.
+    context->startEvaluation(fSystemLeft, sysParams->getEvaluationThreads(), sysParams->getEvaluationWorkers());
+
+    // Held-out dataset the best systems are scored on while the run goes on
+    if (!sysParams->getValidationDataset().isEmpty())
+        context->startValidation(fSystemLeft, sysParams->getValidationDataset(), sysParams->getValidationPatience());
+
+    // Best system written to disk each time it improves, for the jobs using it before the end of the run
+    if (!sysParams->getBestExportFile().isEmpty())
+        context->startExport(fSystemLeft, sysParams->getBestExportFile(), sysParams->getBestExportInterval());
 
 
     qDebug() << "RUN : ComputeThread;";
@@ -100,46 +120,165 @@ void ComputeThread::run()
         qDebug() << coevRulesConfig;
         loadConfiguration(rules, coevRulesConfig);
 
-        ComputeThread::sysParams = &SystemParameters::getInstance();
-
         vars.genotypeSize = fSystemLeft->getMembershipsBitStringSize();
         rules.genotypeSize = ((fSystemLeft->getRuleBitStringSize())*fSystemLeft->getNbRules())+fSystemLeft->getDefaultRulesBitStringSize();
 
-        Population *popVar = new Population("MEMBERSHIPS", sysParams->getPopSizePop1(), vars.genotypeSize);
-        Population *popRules = new Population("RULES", sysParams->getPopSizePop2(), rules.genotypeSize);
+        // Island model, every island evolves its own pair of populations and exchanges
+        // migrants with the others. The first island uses the fuzzy systems of the GUI.
+        const int islandCount = qMax(1, sysParams->getIslandCount());
+        MigrationHub::Topology topology = MigrationHub::Ring;
+        if (!MigrationHub::topologyFromName(sysParams->getMigrationTopology(), &topology))
+            qCritical() << "Unknown migration topology" << sysParams->getMigrationTopology() << ", using the ring";
+        MigrationHub *migration = new MigrationHub(islandCount, 2, topology, sysParams->getMigrationInterval(), sysParams->getMigrationSize());
+
+        // A seeded run draws its initial populations from a stream derived from the seed
+        if (sysParams->getRandomSeed() >= 0)
+            RandomGenerator::getGeneratorInstance()->seed((quint64) sysParams->getRandomSeed() << 16);
+
+        QList<FuzzySystem*> islandSystems;
+        QList<Population*> populations;
+        QList<SpeciesScheduler*> schedulers;
+        QList<CoEvolution*> evolutions;
+        for (int i = 0; i < islandCount; i++) {
+            FuzzySystem *systemVar = fSystemLeft;
+            FuzzySystem *systemRules = fSystemRight;
+            if (i > 0) {
+                systemVar = fSystemLeft->createEvaluationCopy();
+                systemRules = fSystemRight->createEvaluationCopy();
+                islandSystems << systemVar << systemRules;
+            }
+
+            Population *popVar = new Population("MEMBERSHIPS", sysParams->getPopSizePop1(), vars.genotypeSize);
+            Population *popRules = new Population("RULES", sysParams->getPopSizePop2(), rules.genotypeSize);
+
+            // Species 0 evolves the memberships, species 1 the rules
+            SpeciesScheduler *scheduler = new SpeciesScheduler(2, sysParams->getStalenessBound());
 
-        QMutex *leftLock = new QMutex();
-        QMutex *rightLock = new QMutex();
+            CoEvolution *evoVar = new CoEvolution(context, systemVar, scheduler, 0, popVar, popRules, sysParams->getMaxGenPop1(),  sysParams->getCxProbPop1(),sysParams->getMutFlipIndPop1(), sysParams->getMutFlipBitPop1(),sysParams->getEliteSizePop1(), sysParams->getNbCooperators());
+            CoEvolution *evoRules = new CoEvolution(context, systemRules, scheduler, 1, popRules, popVar, sysParams->getMaxGenPop1(), sysParams->getCxProbPop2(), sysParams->getMutFlipIndPop2(), sysParams->getMutFlipBitPop2(),sysParams->getEliteSizePop1(), sysParams->getNbCooperators());
+            evoVar->setMigration(migration, i);
+            evoRules->setMigration(migration, i);
 
-        leftEvolution = new CoEvolution(fSystemLeft, leftLock, rightLock, popVar, popRules, sysParams->getMaxGenPop1(),  sysParams->getCxProbPop1(),sysParams->getMutFlipIndPop1(), sysParams->getMutFlipBitPop1(),sysParams->getEliteSizePop1(), sysParams->getNbCooperators());
-        rightEvolution = new CoEvolution(fSystemRight, rightLock, leftLock, popRules, popVar, sysParams->getMaxGenPop1(), sysParams->getCxProbPop2(), sysParams->getMutFlipIndPop2(), sysParams->getMutFlipBitPop2(),sysParams->getEliteSizePop1(), sysParams->getNbCooperators());
+            connect(evoVar,SIGNAL(fitnessThreshReached()), this, SLOT(onStopEvo()));
+            connect(evoRules,SIGNAL(fitnessThreshReached()), this, SLOT(onStopEvo()));
+
+            populations << popVar << popRules;
+            schedulers << scheduler;
+            evolutions << evoVar << evoRules;
+        }
+        leftEvolution = evolutions.at(0);
+        rightEvolution = evolutions.at(1);
+
+        // Resume from the checkpoint given on the command line, only the first run started
+        // afterwards does
+        if (!sysParams->getResumeFile().isEmpty()) {
+            SaveEngine::Checkpoint *checkpoint = SaveEngine::load(sysParams->getResumeFile());
+            bool valid = checkpoint != NULL && checkpoint->populations.size() == populations.size();
+            for (int i = 0; valid && i < populations.size(); i++)
+                valid = checkpoint->populations[i]->matches(populations[i]);
+            if (valid && context->restoreRunData(checkpoint->runData, checkpoint->generation, fSystemLeft)) {
+                for (int i = 0; i < evolutions.size(); i++)
+                    evolutions[i]->resume(*checkpoint->populations[i]);
+                qDebug() << "Resumed from " << sysParams->getResumeFile() << " at generation " << checkpoint->generation;
+            }
+            else {
+                qCritical() << "The checkpoint" << sysParams->getResumeFile() << "does not match the run, starting from scratch";
+            }
+            delete checkpoint;
+            sysParams->setResumeFile(QString());
+        }
 
-        connect(leftEvolution,SIGNAL(fitnessThreshReached()), this, SLOT(onStopEvo()));
-        connect(rightEvolution,SIGNAL(fitnessThreshReached()), this, SLOT(onStopEvo()));
+        // Generation logs, written by a thread of their own from the records of the evolvers
+        LogWriter *logWriter = NULL;
+        QList<Logger*> loggers;
+        Logger::LoggerLevel logLevel = Logger::NONE;
+        Logger::levelFromName(sysParams->getLogLevel(), &logLevel);
+        if (!sysParams->getLogPrefix().isEmpty() && logLevel != Logger::NONE) {
+            const bool binary = sysParams->getLogFormat() == "binary";
+            logWriter = new LogWriter(binary ? LogWriter::BINARY : LogWriter::CSV);
+            logWriter->start(QThread::LowPriority);
+            for (int i = 0; i < evolutions.size(); i++) {
+                QString name = sysParams->getLogPrefix() + "_" + populations[i]->getName().toLower();
+                if (islandCount > 1)
+                    name += "_" + QString::number(i / 2);
+                Logger *statistics = new StatisticLogger(evolutions[i], logWriter, name + (binary ? "_stats.bin" : "_stats.csv"), logLevel);
+                Logger *population = new PopulationLogger(evolutions[i], logWriter, name + (binary ? "_population.bin" : "_population.csv"), logLevel);
+                loggers << statistics << population;
+                // The level leaves out the statistics or the genotypes
+                if (statistics->isEnabled())
+                    evolutions[i]->addLogger(statistics);
+                if (population->isEnabled())
+                    evolutions[i]->addLogger(population);
+            }
+        }
+
+        // Genealogy archive, written by a thread of its own from the lineage of the evolvers
+        GenealogyArchive *genealogy = NULL;
+        if (!sysParams->getGenealogyFile().isEmpty()) {
+            genealogy = new GenealogyArchive(sysParams->getGenealogyFile(), sysParams->getRunIndex(), sysParams->getGenealogyKeyframes());
+            QList<int> indices;
+            for (int i = 0; i < evolutions.size(); i++) {
+                QString name = populations[i]->getName();
+                if (islandCount > 1)
+                    name += "_" + QString::number(i / 2);
+                indices << genealogy->addPopulation(name, populations[i]->getSize(), (i % 2 == 0 ? vars : rules).genotypeSize);
+            }
+            if (genealogy->open()) {
+                genealogy->start(QThread::LowPriority);
+                for (int i = 0; i < evolutions.size(); i++)
+                    evolutions[i]->setGenealogy(genealogy, indices[i]);
+            }
+        }
+
+        if (!sysParams->getCheckpointFile().isEmpty() && sysParams->getCheckpointInterval() > 0) {
+            context->startCheckpoints(sysParams->getCheckpointFile(), sysParams->getCheckpointInterval(), evolutions.size(), sysParams->getRunIndex());
+            for (int i = 0; i < evolutions.size(); i++)
+                evolutions[i]->setCheckpoints(context->getSaveEngine(), i);
+        }
 
         qDebug() << "END_GetInstance";
 
         // 3. start evolution
-        qDebug() << "Start Evolution";
-        leftEvolution->start();
-        rightEvolution->start();
+        qDebug() << "Start Evolution, islands : " << islandCount;
+        for (int i = 0; i < evolutions.size(); i++)
+            evolutions[i]->start();
 
         qDebug() << "Start waiting Evolution";
-        rightEvolution->wait();
-        leftEvolution->wait();
+        for (int i = evolutions.size() - 1; i >= 0; i--)
+            evolutions[i]->wait();
         qDebug() << "End waiting Evolution";
+        context->stopValidation();
+        context->stopExport();
+        context->stopCheckpoints();
+        delete logWriter;
+        qDeleteAll(loggers);
+        delete genealogy;
+
+        // The fuzzy system of the memberships evolver holds the last evaluated pair,
+        // rebuild the best one in it before handing it over.
+        BestSystemSnapshot *best = context->getBestSnapshot();
+        if (leftEvolution->loadBestSystem(best)) {
+            ComputeThread::bestFSystem = fSystemLeft;
+            ComputeThread::bestFitness = best->getFitness();
+            ComputeThread::bestFuzzySystemDescription = best->getDescription();
+            QString saveFileName = context->takePendingSave();
+            if (!saveFileName.isEmpty())
+                fSystemLeft->saveToFile(saveFileName, best->getFitness());
+        }
+        context->releaseSnapshots(true);
 
-//        if(bestFSystem != fSystemLeft && fSystemLeft != 0)
-//            delete fSystemLeft;
-//        else if(bestFSystem != fSystemRight && fSystemRight != 0)
-//            delete fSystemRight;
-
-        delete leftLock;
-        delete rightLock;
-        delete popVar;
-        delete popRules;
-        delete leftEvolution;
-        delete rightEvolution;
+        for (int i = 0; i < schedulers.size(); i++) {
+            QString island = islandCount > 1 ? QString("Island %1 ").arg(i) : QString();
+            reportWaitTimes(schedulers[i], 0, island + populations[2*i]->getName());
+            reportWaitTimes(schedulers[i], 1, island + populations[2*i+1]->getName());
+        }
+        qDeleteAll(evolutions);
+        qDeleteAll(schedulers);
+        qDeleteAll(populations);
+        qDeleteAll(islandSystems);
+        delete migration;
+        leftEvolution = 0;
+        rightEvolution = 0;
 
     }
 
@@ -148,20 +287,51 @@ void ComputeThread::run()
         std::cerr << inException.what() << std::endl << std::flush;
     }
 
+    context->stopEvaluation();
+
     // End Timer
     endTime = QTime::currentTime();
     elapsedTime = startTime.msecsTo(endTime);
     qDebug() << "ElapsedTime in seconds : " << elapsedTime / 1000 ;
+    FitnessCache &fitnessCache = context->getFitnessCache();
+    if (fitnessCache.isEnabled())
+        qDebug() << "Fitness cache : " << fitnessCache.getHits() << " hits, "
+                 << fitnessCache.getMisses() << " misses, hit rate "
+                 << fitnessCache.getHitRate();
 
     emit computeFinished();
 }
 
+/**
+  * Print the time a species spent waiting for the other one.
+  */
+void ComputeThread::reportWaitTimes(SpeciesScheduler *scheduler, int species, QString name)
+{
+    const QVector<int> &waitTimes = scheduler->getWaitTimes(species);
+    qint64 total = 0;
+    int longest = 0;
+    for (int i = 0; i < waitTimes.size(); i++) {
+        total += waitTimes[i];
+        longest = qMax(longest, waitTimes[i]);
+    }
+    qDebug() << name << " waited " << total << " ms over " << waitTimes.size() << " generations, mean "
+             << (waitTimes.isEmpty() ? 0.0 : (qreal) total / waitTimes.size()) << " ms, longest " << longest << " ms";
+}
+
 /**
   * Slot called when a request to save the system is performed
   */
 void ComputeThread::onSaveSystem(QString fileName)
 {
-    ComputeThread::bestFSystem->saveToFile(fileName, ComputeThread::bestFitness);
+    // The evolvers keep rebuilding their fuzzy systems, the save is deferred to the
+    // end of the current generation.
+    QMutexLocker locker(&contextLock);
+    if (isRunning() && context != NULL) {
+        context->requestSave(fileName);
+    }
+    else if (ComputeThread::bestFSystem != NULL) {
+        ComputeThread::bestFSystem->saveToFile(fileName, ComputeThread::bestFitness);
+    }
 }
 
 /**
@@ -220,69 +390,7 @@ void ComputeThread::onStopEvo()
 {
 //    leftCoevEvalOperator->terminate();
 //    rightCoevEvalOperator->terminate();
-    ComputeThread::stop = true;
-}
-
-void ComputeThread::saveFuzzyAndFitness(FuzzySystem *fSystem, qreal fitness){
-    QMutexLocker locker(&mutex2);
-    if(fitness >= ComputeThread::bestFitness){
-        ComputeThread::bestFitness = fitness;
-        ComputeThread::bestFSystem = fSystem;
-        ComputeThread::bestFuzzySystemDescription.clear();
-        ComputeThread::bestFuzzySystemDescription.append(ComputeThread::bestFSystem->getSystemDescritpion());
-
-        CoevStats& fitStats = CoevStats::getInstance();
-        fitStats.setSensi(ComputeThread::bestFSystem->getSensitivity());
-        fitStats.setSpeci(ComputeThread::bestFSystem->getSpecificity());
-        fitStats.setAccu(ComputeThread::bestFSystem->getAccuracy());
-        fitStats.setPpv(ComputeThread::bestFSystem->getPpv());
-        fitStats.setRmse(ComputeThread::bestFSystem->getRmse());
-        fitStats.setRrse(ComputeThread::bestFSystem->getRrse());
-        fitStats.setRae(ComputeThread::bestFSystem->getRae());
-        fitStats.setMse(ComputeThread::bestFSystem->getMse());
-        fitStats.setDistanceThreshold(ComputeThread::bestFSystem->getDistanceThreshold());
-        fitStats.setDistanceMinThreshold(ComputeThread::bestFSystem->getDistanceMinThreshold());
-        fitStats.setDontCare(ComputeThread::bestFSystem->getDontCare());
-        fitStats.setOverLearn(ComputeThread::bestFSystem->getOverLearn());
-        fitStats.setFitMaxPop1(ComputeThread::bestFitness);
-        fitStats.setBestSysDesc(ComputeThread::bestFuzzySystemDescription);
-// Haven't found code that use this.
-//        if (fitness > coevStats.getFitMaxPop1()) {
-//            QString fileName;
-//            // Ensure that a temp directory exists. If not we create one.
-//            QDir tempDir;
-//            if (!tempDir.exists(sysParams->getSavePath()+"temp")) {
-//                tempDir.mkdir(sysParams->getSavePath()+"temp");
-//            }
-//            fileName = QString(sysParams->getSavePath()+"temp/currentBest_") + QString::number(getpid()) + QString(".ffs");
-//            ComputeThread::bestFSystem->saveToFile(fileName, fitness);
-
-//        }
-    }
-}
-
-void ComputeThread::saveSystemStats(QString name, qreal minFitness, qreal maxFitness, qreal meanFitness, qreal standardDeviation, int populationSize, int generation){
-    QMutexLocker locker(&mutex);
-    //TODO CHANGE THE VALUES AND ADD CORRECT PARAMS
-    CoevStats& fitStats = CoevStats::getInstance();
-
-    if(name == "RULES"){
-        fitStats.setFitMaxPop2(maxFitness);
-        fitStats.setFitAvgPop2(meanFitness);
-        fitStats.setFitMinPop2(minFitness);
-        fitStats.setFitStdPop2(standardDeviation);
-        fitStats.setSizePop2(populationSize);
-
-    }else{
-        fitStats.setFitMaxPop1(maxFitness);
-        fitStats.setFitAvgPop1(meanFitness);
-        fitStats.setFitMinPop1(minFitness);
-        fitStats.setFitStdPop1(standardDeviation);
-        fitStats.setSizePop1(populationSize);
-    }
-    fitStats.setGenNumber(generation);
-    // Send Data to graph.
-    fitStats.transmitData(name);
-
-
+    QMutexLocker locker(&contextLock);
+    if (context != NULL)
+        context->requestStop();
 }
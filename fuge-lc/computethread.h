@@ -43,6 +43,12 @@
 #include "fuzzysystem.h"
 #include "systemparameters.h"
 #include "evolutionengine.h"
+#include "migrationhub.h"
+#include "runcontext.h"
+#include "logwriter.h"
+#include "populationlogger.h"
+#include "statisticlogger.h"
+#include "genealogyarchive.h"
 
 class CoEvolution;
 
@@ -54,30 +60,22 @@ public:
     ComputeThread();
     virtual ~ComputeThread();
     void setFuzzySystem(FuzzySystem *fSystemLeft, FuzzySystem *fSystemRight);
+    static FuzzySystem *newFuzzySystem(QList<QStringList> *dataset);
 
-    // Performance variable. Available as static for Coevolution.
-    static int nbRules;
-    static int membersGenSize;
-    static int ruleGenSize;
-    static int nbVarPerRule;
-    static int inSetsCodeSize;
-    static int nbOutVars;
-    static int outSetsCodeSize;
+    // Result of the last run, for the GUI
     static FuzzySystem* bestFSystem;
     static QString bestFuzzySystemDescription;
     static qreal bestFitness;
-    static void saveFuzzyAndFitness(FuzzySystem *fSystem, qreal fitness);
-    static void saveSystemStats(QString name, qreal minFitness, qreal maxFitness, qreal meanFitness, qreal standardDeviation, int populationSize, int generation);
-    static SystemParameters *sysParams;
-    static bool stop;
 protected:
     void run();
-    static QMutex mutex;
-    static QMutex mutex2;
 
 private:
     FuzzySystem* fSystemLeft;
     FuzzySystem* fSystemRight;
+    // Context of the current or last run, the fuzzy systems are evaluated with its parameters
+    RunContext *context;
+    // Protects the context while it is replaced by a new run
+    QMutex contextLock;
 
     QList<QStringList>* listFile;
     int counter;
@@ -97,6 +95,7 @@ private:
     qreal elapsedTime;
 
     void loadConfiguration(POPULATION_CONFIG_TYPE &config, QString fileNameWithDirPath);
+    void reportWaitTimes(SpeciesScheduler *scheduler, int species, QString name);
 
 signals:
     void computeFinished();
@@ -0,0 +1,33 @@
+# Included by the applications linked to the core library
+
+QT += xml network
+
+INCLUDEPATH += $$PWD/.. \
+    $$PWD/../coev \
+    $$PWD/../fuzzy \
+    $$PWD/../Dependencies/duktape \
+    $$PWD/../libGGA \
+    $$PWD/../libGGA/EvolutionEngine \
+    $$PWD/../libGGA/EvolutionEngine/ReproductionMethod \
+    $$PWD/../libGGA/EvolutionEngine/ReproductionMethod/Crossover \
+    $$PWD/../libGGA/EvolutionEngine/ReproductionMethod/Mutation \
+    $$PWD/../libGGA/EvolutionEngine/SelectionMethod \
+    $$PWD/../libGGA/Logger \
+    $$PWD/../libGGA/Population \
+    $$PWD/../libGGA/Population/Individual \
+    $$PWD/../libGGA/Population/Individual/Genotype \
+    $$PWD/../libGGA/SaveEngine \
+    $$PWD/../libGGA/StatisticEngine \
+    $$PWD/../libGGA/StatisticEngine/EvolutionaryMesure \
+    $$PWD/../libGGA/StatisticEngine/EvolutionaryMesure/PopulationDiversity \
+    $$PWD/../libGGA/Utility
+DEPENDPATH += $$INCLUDEPATH
+
+win32:CONFIG(release, debug|release): FUGE_CORE_DIR = $$OUT_PWD/../core/release
+else:win32:CONFIG(debug, debug|release): FUGE_CORE_DIR = $$OUT_PWD/../core/debug
+else: FUGE_CORE_DIR = $$OUT_PWD/../core
+
+LIBS += -L$$FUGE_CORE_DIR -lfuge-core
+
+win32:!win32-g++: PRE_TARGETDEPS += $$FUGE_CORE_DIR/fuge-core.lib
+else: PRE_TARGETDEPS += $$FUGE_CORE_DIR/libfuge-core.a
@@ -0,0 +1,30 @@
+# Everything FUGE-LC and fuge-cli share, without any widget
+
+TARGET = fuge-core
+TEMPLATE = lib
+CONFIG += staticlib
+
+QT = core xml network
+
+INCLUDEPATH += $$PWD/..
+
+include(../libGGA/libGGA.pri)
+include(../fuzzy/Fuzzy.pri)
+include(../coev/Coev.pri)
+include(../Dependencies/duktape/duktape.pri)
+
+SOURCES += ../batchrunner.cpp \
+    ../commandline.cpp \
+    ../computethread.cpp \
+    ../predictionclient.cpp \
+    ../predictionserver.cpp \
+    ../scriptmanager.cpp \
+    ../systemparameters.cpp
+
+HEADERS += ../batchrunner.h \
+    ../commandline.h \
+    ../computethread.h \
+    ../predictionclient.h \
+    ../predictionserver.h \
+    ../scriptmanager.h \
+    ../systemparameters.h
@@ -28,7 +28,6 @@
 
 
 QFile *fitLogFile;
-QSemaphore scriptSema(0);
 bool doRunFromCmd = false;
 QList<QStringList>* FugeMain::listFile = 0;
 
@@ -61,16 +60,15 @@ FugeMain::FugeMain(QWidget *parent)
     help = new HelpDialog();
     aboutDial = new AboutDialog();
     statsPlot = new StatsPlot();
-    CoevStats& fitStats = CoevStats::getInstance();
     sMan = new ScriptManager();
     // TODO: Rename the signal and slots to have the same name and get ride of those connect declarations.
     // Clicked should be linked to OnClicked etc. (See Qt documentation for more information).
     connect(sMan, SIGNAL(startRun()), this, SLOT(onActRun()));
     connect(sMan, SIGNAL(scriptFinished()), this, SLOT(onScriptFinished()));
+    connect(sMan, SIGNAL(scriptError(QString,QString)), this, SLOT(onScriptError(QString,QString)));
     computeThread = new ComputeThread();
     connect(computeThread, SIGNAL(computeFinished()), this, SLOT(onComputeFinished()));
     connect(ui->btStop, SIGNAL(clicked()), computeThread, SLOT(onStopEvo()));
-    connect(&fitStats, SIGNAL(transmit(QString)), statsPlot, SLOT(receiveData(QString)), Qt::BlockingQueuedConnection);
     connect(this, SIGNAL(clearStats()), statsPlot, SLOT(onClearStats()));
     //connect(this, SIGNAL(closeStats()), statsPlot, SLOT(onCloseStats()));
     connect(ui->btGraph, SIGNAL(clicked()), statsPlot, SLOT(onShowGraph()));
@@ -338,22 +336,6 @@ void FugeMain::setDefaultSysParams()
     sysParams.setMutFlipBitPop2(0.025);
 }
 
-/**
- * @brief FugeMain::getNewFuzzySystem Returns a new fuzzy system fully loaded.
- * @param listFile
- * @return a new loaded SystemFuzzy
- */
-FuzzySystem* FugeMain::getNewFuzzySystem(QList<QStringList>* listFile){
-    FuzzySystem *fSystem = new FuzzySystem();
-    ComputeThread::sysParams = &SystemParameters::getInstance();
-    fSystem->setParameters(ComputeThread::sysParams->getNbRules(), ComputeThread::sysParams->getNbVarPerRule(), ComputeThread::sysParams->getNbOutVars(),
-                      ComputeThread::sysParams->getNbInSets(), ComputeThread::sysParams->getNbOutSets(), ComputeThread::sysParams->getInVarsCodeSize(),
-                      ComputeThread::sysParams->getOutVarsCodeSize(), ComputeThread::sysParams->getInSetsCodeSize(), ComputeThread::sysParams->getOutSetsCodeSize(),
-                      ComputeThread::sysParams->getInSetsPosCodeSize(), ComputeThread::sysParams->getOutSetPosCodeSize());
-    fSystem->loadData(listFile);
-    return fSystem;
-}
-
 /**
   * Method called when a run needs to be performed. It sets the interface to the required
   * sate and runs the computation thread.
@@ -371,8 +353,8 @@ void FugeMain::onActRun()
     ui->btRun->setEnabled(false);
     if ((dataLoaded && scriptLoaded) || (dataLoaded && paramsLoaded)) {
 
-        fSystemVars = getNewFuzzySystem(listFile);
-        fSystemRules = getNewFuzzySystem(listFile);
+        fSystemVars = ComputeThread::newFuzzySystem(listFile);
+        fSystemRules = ComputeThread::newFuzzySystem(listFile);
         // At least attribute it a pointer.
         ComputeThread::bestFSystem = fSystemVars;
         ComputeThread::bestFitness = 0;
@@ -1085,6 +1067,14 @@ void FugeMain::onScriptFinished()
         this->close();
 }
 
+/**
+  * Slot called by the script manager when the script cannot be read or run.
+  */
+void FugeMain::onScriptError(QString title, QString message)
+{
+    QMessageBox::critical(this, title, message);
+}
+
 /**
   * Slot called when the user accesses the Help dialog.
   */
@@ -87,7 +87,6 @@ public:
     void runFromCmdLine(QString dataSet, QString scriptFile, QString fuzzyFile,
                         bool eval, bool predict, bool verbose);
     static QList<QStringList>* listFile;
-    static FuzzySystem* getNewFuzzySystem(QList<QStringList>* listFile);
 
 protected:
     virtual void changeEvent(QEvent *e);
@@ -143,6 +142,7 @@ private:
 public slots:
     void onComputeFinished();
     void onScriptFinished();
+    void onScriptError(QString title, QString message);
 
 private slots:
     void onActRun();
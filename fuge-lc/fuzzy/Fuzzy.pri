@@ -13,7 +13,10 @@ SOURCES += $$PWD/fuzzyvariable.cpp \
     $$PWD/defuzzmethodcoa.cpp \
     $$PWD/fuzzysystem.cpp \
     $$PWD/fuzzymembershipsgenome.cpp \
-    $$PWD/defuzzmethodsingleton.cpp
+    $$PWD/defuzzmethodsingleton.cpp \
+    $$PWD/evaluationparameters.cpp \
+    $$PWD/numericdataset.cpp \
+    $$PWD/csourceexporter.cpp
 
 HEADERS += $$PWD/fuzzyvariable.h \
     $$PWD/fuzzyset.h \
@@ -27,6 +30,9 @@ HEADERS += $$PWD/fuzzyvariable.h \
     $$PWD/defuzzmethodcoa.h \
     $$PWD/fuzzysystem.h \
     $$PWD/fuzzymembershipsgenome.h \
-    $$PWD/defuzzmethodsingleton.h
+    $$PWD/defuzzmethodsingleton.h \
+    $$PWD/evaluationparameters.h \
+    $$PWD/numericdataset.h \
+    $$PWD/csourceexporter.h
 
 
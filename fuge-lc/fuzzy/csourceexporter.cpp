@@ -0,0 +1,392 @@
+/**
+  * @file   csourceexporter.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  *
+  * @class CSourceExporter
+  * @brief Writes the inference of a fuzzy system as C99 source without any dependency.
+  */
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDebug>
+
+#include "csourceexporter.h"
+#include "fuzzysystem.h"
+
+const float CSourceExporter::TOLERANCE = 1e-5f;
+
+/**
+  * Constructor.
+  *
+  * @param fSystem Fuzzy system to export, loaded from a file
+  * @param systemName Name written in the comments of the source
+  */
+CSourceExporter::CSourceExporter(FuzzySystem *fSystem, const QString &systemName) :
+    fSystem(fSystem), systemName(systemName), dataset(NULL)
+{
+}
+
+/**
+  * Write the samples of a dataset and the outputs the system computed for them in the
+  * source, for its self test.
+  *
+  * @param dataset Dataset, the first row holds the names of the columns
+  * @param outputs Defuzzified outputs of the samples, as returned by doEvaluateFitness()
+  */
+void CSourceExporter::setTestSamples(const QList<QStringList> *dataset, const QVector<float> &outputs)
+{
+    this->dataset = dataset;
+    this->outputs = outputs;
+}
+
+/**
+  * Write the source and its header, named as the source with the extension .h.
+  *
+  * @return false if a file cannot be written
+  */
+bool CSourceExporter::write(const QString &fileName)
+{
+    const QFileInfo info(fileName);
+    // The functions are named after the file, as a C identifier
+    prefix = info.completeBaseName();
+    for (int i = 0; i < prefix.size(); i++) {
+        if (!prefix.at(i).isLetterOrNumber() || prefix.at(i).unicode() > 127)
+            prefix[i] = QChar('_');
+    }
+    if (prefix.isEmpty() || prefix.at(0).isDigit())
+        prefix.prepend("fuge_");
+    headerName = info.completeBaseName() + ".h";
+
+    QFile header(info.dir().filePath(headerName));
+    if (!header.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qCritical() << "Cannot write the C header" << header.fileName();
+        return false;
+    }
+    QTextStream headerStream(&header);
+    writeHeader(headerStream);
+    headerStream.flush();
+    header.close();
+
+    QFile source(fileName);
+    if (!source.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qCritical() << "Cannot write the C source" << fileName;
+        return false;
+    }
+    QTextStream sourceStream(&source);
+    writeSource(sourceStream);
+    sourceStream.flush();
+    source.close();
+    return true;
+}
+
+/**
+  * Return a value written so that the C compiler reads it back exactly.
+  */
+QString CSourceExporter::number(double value)
+{
+    QString text = QString::number(value, 'g', 17);
+    if (!text.contains('.') && !text.contains('e') && !text.contains("inf") && !text.contains("nan"))
+        text.append(".0");
+    return text;
+}
+
+/**
+  * Return a text which can be put in a C comment.
+  */
+QString CSourceExporter::comment(const QString &text)
+{
+    QString safe = text.simplified();
+    safe.replace("*/", "* /");
+    return safe;
+}
+
+void CSourceExporter::writeHeader(QTextStream &out)
+{
+    const QString guard = prefix.toUpper() + "_H";
+    const int nbInVars = fSystem->getNbInVars();
+    const int nbOutVars = fSystem->getNbOutVars();
+
+    out << "/*\n";
+    out << " * Inference of the fuzzy system " << comment(systemName) << ", generated by FUGE-LC.\n";
+    out << " *\n";
+    out << " * Inputs, in this order :";
+    for (int i = 0; i < nbInVars; i++)
+        out << " " << comment(fSystem->getInVar(i)->getName());
+    out << "\n * Outputs, in this order :";
+    for (int i = 0; i < nbOutVars; i++)
+        out << " " << comment(fSystem->getOutVar(i)->getName());
+    out << "\n */\n\n";
+    out << "#ifndef " << guard << "\n";
+    out << "#define " << guard << "\n\n";
+    out << "#include <stddef.h>\n\n";
+    out << "#define " << prefix.toUpper() << "_IN_COUNT " << nbInVars << "\n";
+    out << "#define " << prefix.toUpper() << "_OUT_COUNT " << nbOutVars << "\n\n";
+    out << "#ifdef __cplusplus\n";
+    out << "extern \"C\" {\n";
+    out << "#endif\n\n";
+    out << "/* Defuzzified outputs of one sample, a missing input is NAN. */\n";
+    out << "void " << prefix << "_predict(const float *inputs, float *outputs);\n\n";
+    out << "/* Outputs of count samples, stored one after the other. */\n";
+    out << "void " << prefix << "_predict_batch(const float *inputs, float *outputs, size_t count);\n\n";
+    out << "/* Threshold of an output, as applied by the predictions of FUGE-LC. */\n";
+    out << "float " << prefix << "_threshold(int output, float value);\n\n";
+    out << "#ifdef __cplusplus\n";
+    out << "}\n";
+    out << "#endif\n\n";
+    out << "#endif /* " << guard << " */\n";
+}
+
+void CSourceExporter::writeSource(QTextStream &out)
+{
+    out << "/*\n";
+    out << " * Inference of the fuzzy system " << comment(systemName) << ", generated by FUGE-LC.\n";
+    out << " *\n";
+    out << " * The memberships, the rules and the default rules of the system are written as\n";
+    out << " * constants, modify the system and export it again rather than editing this file.\n";
+    out << " */\n\n";
+    out << "#include <math.h>\n\n";
+    out << "#include \"" << headerName << "\"\n\n";
+
+    // FuzzyMembershipsCoco::evaluateSet(), the set being known at compile time
+    out << "/* Membership of a set to x, before and after are the positions of its neighbours. */\n";
+    out << "static inline double " << prefix << "_membership(double x, double before, double position, double after, int first, int last)\n";
+    out << "{\n";
+    out << "    if (x == position)\n";
+    out << "        return 1.0;\n";
+    out << "    if (last || (!first && x < position)) {\n";
+    out << "        if (x > position)\n";
+    out << "            return 1.0;\n";
+    out << "        if (x <= before)\n";
+    out << "            return 0.0;\n";
+    out << "        return (x - before) / (position - before);\n";
+    out << "    }\n";
+    out << "    if (x < position)\n";
+    out << "        return 1.0;\n";
+    out << "    if (x >= after)\n";
+    out << "        return 0.0;\n";
+    out << "    return 1.0 - ((x - position) / (after - position));\n";
+    out << "}\n\n";
+
+    writePredict(out);
+
+    out << "void " << prefix << "_predict_batch(const float *inputs, float *outputs, size_t count)\n";
+    out << "{\n";
+    out << "    size_t i;\n";
+    out << "    for (i = 0; i < count; i++)\n";
+    out << "        " << prefix << "_predict(inputs + i*" << prefix.toUpper() << "_IN_COUNT, outputs + i*"
+        << prefix.toUpper() << "_OUT_COUNT);\n";
+    out << "}\n\n";
+
+    // EvaluationParameters::threshold()
+    const EvaluationParameters *params = fSystem->getEvaluationParameters();
+    out << "float " << prefix << "_threshold(int output, float value)\n";
+    out << "{\n";
+    if (params->threshActivated) {
+        out << "    static const float thresholds[" << prefix.toUpper() << "_OUT_COUNT] = {";
+        for (int i = 0; i < fSystem->getNbOutVars(); i++)
+            out << (i > 0 ? ", " : "") << number(params->getThresholdVal(i)) << "f";
+        out << "};\n";
+        out << "    if (value >= thresholds[output])\n";
+        out << "        return 1.0f;\n";
+        out << "    if (value >= 0.0f)\n";
+        out << "        return 0.0f;\n";
+        out << "    return -1.0f;\n";
+    }
+    else {
+        out << "    (void) output;\n";
+        out << "    return value;\n";
+    }
+    out << "}\n";
+
+    if (dataset != NULL)
+        writeSelfTest(out);
+}
+
+/**
+  * Write the function computing one sample, FuzzySystem::evaluateSample() unrolled.
+  */
+void CSourceExporter::writePredict(QTextStream &out)
+{
+    const int nbInVars = fSystem->getNbInVars();
+    const int nbOutVars = fSystem->getNbOutVars();
+    const int nbRules = fSystem->getNbRules();
+    const QVector<int> defaultRules = fSystem->getDefaultRules();
+
+    // The sets of the inputs used by the rules, their membership is computed once
+    QVector<QVector<bool> > used(nbInVars);
+    for (int i = 0; i < nbInVars; i++)
+        used[i].fill(false, fSystem->getInVar(i)->getSetsCount());
+    for (int r = 0; r < nbRules; r++) {
+        FuzzyRule *rule = fSystem->getRule(r);
+        for (int k = 0; rule != NULL && k < rule->getNbInPairs(); k++) {
+            for (int i = 0; i < nbInVars; i++) {
+                FuzzyVariable *var = fSystem->getInVar(i);
+                for (int s = 0; var == rule->getInVarAtPos(k) && s < var->getSetsCount(); s++) {
+                    if (var->getSet(s) == rule->getInSetAtPos(k))
+                        used[i][s] = true;
+                }
+            }
+        }
+    }
+
+    out << "void " << prefix << "_predict(const float *inputs, float *outputs)\n";
+    out << "{\n";
+    for (int o = 0; o < nbOutVars; o++)
+        out << "    double out" << o << "[" << fSystem->getOutVar(o)->getSetsCount() << "] = {0.0};\n";
+    out << "    float maxFired[" << nbOutVars << "] = {0.0f};\n";
+    out << "    double fire, sum, product;\n\n";
+
+    // A missing input does not take part in the rules, as a membership above 1
+    out << "    /* Memberships of the sets used by the rules, 999 for a missing input */\n";
+    for (int i = 0; i < nbInVars; i++) {
+        FuzzyVariable *var = fSystem->getInVar(i);
+        const int last = var->getSetsCount() - 1;
+        for (int s = 0; s <= last; s++) {
+            if (!used[i][s])
+                continue;
+            out << "    const double mf" << i << "_" << s << " = isnan(inputs[" << i << "]) ? 999.0 : ";
+            if (last == 0) {
+                out << "1.0;\n";
+                continue;
+            }
+            const double before = s > 0 ? var->getSet(s-1)->getPosition() : var->getSet(s)->getPosition();
+            const double after = s < last ? var->getSet(s+1)->getPosition() : var->getSet(s)->getPosition();
+            out << prefix << "_membership(inputs[" << i << "], " << number(before) << ", "
+                << number(var->getSet(s)->getPosition()) << ", " << number(after) << ", "
+                << (s == 0 ? 1 : 0) << ", " << (s == last ? 1 : 0) << ");\n";
+        }
+    }
+
+    for (int r = 0; r < nbRules; r++) {
+        FuzzyRule *rule = fSystem->getRule(r);
+        if (rule == NULL)
+            continue;
+        out << "\n    /* Rule " << r << " :" << comment(rule->getDescription()) << " */\n";
+        out << "    fire = 999.0;\n";
+        for (int k = 0; k < rule->getNbInPairs(); k++) {
+            for (int i = 0; i < nbInVars; i++) {
+                FuzzyVariable *var = fSystem->getInVar(i);
+                for (int s = 0; var == rule->getInVarAtPos(k) && s < var->getSetsCount(); s++) {
+                    if (var->getSet(s) == rule->getInSetAtPos(k))
+                        out << "    if (mf" << i << "_" << s << " < fire) fire = mf" << i << "_" << s << ";\n";
+                }
+            }
+        }
+        // Without any input the rule is dropped
+        out << "    if (fire > 1.0) fire = 0.0;\n";
+
+        const QList<int> *usedOutVars = rule->getUsedOutVars();
+        for (int k = 0; k < usedOutVars->size() && k < rule->getNbOutPairs(); k++) {
+            const int o = usedOutVars->at(k);
+            FuzzyVariable *var = rule->getOutVarAtPos(k);
+            bool isSet = false;
+            for (int s = 0; s < var->getSetsCount(); s++) {
+                if (var->getSet(s) == rule->getOutSetAtPos(k)) {
+                    out << "    out" << o << "[" << s << "] += fire;\n";
+                    isSet = true;
+                }
+            }
+            // As FuzzySystem::evaluateSample(), the float fire level is compared with the
+            // level of output k, an output set which does not exist does not fire
+            if (isSet && k < nbOutVars)
+                out << "    if ((float) fire > maxFired[" << k << "]) maxFired[" << o << "] = (float) fire;\n";
+        }
+    }
+
+    out << "\n    /* Default rules and singleton defuzzification */\n";
+    for (int o = 0; o < nbOutVars; o++) {
+        FuzzyVariable *var = fSystem->getOutVar(o);
+        if (defaultRules.at(o) >= 0 && defaultRules.at(o) < var->getSetsCount())
+            out << "    out" << o << "[" << defaultRules.at(o) << "] += 1.0 - maxFired[" << o << "];\n";
+        out << "    sum = 0.0;\n";
+        out << "    product = 0.0;\n";
+        for (int s = 0; s < var->getSetsCount(); s++) {
+            out << "    sum += out" << o << "[" << s << "];\n";
+            out << "    product += out" << o << "[" << s << "] * " << number(var->getSet(s)->getPosition()) << ";\n";
+        }
+        out << "    outputs[" << o << "] = sum == 0.0 ? 0.0f : (float) (product / sum);\n";
+    }
+    out << "}\n\n";
+}
+
+/**
+  * Write the samples of the dataset, the outputs of the system and a main() comparing
+  * them with the ones of the generated code.
+  */
+void CSourceExporter::writeSelfTest(QTextStream &out)
+{
+    const int nbInVars = fSystem->getNbInVars();
+    const int nbOutVars = fSystem->getNbOutVars();
+    const int count = qMin(dataset->size() - 1, outputs.size() / qMax(nbOutVars, 1));
+    const QString macro = prefix.toUpper();
+
+    QVector<int> columns(nbInVars);
+    for (int i = 0; i < nbInVars; i++)
+        columns[i] = dataset->at(0).indexOf(fSystem->getInVar(i)->getName());
+
+    out << "\n#ifdef " << macro << "_SELF_TEST\n\n";
+    out << "#include <stdio.h>\n\n";
+    out << "#define " << macro << "_TEST_COUNT " << count << "\n\n";
+    out << "/* Samples of the dataset and the outputs FUGE-LC computed for them */\n";
+    out << "static const float test_inputs[" << macro << "_TEST_COUNT*" << macro << "_IN_COUNT + 1] = {\n";
+    for (int k = 0; k < count; k++) {
+        out << "   ";
+        for (int i = 0; i < nbInVars; i++) {
+            bool isOk = false;
+            const float value = dataset->at(k+1).value(columns[i]).toFloat(&isOk);
+            out << " " << (isOk ? number(value) + "f" : QString("NAN")) << ",";
+        }
+        out << "\n";
+    }
+    out << "    0.0f\n};\n";
+    out << "static const float test_outputs[" << macro << "_TEST_COUNT*" << macro << "_OUT_COUNT + 1] = {\n";
+    for (int k = 0; k < count; k++) {
+        out << "   ";
+        for (int o = 0; o < nbOutVars; o++)
+            out << " " << number(outputs.at(k*nbOutVars + o)) << "f,";
+        out << "\n";
+    }
+    out << "    0.0f\n};\n\n";
+
+    out << "int main(void)\n";
+    out << "{\n";
+    out << "    static float computed[" << macro << "_TEST_COUNT*" << macro << "_OUT_COUNT + 1];\n";
+    out << "    double maxError = 0.0;\n";
+    out << "    int i, failed = 0;\n\n";
+    out << "    " << prefix << "_predict_batch(test_inputs, computed, " << macro << "_TEST_COUNT);\n";
+    out << "    for (i = 0; i < " << macro << "_TEST_COUNT*" << macro << "_OUT_COUNT; i++) {\n";
+    out << "        const double scale = fabs(test_outputs[i]) > 1.0 ? fabs(test_outputs[i]) : 1.0;\n";
+    out << "        const double error = fabs(computed[i] - test_outputs[i]) / scale;\n";
+    out << "        if (error > maxError)\n";
+    out << "            maxError = error;\n";
+    out << "        if (error > " << QString::number(TOLERANCE) << ") {\n";
+    out << "            printf(\"sample %d, output %d : %.9g instead of %.9g\\n\", i / " << macro << "_OUT_COUNT, i % "
+        << macro << "_OUT_COUNT, computed[i], test_outputs[i]);\n";
+    out << "            failed = 1;\n";
+    out << "        }\n";
+    out << "    }\n";
+    out << "    printf(\"%d samples, largest error %g\\n\", " << macro << "_TEST_COUNT, maxError);\n";
+    out << "    return failed;\n";
+    out << "}\n\n";
+    out << "#endif /* " << macro << "_SELF_TEST */\n";
+}
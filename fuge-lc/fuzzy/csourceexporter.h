@@ -0,0 +1,77 @@
+/**
+  * @file   csourceexporter.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  *
+  * @class CSourceExporter
+  * @brief Writes the inference of a fuzzy system as C99 source without any dependency.
+  *
+  * The positions of the sets, the rules, the default rules and the thresholds are written
+  * as constants in a function computing the outputs of one sample, plus a function looping
+  * over an array of samples. The function does what FuzzySystem does for a sample, in the
+  * same order, so that its outputs only differ by the rounding the C compiler chooses. A
+  * header declaring the functions is written next to the source, the functions are named
+  * after the source file. The samples of a dataset can be written in the source with the
+  * outputs of the system, a main() compiled with -D<NAME>_SELF_TEST then checks that the
+  * generated code computes the same outputs.
+  */
+
+#ifndef CSOURCEEXPORTER_H
+#define CSOURCEEXPORTER_H
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QVector>
+
+class FuzzySystem;
+
+class CSourceExporter
+{
+public:
+    // Largest difference between an output of the generated code and the one of the system,
+    // relative to outputs larger than 1
+    static const float TOLERANCE;
+
+    CSourceExporter(FuzzySystem *fSystem, const QString &systemName);
+
+    void setTestSamples(const QList<QStringList> *dataset, const QVector<float> &outputs);
+    bool write(const QString &fileName);
+
+private:
+    void writeHeader(QTextStream &out);
+    void writeSource(QTextStream &out);
+    void writePredict(QTextStream &out);
+    void writeSelfTest(QTextStream &out);
+    static QString number(double value);
+    static QString comment(const QString &text);
+
+    FuzzySystem *fSystem;
+    QString systemName;
+    // Name of the functions and, in upper case, of the macros
+    QString prefix;
+    QString headerName;
+    const QList<QStringList> *dataset;
+    QVector<float> outputs;
+};
+
+#endif // CSOURCEEXPORTER_H
@@ -0,0 +1,95 @@
+/**
+  * @file   evaluationparameters.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class EvaluationParameters
+  * @brief Fitness weights, thresholds and genome options a fuzzy system is evaluated with.
+  */
+
+#include "evaluationparameters.h"
+#include "systemparameters.h"
+
+/**
+  * Constructor. All the weights are null, the thresholds are not activated.
+  */
+EvaluationParameters::EvaluationParameters() :
+    fixedVars(false), threshActivated(false), sensiW(0.0), speciW(0.0), accuracyW(0.0), ppvW(0.0),
+    rmseW(0.0), rrseW(0.0), raeW(0.0), mseW(0.0), dontCareW(0.0), distanceThresholdW(0.0),
+    distanceMinThresholdW(0.0), overLearnW(0.0)
+{
+}
+
+/**
+  * Constructor. Copy the current values of the system parameters.
+  */
+EvaluationParameters::EvaluationParameters(SystemParameters &sysParams)
+{
+    load(sysParams);
+}
+
+/**
+  * Copy the current values of the system parameters.
+  *
+  * @param sysParams System parameters
+  */
+void EvaluationParameters::load(SystemParameters &sysParams)
+{
+    fixedVars = sysParams.getFixedVars();
+    threshActivated = sysParams.getThreshActivated();
+    thresholds.resize(sysParams.getNbOutVars());
+    for (int i = 0; i < thresholds.size(); i++)
+        thresholds[i] = sysParams.getThresholdVal(i);
+    sensiW = sysParams.getSensiW();
+    speciW = sysParams.getSpeciW();
+    accuracyW = sysParams.getAccuracyW();
+    ppvW = sysParams.getPpvW();
+    rmseW = sysParams.getRmseW();
+    rrseW = sysParams.getRrseW();
+    raeW = sysParams.getRaeW();
+    mseW = sysParams.getMseW();
+    dontCareW = sysParams.getDontCareW();
+    distanceThresholdW = sysParams.getDistanceThresholdW();
+    distanceMinThresholdW = sysParams.getDistanceMinThresholdW();
+    overLearnW = sysParams.getOverLearnW();
+    datasetName = sysParams.getDatasetName();
+}
+
+/**
+  * Apply the threshold of an output variable to a defuzzified value.
+  *
+  * @param outVar Output variable number
+  * @param value Defuzzified value
+  * @return 1 above the threshold, 0 below and -1 for negative values. The value itself
+  * if the thresholds are not activated.
+  */
+float EvaluationParameters::threshold(int outVar, float value) const
+{
+    /// TODO : ne pas nécessairement retourner 0 ou 1
+    if (threshActivated) {
+        if (value >= thresholds.at(outVar))
+            value = 1.0;
+        else if (value >= 0.0)
+            value = 0.0;
+        else
+            value = -1.0;
+    }
+    return value;
+}
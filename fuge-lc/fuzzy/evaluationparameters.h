@@ -0,0 +1,69 @@
+/**
+  * @file   evaluationparameters.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class EvaluationParameters
+  * @brief Fitness weights, thresholds and genome options a fuzzy system is evaluated with.
+  *
+  * The name of the dataset is kept as well, to save the system without reading the system
+  * parameters. The values are copied from the system parameters when the object is built and do not
+  * follow later changes, so that a run keeps the parameters it was started with and
+  * several runs can evaluate their systems at the same time with different parameters.
+  */
+
+#ifndef EVALUATIONPARAMETERS_H
+#define EVALUATIONPARAMETERS_H
+
+#include <QString>
+#include <QVector>
+
+class SystemParameters;
+
+class EvaluationParameters
+{
+public:
+    EvaluationParameters();
+    EvaluationParameters(SystemParameters &sysParams);
+
+    void load(SystemParameters &sysParams);
+    float threshold(int outVar, float value) const;
+
+    inline float getThresholdVal(int outVar) const {return thresholds.at(outVar);}
+
+    bool fixedVars;
+    bool threshActivated;
+    QVector<float> thresholds;
+    float sensiW;
+    float speciW;
+    float accuracyW;
+    float ppvW;
+    float rmseW;
+    float rrseW;
+    float raeW;
+    float mseW;
+    float dontCareW;
+    float distanceThresholdW;
+    float distanceMinThresholdW;
+    float overLearnW;
+    QString datasetName;
+};
+
+#endif // EVALUATIONPARAMETERS_H
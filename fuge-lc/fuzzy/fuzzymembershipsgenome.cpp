@@ -79,37 +79,36 @@ FuzzyMembershipsGenome::~FuzzyMembershipsGenome()
   *@param bitString Bitstring to be decoded.
   *@param stringSize Size of the Bitstring.
   */
-// TODO: Cette méthode est coûteuse, on pourrait ganer en attaquant directement
-//       le bitstring lorsqu'on l'utilise. (mais ça reste plus propre)
-int FuzzyMembershipsGenome::readGenomeBitString(QBitArray *bitString, int stringSize)
+int FuzzyMembershipsGenome::readGenomeBitString(const QBitArray *bitString, int stringSize)
 {
     // Ensure that the bit string has the correct length
     assert(stringSize == nbInVars*nbInSets*inSetsPosCodeSize + nbOutVars*nbOutSets*outSetsPosCodeSize);
+    assert(stringSize <= bitString->size());
 
-    int temp = 0;
+    // The parameters are stored contiguously, so a single running bit index
+    // is enough to walk the packed genotype.
+    int bitIndex = 0;
 
     // Decode input variables
-    for (int i = 0; i < nbInVars; i++) {
-        for (int k = 0; k < nbInSets; k++) {
-            for (int l = 0; l < inSetsPosCodeSize; l++) {
-                temp += bitString->at(i*nbInSets*inSetsPosCodeSize + k*inSetsPosCodeSize + l) << l;
-            }
-            genomeArray[i*nbInSets + k] = temp;
-            temp = 0;
+    int inParams = nbInVars*nbInSets;
+    for (int i = 0; i < inParams; i++) {
+        int temp = 0;
+        for (int l = 0; l < inSetsPosCodeSize; l++, bitIndex++) {
+            if (bitString->testBit(bitIndex))
+                temp |= 1 << l;
         }
+        genomeArray[i] = temp;
     }
 
     // Decode output variables
-    int outBitIndex = nbInVars*nbInSets*inSetsPosCodeSize;
-    int outGenomeIndex = nbInVars*nbInSets;
-    for (int i = 0; i < nbOutVars; i++) {
-        for (int k = 0; k < nbOutSets; k++) {
-            for (int l = 0; l < outSetsPosCodeSize; l++) {
-                temp += bitString->at(outBitIndex + i*nbOutSets*outSetsPosCodeSize + k*outSetsPosCodeSize + l) << l;
-          }
-            genomeArray[outGenomeIndex + i*nbOutSets + k] = temp;
-            temp = 0;
+    int outParams = nbOutVars*nbOutSets;
+    for (int i = 0; i < outParams; i++) {
+        int temp = 0;
+        for (int l = 0; l < outSetsPosCodeSize; l++, bitIndex++) {
+            if (bitString->testBit(bitIndex))
+                temp |= 1 << l;
         }
+        genomeArray[inParams + i] = temp;
     }
     return 0;
 }
@@ -49,7 +49,7 @@ public:
                            int nbOutSets, int inSetsPosCodeSize, int outSetsPosCodeSize);
     virtual ~FuzzyMembershipsGenome();
 
-    int readGenomeBitString(QBitArray *bitString, int stringSize);
+    int readGenomeBitString(const QBitArray *bitString, int stringSize);
     int readGenomeIntString(quint16* intString, int stringSize);
     int getNbInSets();
     int getNbOutSets();
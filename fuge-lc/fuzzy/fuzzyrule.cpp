@@ -41,7 +41,6 @@
 #include "fuzzyrule.h"
 #include "fuzzyoperator.h"
 #include "fuzzyoperatorand.h"
-#include "systemparameters.h"
 
 // FIXME: Output values don't support -1 due to this implementation.
 #define DONT_CARE_EVAL_RULE -1.0
@@ -54,23 +53,76 @@
   * @param inVarArray Array containing the input variables defined in the system.
   * @param outVarArray Array containing the output variables defined in the system.
   * @param ruleGenome Genome encoding the information describing the rule.
+  * @param nbInVars Number of input variables of the system.
+  * @param nbOutVars Number of output variables of the system.
+  * @param fixedVars True if the genome only encodes the sets of fixed variables.
   */
-FuzzyRule::FuzzyRule(FuzzyVariable** inVarArray, FuzzyVariable** outVarArray, FuzzyRuleGenome* ruleGenome)
+FuzzyRule::FuzzyRule(FuzzyVariable** inVarArray, FuzzyVariable** outVarArray, FuzzyRuleGenome* ruleGenome,
+                     int nbInVars, int nbOutVars, bool fixedVars)
 {
-    SystemParameters& sysParams = SystemParameters::getInstance();
+    inCapacity = 0;
+    outCapacity = 0;
+    inVarsTab = NULL;
+    outVarsTab = NULL;
+    inVarsSetsTab = NULL;
+    outVarsSetsTab = NULL;
+    fireLevel = NULL;
+
+    load(inVarArray, outVarArray, ruleGenome, nbInVars, nbOutVars, fixedVars);
+}
+
+/**
+  * Make sure the internal arrays can hold the given number of input and output pairs.
+  * The arrays are only reallocated when they are too small.
+  *
+  * @param nbIn Number of input variables/sets pairs.
+  * @param nbOut Number of output variables/sets pairs.
+  */
+void FuzzyRule::reserve(int nbIn, int nbOut)
+{
+    if (nbIn > inCapacity) {
+        delete[] inVarsTab;
+        delete[] inVarsSetsTab;
+        inVarsTab = new FuzzyVariable* [nbIn];
+        inVarsSetsTab = new int[nbIn];
+        inCapacity = nbIn;
+    }
+    if (nbOut > outCapacity) {
+        delete[] outVarsTab;
+        delete[] outVarsSetsTab;
+        delete[] fireLevel;
+        outVarsTab = new FuzzyVariable* [nbOut];
+        outVarsSetsTab = new int[nbOut];
+        fireLevel = new double[nbOut];
+        outCapacity = nbOut;
+    }
+}
 
+/**
+  * (Re)load the rule from a genome, reusing the already allocated arrays. This allows
+  * the fuzzy system to keep its rules between two evaluations.
+  *
+  * @param inVarArray Array containing the input variables defined in the system.
+  * @param outVarArray Array containing the output variables defined in the system.
+  * @param ruleGenome Genome encoding the information describing the rule.
+  * @param nbInVars Number of input variables of the system.
+  * @param nbOutVars Number of output variables of the system.
+  * @param fixedVars True if the genome only encodes the sets of fixed variables.
+  */
+void FuzzyRule::load(FuzzyVariable** inVarArray, FuzzyVariable** outVarArray, FuzzyRuleGenome* ruleGenome,
+                     int nbInVars, int nbOutVars, bool fixedVars)
+{
     inVars = ruleGenome->getInputVarCount();
 
     int inVarsOrig = inVars;
     outVars = ruleGenome->getOutputVarCount();
     int outVarsOrig = outVars;
 
-    inVarsTab = new FuzzyVariable* [inVars];
-    outVarsTab = new FuzzyVariable* [outVars];
-    inVarsSetsTab = new int[inVars];
-    outVarsSetsTab = new int[outVars];
-
-    fireLevel = new double[outVars];
+    reserve(inVars, outVars);
+    // erase() keeps the list storage, unlike clear()
+    usedOutVars.erase(usedOutVars.begin(), usedOutVars.end());
+    // The description is built on demand by getDescription()
+    description.clear();
 
     int varNum;
 
@@ -79,12 +131,12 @@ FuzzyRule::FuzzyRule(FuzzyVariable** inVarArray, FuzzyVariable** outVarArray, Fu
         varNum = ruleGenome->getVarNumber(i);
 
         // EVOLVING VARS
-        if (!sysParams.getFixedVars()) {
+        if (!fixedVars) {
             // Check that variable number is valid, if not, it is removed from the rule
             if (varNum == -1) {
                 inVars--;
             }
-            else if (varNum >= sysParams.getNbInVars()) {
+            else if (varNum >= nbInVars) {
                 inVars--;
             }
             // Check that set number is valid, if not, the variable is removed from the rule
@@ -124,7 +176,7 @@ FuzzyRule::FuzzyRule(FuzzyVariable** inVarArray, FuzzyVariable** outVarArray, Fu
     for (int i = 0, pos = 0; i < outVarsOrig; i++) {
         varNum = ruleGenome->getVarNumber(i+inVarsOrig);
         // Special case. When only one output variable we always use it
-        if (sysParams.getNbOutVars() == 1) {
+        if (nbOutVars == 1) {
             outVarsTab[0] = outVarArray[0];
             // Check that the set number is valid
             int setNum = ruleGenome->getSetNumber(inVarsOrig);
@@ -165,24 +217,6 @@ FuzzyRule::FuzzyRule(FuzzyVariable** inVarArray, FuzzyVariable** outVarArray, Fu
         }
     }
 
-    // Create the textual description of the rule
-    description.append(" IF ");
-    for (int i = 0; i < inVars; i++)  {
-        description.append(inVarsTab[i]->getName());
-        description.append(" is ");
-        description.append(inVarsTab[i]->getSet(inVarsSetsTab[i])->getName());
-        if (i != inVars-1)
-            description.append(" AND ");
-    }
-    description.append(" THEN ");
-    for (int i = 0; i < outVars; i++) {
-        description.append(outVarsTab[i]->getName());
-        description.append(" is ");
-        description.append(outVarsTab[i]->getSet(outVarsSetsTab[i])->getName());
-        if (i != outVars-1)
-            description.append(" AND ");
-    }
-
 #if 0
 
     //DEBUG
@@ -215,6 +249,8 @@ FuzzyRule::FuzzyRule(QVector<FuzzyVariable*> inVarsVector, QVector<int> inSetsVe
 {
     inVars = inVarsVector.size();
     outVars = outVarsVector.size();
+    inCapacity = inVars;
+    outCapacity = outVars;
     inVarsTab = new FuzzyVariable* [inVars];
     outVarsTab = new FuzzyVariable* [outVars];
     inVarsSetsTab = new int[inVars];
@@ -233,7 +269,15 @@ FuzzyRule::FuzzyRule(QVector<FuzzyVariable*> inVarsVector, QVector<int> inSetsVe
         outVarsSetsTab[i] = outSetsVector.at(i);
     }
 
-    // Create the textual description of the rule
+    buildDescription();
+}
+
+/**
+  * Create the textual description of the rule.
+  */
+void FuzzyRule::buildDescription()
+{
+    description.clear();
     description.append(" IF ");
     for (int i = 0; i < inVars; i++)  {
         description.append(inVarsTab[i]->getName());
@@ -283,8 +327,14 @@ FuzzyRule::~FuzzyRule()
 
 }
 
+/**
+  * Returns the textual description of the rule. It is only built when requested,
+  * the evolution never needs the description of the evaluated candidates.
+  */
 QString FuzzyRule::getDescription()
 {
+    if (description.isEmpty())
+        buildDescription();
     return description;
 }
 
@@ -309,7 +359,8 @@ void FuzzyRule::evaluate()
     std::cout << std::endl;
 #endif
     //TODO: The operator should be provided as a param
-    FuzzyOperator *fOp = new FuzzyOperatorAND;
+    FuzzyOperatorAND andOp;
+    FuzzyOperator *fOp = &andOp;
 
     // Compute the evaluation for all input variables
     if (inVars == 1) {
@@ -350,8 +401,6 @@ void FuzzyRule::evaluate()
         }
     }
 
-    delete fOp;
-
 #if 0
     std::cout << "Rule : In vars : ";
     for (int i = 0; i < inVars; i++) {
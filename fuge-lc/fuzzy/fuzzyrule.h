@@ -47,11 +47,14 @@
 class FuzzyRule
 {
 public:
-    FuzzyRule(FuzzyVariable** inVarArray, FuzzyVariable** outVarArray, FuzzyRuleGenome* ruleGenome/*, FuzzyOperator* fuzzyOp*/);
+    FuzzyRule(FuzzyVariable** inVarArray, FuzzyVariable** outVarArray, FuzzyRuleGenome* ruleGenome,
+              int nbInVars, int nbOutVars, bool fixedVars/*, FuzzyOperator* fuzzyOp*/);
     FuzzyRule(QVector<FuzzyVariable*> inVarsVector, QVector<int> inSetsVector,
               QVector<FuzzyVariable*> outVarsVector, QVector<int> outSetsVector);
     virtual ~FuzzyRule();
 
+    void load(FuzzyVariable** inVarArray, FuzzyVariable** outVarArray, FuzzyRuleGenome* ruleGenome,
+              int nbInVars, int nbOutVars, bool fixedVars);
     void evaluate();
     double getFireLevel(int varNum);
     QList<int>* getUsedOutVars();
@@ -76,6 +79,12 @@ private:
     double* fireLevel;
     QList<int> usedOutVars;
     QString description;
+    // Allocated size of the arrays, they are reused when the rule is reloaded
+    int inCapacity;
+    int outCapacity;
+
+    void reserve(int nbIn, int nbOut);
+    void buildDescription();
 };
 
 #endif // FUZZYRULE_H
@@ -41,7 +41,6 @@
 #include <assert.h>
 
 #include "fuzzyrulegenome.h"
-#include "systemparameters.h"
 
 #define EMPTY -2
 
@@ -70,6 +69,11 @@ FuzzyRuleGenome::FuzzyRuleGenome(int inLimit, int inCount, int outCount, int inC
     this->outVarCodeSize = outCodeSize;
     this->inSetCodeSize = inSetCodeSize;
     this->outSetCodeSize = outSetCodeSize;
+    this->inPairSize = inCodeSize + inSetCodeSize;
+    this->outPairSize = outCodeSize + outSetCodeSize;
+    this->outputStart = inLimit * inPairSize;
+    usedInVarsTab.resize(inCount);
+    usedOutVarsTab.resize(outCount);
 
     genomeArray = new int[inputCount*2 + outputCount*2];
     // Mark the genome as empty.
@@ -134,8 +138,9 @@ int FuzzyRuleGenome::getSetNumber(int varPos)
   *
   * @param intString intstring to be read;
   * @param stringSize size of the bitstring to be read.
+  * @param fixedVars True if the variable numbers are not encoded.
   */
-int FuzzyRuleGenome::readGenomeBitString(quint16* bitString, int stringSize)
+int FuzzyRuleGenome::readGenomeBitString(quint16* bitString, int stringSize, bool fixedVars)
 {
 
     int varNum;
@@ -143,8 +148,6 @@ int FuzzyRuleGenome::readGenomeBitString(quint16* bitString, int stringSize)
     QVector<bool> usedInVarsTab(inputCount);
     QVector<bool> usedOutVarsTab(outputCount);
 
-    SystemParameters& sysParams = SystemParameters::getInstance();
-
     for (int i = 0; i < inputCount; i++)
         usedInVarsTab[i] = false;
     for (int i = 0; i < outputCount; i++)
@@ -157,7 +160,7 @@ int FuzzyRuleGenome::readGenomeBitString(quint16* bitString, int stringSize)
         varNum = 0;
         setNum = 0;
 
-        if (!sysParams.getFixedVars()) {
+        if (!fixedVars) {
             // Retrieve variable number
             for (int k = 0; k < inVarCodeSize; k++) {
                 varNum += bitString[i*(inVarCodeSize+inSetCodeSize) + k] << k;
@@ -247,6 +250,96 @@ int FuzzyRuleGenome::readGenomeBitString(quint16* bitString, int stringSize)
     return 0;
 }
 
+/**
+  * Store the variable number of an input, marking it as invalid (-1) if it is
+  * out of range or already used by a previous input of the rule.
+  *
+  * @param i Position of the input in the rule.
+  * @param varNum Decoded variable number.
+  */
+void FuzzyRuleGenome::storeInVar(int i, int varNum)
+{
+    if (varNum >= inputCount || usedInVarsTab[varNum]) {
+        genomeArray[i*2] = -1;
+    }
+    else {
+        genomeArray[i*2] = varNum;
+        usedInVarsTab[varNum] = true;
+    }
+}
+
+/**
+  * Store the variable number of an output, marking it as invalid (-1) if it is
+  * out of range or already used by a previous output of the rule.
+  *
+  * @param i Position of the output in the rule.
+  * @param varNum Decoded variable number.
+  */
+void FuzzyRuleGenome::storeOutVar(int i, int varNum)
+{
+    int base = inLimit*2 + i*2;
+    if (varNum >= outputCount || usedOutVarsTab[varNum]) {
+        genomeArray[base] = -1;
+    }
+    else {
+        genomeArray[base] = varNum;
+        usedOutVarsTab[varNum] = true;
+    }
+}
+
+/**
+  * Populate the genome by reading the rule directly from a packed genotype
+  * (evolving variables layout). No intermediate bitstring is built.
+  *
+  * @param bitArray Genotype containing the rule.
+  * @param offset Index of the first bit of the rule in the genotype.
+  */
+int FuzzyRuleGenome::readGenomeBitArray(const QBitArray* bitArray, int offset)
+{
+    assert(offset + outputStart + outputCount*outPairSize <= bitArray->size());
+
+    usedInVarsTab.fill(false);
+    usedOutVarsTab.fill(false);
+
+    for (int i = 0; i < inLimit; i++) {
+        int pos = offset + i*inPairSize;
+        storeInVar(i, readField(bitArray, pos, inVarCodeSize));
+        genomeArray[i*2 + 1] = readField(bitArray, pos + inVarCodeSize, inSetCodeSize);
+    }
+    for (int i = 0; i < outputCount; i++) {
+        int pos = offset + outputStart + i*outPairSize;
+        storeOutVar(i, readField(bitArray, pos, outVarCodeSize));
+        genomeArray[inLimit*2 + i*2 + 1] = readField(bitArray, pos + outVarCodeSize, outSetCodeSize);
+    }
+    return 0;
+}
+
+/**
+  * Populate the genome by reading the rule directly from a packed genotype
+  * using the fixed variables layout : only the set numbers are encoded, the
+  * input variable number is its position and the output variable code is 0.
+  *
+  * @param bitArray Genotype containing the rule.
+  * @param offset Index of the first bit of the rule in the genotype.
+  */
+int FuzzyRuleGenome::readGenomeFixedVarsBitArray(const QBitArray* bitArray, int offset)
+{
+    int outOffset = offset + inLimit*inSetCodeSize;
+    assert(outOffset + outputCount*outSetCodeSize <= bitArray->size());
+
+    usedOutVarsTab.fill(false);
+
+    for (int i = 0; i < inLimit; i++) {
+        genomeArray[i*2] = i;
+        genomeArray[i*2 + 1] = readField(bitArray, offset + i*inSetCodeSize, inSetCodeSize);
+    }
+    for (int i = 0; i < outputCount; i++) {
+        storeOutVar(i, 0);
+        genomeArray[inLimit*2 + i*2 + 1] = readField(bitArray, outOffset + i*outSetCodeSize, outSetCodeSize);
+    }
+    return 0;
+}
+
 /**
   * Populate the genome by reading an intstring.
   *
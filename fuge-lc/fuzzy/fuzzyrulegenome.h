@@ -42,6 +42,7 @@
 
 #include <QtGlobal>
 #include <QBitArray>
+#include <QVector>
 
 class FuzzyRuleGenome
 {
@@ -50,7 +51,9 @@ public:
                     int outCodeSize, int inSetCodeSize, int outSetCodeSize);
     virtual ~FuzzyRuleGenome();
 
-    int readGenomeBitString(quint16* bitString, int stringSize);
+    int readGenomeBitString(quint16* bitString, int stringSize, bool fixedVars);
+    int readGenomeBitArray(const QBitArray* bitArray, int offset);
+    int readGenomeFixedVarsBitArray(const QBitArray* bitArray, int offset);
     int readGenomeIntString(quint16* intString, int stringSize);
     int getInputVarCount();
     int getOutputVarCount();
@@ -66,8 +69,25 @@ private:
     int outVarCodeSize;
     int inSetCodeSize;
     int outSetCodeSize;
+    // Field offsets, computed once in the constructor
+    int inPairSize;
+    int outPairSize;
+    int outputStart;
+    QVector<bool> usedInVarsTab;
+    QVector<bool> usedOutVarsTab;
 
     int elimDuplicateVars(int nbVars, int position);
+    void storeInVar(int i, int varNum);
+    void storeOutVar(int i, int varNum);
+    static inline int readField(const QBitArray* bitArray, int pos, int size)
+    {
+        int value = 0;
+        for (int k = 0; k < size; k++) {
+            if (bitArray->testBit(pos + k))
+                value |= 1 << k;
+        }
+        return value;
+    }
 };
 
 #endif // FUZZYRULEGENOME_H
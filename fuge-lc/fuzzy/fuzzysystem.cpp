@@ -59,6 +59,18 @@ FuzzySystem::FuzzySystem()
     distanceMinThreshold = 0.0;
     dontCare = 0.0;
     overLearn = 0.0;
+    descriptionValid = true;
+    evalParams = NULL;
+    shardPool = NULL;
+    dataset = NULL;
+    ownsDataset = false;
+    // Nothing to delete until a system is loaded
+    nbInVars = 0;
+    nbOutVars = 0;
+    nbRules = 0;
+    inVarArray = NULL;
+    outVarArray = NULL;
+    rulesArray = NULL;
 }
 
 /**
@@ -66,6 +78,10 @@ FuzzySystem::FuzzySystem()
   */
 FuzzySystem::~FuzzySystem()
 {
+    qDeleteAll(shards);
+    if (ownsDataset)
+        delete dataset;
+
     // TODO : trouver un bon moyen de supprimer les règles
     // Add variables
     for (int i = 0; i < nbInVars; i++) {
@@ -153,16 +169,80 @@ void FuzzySystem::setParameters(int nbRules, int nbVarPerRule, int nbOutVars, in
     // Create an empty default rule array
     defaultRulesSets.resize(nbOutVars);
 
-    // Create arrRuleFired and arrRuleAlone
-    /*
-    arrRuleFired = new int[nbRules];
-    arrRuleAlone = new int[nbRules];
-    for(int i = 0; i < nbRules; i++)
-    {
-        arrRuleFired[i] = 0;
-        arrRuleAlone[i] = 0;
-    }
-    */
+    // Create the evaluation buffers once, they are only cleared by evaluateFitness()
+    arrRuleFired.fill(0, nbRules);
+    arrRuleWinner.fill(0, nbRules);
+    maxFiredRule.fill(0.0, nbOutVars);
+    fitVector.resize(nbOutVars);
+}
+
+/**
+  * Create a fuzzy system with the same parameters and the same dataset, without any
+  * genome loaded. Each copy can be evaluated in its own thread.
+  *
+  * @param replica Parsed dataset the copy reads its samples from, NULL to share the one
+  * of this system. The copy must then be deleted before this system.
+  * @return A new fuzzy system, owned by the caller.
+  */
+FuzzySystem* FuzzySystem::createEvaluationCopy(const NumericDataset *replica)
+{
+    FuzzySystem *copy = new FuzzySystem();
+    copy->setParameters(nbRules, nbVarPerRule, nbOutVars, nbInSets, nbOutSets, inVarsCodeSize,
+                        outVarsCodeSize, inSetsCodeSize, outSetsCodeSize, inSetsPosCodeSize, outSetsPosCodeSize);
+    copy->setEvaluationParameters(evalParams);
+    copy->dataset = replica != NULL ? replica : dataset;
+    copy->loadData(systemData);
+    return copy;
+}
+
+/**
+  * Create a fuzzy system with the same parameters, evaluated on another dataset with the
+  * same columns, such as a validation dataset. No genome is loaded. The universes of the
+  * variables are the ones of this system, a genome is decoded the same way in both.
+  *
+  * @param otherData Dataset of the copy, it must outlive it.
+  * @return A new fuzzy system, owned by the caller.
+  */
+FuzzySystem* FuzzySystem::createDatasetCopy(QList<QStringList>* otherData)
+{
+    FuzzySystem *copy = new FuzzySystem();
+    copy->setParameters(nbRules, nbVarPerRule, nbOutVars, nbInSets, nbOutSets, inVarsCodeSize,
+                        outVarsCodeSize, inSetsCodeSize, outSetsCodeSize, inSetsPosCodeSize, outSetsPosCodeSize);
+    copy->setEvaluationParameters(evalParams);
+    copy->loadData(otherData);
+    for (int i = 0; i < nbVars; i++)
+        copy->varUniverseArray[i] = varUniverseArray[i];
+    return copy;
+}
+
+/**
+  * Set the parameters the system is evaluated with. They must outlive the system.
+  *
+  * @param params Parameters of the run, NULL to follow the system parameters
+  */
+void FuzzySystem::setEvaluationParameters(const EvaluationParameters *params)
+{
+    evalParams = params;
+}
+
+/**
+  * Return the parameters the system is evaluated with. Without run parameters, the
+  * current values of the system parameters are returned.
+  */
+const EvaluationParameters *FuzzySystem::getEvaluationParameters()
+{
+    if (evalParams != NULL)
+        return evalParams;
+    ownParams.load(SystemParameters::getInstance());
+    return &ownParams;
+}
+
+/**
+  * Return the dataset loaded by loadData().
+  */
+QList<QStringList>* FuzzySystem::getSystemData()
+{
+    return systemData;
 }
 
 /**
@@ -177,6 +257,14 @@ void FuzzySystem::loadData(QList<QStringList>* systemData)
     // Retrieve the system data
     this->systemData = systemData;
 
+    // Parse the values once, unless this copy shares the ones of another system
+    if (ownsDataset || dataset == NULL) {
+        if (ownsDataset)
+            delete dataset;
+        dataset = new NumericDataset(systemData);
+        ownsDataset = true;
+    }
+
     //Put list of var in a hash map
     QStringList lstVar = systemData->at(0);
     const int size = lstVar.size();
@@ -199,7 +287,9 @@ void FuzzySystem::loadData(QList<QStringList>* systemData)
         // Retrieve the number of variables (in+out)
         nbVars = systemData->at(0).count() - 1;
         nbInVars = nbVars - nbOutVars;
-        sysParams.setNbInVars(nbInVars);
+        // Only the systems of the GUI publish the number of variables
+        if (evalParams == NULL)
+            sysParams.setNbInVars(nbInVars);
 
         // Create the variables arrays from the systemData information
         inVarArray  = new FuzzyVariable*[nbInVars];
@@ -297,6 +387,7 @@ void FuzzySystem::reset()
 
     // Clear the description
     systemDescription.clear();
+    descriptionValid = true;
 
     defuzzValues.clear();
     threshValues.clear();
@@ -313,13 +404,10 @@ void FuzzySystem::reset()
     for (int i = 0; i < nbOutVars; i++) {
     }
 
-    // Delete the rules
-    for (int i = 0; i < nbRules ; i++) {
-        if (rulesArray[i] != NULL) {
-            delete rulesArray[i];
-            rulesArray[i] = NULL;
-        }
-    }
+    // The rules are kept, loadRulesGenome() reloads them in place
+
+    for (int i = 0; i < shards.size(); i++)
+        shards[i]->reset();
 }
 
 void FuzzySystem::detectVarUniverses(universeBounds* varUniArray)
@@ -352,12 +440,13 @@ void FuzzySystem::detectVarUniverses(universeBounds* varUniArray)
 void FuzzySystem::loadRulesGenome(FuzzyRuleGenome** ruleGenArray, int* defRulesSets)
 {
 
+    const bool fixedVars = getEvaluationParameters()->fixedVars;
     for (int i = 0; i <  nbRules; i++) {
-        // Create the rule
-        rulesArray[i] = new FuzzyRule(inVarArray, outVarArray, ruleGenArray[i]);
-        // Update the system description
-        systemDescription.append(rulesArray[i]->getDescription());
-        systemDescription.append("\n");
+        // Create the rule or reuse the one from the previous evaluation
+        if (rulesArray[i] == NULL)
+            rulesArray[i] = new FuzzyRule(inVarArray, outVarArray, ruleGenArray[i], nbInVars, nbOutVars, fixedVars);
+        else
+            rulesArray[i]->load(inVarArray, outVarArray, ruleGenArray[i], nbInVars, nbOutVars, fixedVars);
     }
     // Decode the default rules
     int val = 0;
@@ -372,6 +461,24 @@ void FuzzySystem::loadRulesGenome(FuzzyRuleGenome** ruleGenArray, int* defRulesS
         defaultRulesSets.replace(i, val);
     }
 
+    // The description is only needed for the systems that are displayed or saved
+    descriptionValid = false;
+    rulesLoaded = true;
+
+    for (int i = 0; i < shards.size(); i++)
+        shards[i]->loadRulesGenome(ruleGenArray, defRulesSets);
+}
+
+/**
+  * Create the textual description of the loaded rules and membership functions.
+  */
+void FuzzySystem::buildSystemDescription()
+{
+    systemDescription.clear();
+    for (int i = 0; i <  nbRules; i++) {
+        systemDescription.append(rulesArray[i]->getDescription());
+        systemDescription.append("\n");
+    }
 
     // Add the default rule to the system description
     systemDescription.append(" ELSE : ");
@@ -412,7 +519,7 @@ void FuzzySystem::loadRulesGenome(FuzzyRuleGenome** ruleGenArray, int* defRulesS
             systemDescription.append("\n");
     }
 
-    rulesLoaded = true;
+    descriptionValid = true;
 }
 
 void FuzzySystem::updateSystemDescription()
@@ -463,6 +570,7 @@ void FuzzySystem::updateSystemDescription()
         else
             systemDescription.append("\n");
     }
+    descriptionValid = true;
 }
 
 /**
@@ -472,72 +580,121 @@ void FuzzySystem::updateSystemDescription()
   */
 void FuzzySystem::loadMembershipsGenome(FuzzyMembershipsGenome* membGen)
 {
+    QVector<float> positions;
+
+    computeMembershipsPositions(membGen, &positions);
+    loadMembershipsPositions(positions);
+}
 
-    float position = 0.0;
+/**
+  * Compute the absolute, sorted, positions of the sets encoded in a membership
+  * functions genome without touching the variables of the system. The positions
+  * of the input variables come first, followed by the ones of the output variables.
+  *
+  * @param membGen Genome containing the different memberships funcions.
+  * @param positions Vector receiving the positions of all the sets.
+  */
+void FuzzySystem::computeMembershipsPositions(FuzzyMembershipsGenome* membGen, QVector<float>* positions)
+{
     float step = 0.0;
     float valMin = 0.0;
+    int nbGenInSets = membGen->getNbInSets();
+    int nbGenOutSets = membGen->getNbOutSets();
+    float inSteps = pow(2, membGen->getInSetsPosCodeSize())-1;
+    float outSteps = pow(2, membGen->getOutSetsPosCodeSize())-1;
 
-    QVector<float> posVector;
+    positions->resize(nbInVars*nbGenInSets + nbOutVars*nbGenOutSets);
+    float* pos = positions->data();
 
     // Loop through all input variables
     for (int i = 0; i  < nbInVars; i++) {
         valMin = varUniverseArray[i].valMin;
-        step = (varUniverseArray[i].valMax - valMin) / (pow(2, membGen->getInSetsPosCodeSize())-1);
-        // Loop through all sets of the current variable
-        for (int k = 0; k < membGen->getNbInSets(); k++) {
-            // Retrieve the position encoded in the genome
-            position = ((float) membGen->getInParam(i,k) * step);
-            posVector.append(position);
+        step = (varUniverseArray[i].valMax - valMin) / inSteps;
+        // Retrieve the positions encoded in the genome
+        for (int k = 0; k < nbGenInSets; k++) {
+            pos[k] = (float) membGen->getInParam(i,k) * step;
         }
-        // Sort the vector
-        qSort(posVector);
-        // Add the sets to the variable
-        for (int l = 0; l < posVector.size(); l++) {
-            inVarArray[i]->getSet(l)->setPosition(posVector.at(l)+valMin);
+        // Sort the positions and move them into the variable universe
+        qSort(pos, pos + nbGenInSets);
+        for (int k = 0; k < nbGenInSets; k++) {
+            pos[k] += valMin;
         }
-        posVector.clear();
+        pos += nbGenInSets;
     }
 
     // Loop through all output variables
     for (int i = 0; i  < nbOutVars; i++) {
         valMin = varUniverseArray[i+nbInVars].valMin;
-        step = (varUniverseArray[i+nbInVars].valMax - valMin) / (pow(2, membGen->getOutSetsPosCodeSize())-1);
-        // Loop through all sets of the current variable
-        for (int k = 0; k < membGen->getNbOutSets(); k++) {
-            // Retrieve the position encoded in the genome
-            position = ((float) membGen->getOutParam(i,k) * step);
-            posVector.append(position);
+        step = (varUniverseArray[i+nbInVars].valMax - valMin) / outSteps;
+        for (int k = 0; k < nbGenOutSets; k++) {
+            pos[k] = (float) membGen->getOutParam(i,k) * step;
+        }
+        qSort(pos, pos + nbGenOutSets);
+        for (int k = 0; k < nbGenOutSets; k++) {
+            pos[k] += valMin;
         }
-        // Sort the vector
-        qSort(posVector);
-        // Add the sets to the variable
-        for (int l = 0; l < posVector.size(); l++) {
-            outVarArray[i]->getSet(l)->setPosition(posVector.at(l)+valMin);
+        pos += nbGenOutSets;
+    }
+}
+
+/**
+  * Set the memberships functions of the variables from positions previously
+  * computed by computeMembershipsPositions().
+  *
+  * @param positions Absolute positions of all the sets.
+  */
+void FuzzySystem::loadMembershipsPositions(const QVector<float>& positions)
+{
+    const float* pos = positions.constData();
+
+    for (int i = 0; i  < nbInVars; i++) {
+        for (int l = 0; l < nbInSets; l++) {
+            inVarArray[i]->getSet(l)->setPosition(*pos++);
+        }
+    }
+    for (int i = 0; i  < nbOutVars; i++) {
+        for (int l = 0; l < nbOutSets; l++) {
+            outVarArray[i]->getSet(l)->setPosition(*pos++);
         }
-        posVector.clear();
     }
 
     membershipsLoaded = true;
+
+    for (int i = 0; i < shards.size(); i++)
+        shards[i]->loadMembershipsPositions(positions);
 }
 
-float FuzzySystem::threshold(int outVar, float value)
+/**
+  * Split the samples in count contiguous ranges, evaluated in parallel on the pool by copies
+  * of this system. Only the rules and memberships loaded by loadRulesGenome() and
+  * loadMembershipsPositions() after this call are forwarded to the copies.
+  *
+  * The fitness is the same, bit for bit, as the one computed without shards : the rule
+  * counters of the copies are summed and the float sums are accumulated here, in the order
+  * of the samples. The thread calling evaluateFitness() evaluates ranges too, it may be a
+  * worker of the pool.
+  *
+  * @param pool Pool evaluating the ranges, NULL to evaluate all the samples in this system.
+  * @param count Number of ranges, at most one per sample.
+  */
+void FuzzySystem::setSampleShards(WorkStealingPool *pool, int count)
 {
+    qDeleteAll(shards);
+    shards.clear();
+    shardPool = NULL;
 
-    /// TODO : ne pas nécessairement retourner 0 ou 1
-    SystemParameters& sysParams = SystemParameters::getInstance();
-
-    if (sysParams.getThreshActivated()) {
-        if (value >= sysParams.getThresholdVal(outVar))
-            value = 1.0;
-        else if (value >= 0.0)
-            value = 0.0;
-        else
-            value = -1.0;
-    }
+    assert(dataLoaded || pool == NULL);
+    if (pool == NULL || qMin(count, nbSamples) < 2)
+        return;
 
-    //qDebug("value = %f", value);
+    shardPool = pool;
+    for (int i = qMin(count, nbSamples); i > 0; i--)
+        shards.append(createEvaluationCopy());
+}
 
-    return value;
+float FuzzySystem::threshold(int outVar, float value)
+{
+    return getEvaluationParameters()->threshold(outVar, value);
 }
 //Idk if this function is still usefull
 int FuzzySystem::getVarInDataset(const QString name)
@@ -546,11 +703,11 @@ int FuzzySystem::getVarInDataset(const QString name)
     return hashVar.value(name);
 }
 
-void FuzzySystem::evaluateSample(int sampleNum)
+void FuzzySystem::evaluateSample(int sampleNum, const EvaluationParameters *params)
 {
 
     assert(sampleNum >= 0 && sampleNum < nbSamples);
-    QVector<float> maxFiredRule(nbOutVars);
+    maxFiredRule.resize(nbOutVars);
 
     // Clean the previous evaluation values in the output variables sets
     for (int i = 0; i < nbOutVars; i++) {
@@ -567,17 +724,16 @@ void FuzzySystem::evaluateSample(int sampleNum)
     for (int i = 0; i < nbInVars; i++) {
         if (inVarArray[i]->isUsedBySystem()) {
 
-            bool isOk;
-            float value = systemData->at(sampleNum+1).at(hashVar.value(inVarArray[i]->getName())).toFloat(&isOk);
+            const int column = hashVar.value(inVarArray[i]->getName());
 
             // Value is not numeric
-            if (isOk == false) {
+            if (dataset->isMissing(sampleNum, column)) {
                 //qDebug("missing value at sample num : %d, var : %d", sampleNum, i);
                 inVarArray[i]->setMissingVal(true);
             }
             // Value is OK
             else {
-                inVarArray[i]->setInputValue(value);
+                inVarArray[i]->setInputValue(dataset->getValue(sampleNum, column));
             }
         }
     }
@@ -660,11 +816,99 @@ void FuzzySystem::evaluateSample(int sampleNum)
                 std::cout << "Error : variable " << i << " defuzzification = -1 !!!" << std::endl;
                 throw;
             }
-        threshValues.replace(i, threshold(i, defuzzValues.at(i)));
+        threshValues.replace(i, params->threshold(i, defuzzValues.at(i)));
         //qDebug("value = %f", defuzzValues.at(i));
     }
 }
 
+/**
+  * Evaluate the samples [begin, end) and store their defuzzified outputs. The rule counters
+  * of this system are incremented.
+  *
+  * @param defuzzed Outputs of all the samples, nbOutVars values per sample.
+  */
+void FuzzySystem::evaluateSampleRange(int begin, int end, const EvaluationParameters *params, float *defuzzed)
+{
+    defuzzValues.resize(nbOutVars);
+    threshValues.resize(nbOutVars);
+    for (int i = begin; i < end; i++) {
+        evaluateSample(i, params);
+        for (int k = 0; k < nbOutVars; k++) {
+            defuzzed[i*nbOutVars + k] = defuzzValues.at(k);
+        }
+    }
+}
+
+/**
+  * Compute the defuzzified outputs of samples which are not the ones of the dataset, for
+  * a system loaded from a file. The samples must have the columns of the dataset given
+  * to loadData(), the results of the last evaluation are kept but the rule counters only
+  * count these samples.
+  *
+  * @param samples Samples to evaluate
+  * @param defuzzed Outputs of the samples, nbOutVars values per sample.
+  */
+void FuzzySystem::predict(const NumericDataset *samples, float *defuzzed)
+{
+    assert(dataLoaded);
+    const NumericDataset *loaded = dataset;
+    const int loadedCount = nbSamples;
+    dataset = samples;
+    nbSamples = samples->getSampleCount();
+    arrRuleFired.fill(0, nbRules);
+    arrRuleWinner.fill(0, nbRules);
+    evaluateSampleRange(0, nbSamples, getEvaluationParameters(), defuzzed);
+    dataset = loaded;
+    nbSamples = loadedCount;
+}
+
+/**
+  * Evaluate one range of samples per shard on a worker of the shard pool. Each shard
+  * writes its own part of the outputs of the system.
+  */
+class FuzzySystem::ShardJob : public WorkStealingPool::Job
+{
+public:
+    ShardJob(FuzzySystem *fSystem, const EvaluationParameters *params, float *defuzzed) :
+        fSystem(fSystem), params(params), defuzzed(defuzzed) {}
+
+    void execute(int worker, quint32 chunk, quint32 begin, quint32 end)
+    {
+        Q_UNUSED(worker);
+        Q_UNUSED(chunk);
+        const qint64 nbSamples = fSystem->nbSamples;
+        const qint64 count = fSystem->shards.size();
+        for (quint32 s = begin; s < end; s++) {
+            FuzzySystem *shard = fSystem->shards[s];
+            shard->arrRuleFired.fill(0, shard->nbRules);
+            shard->arrRuleWinner.fill(0, shard->nbRules);
+            shard->evaluateSampleRange(nbSamples*s / count, nbSamples*(s+1) / count, params, defuzzed);
+        }
+    }
+
+private:
+    FuzzySystem *fSystem;
+    const EvaluationParameters *params;
+    float *defuzzed;
+};
+
+/**
+  * Evaluate all the samples with the shards and sum their rule counters into the ones
+  * of this system.
+  */
+void FuzzySystem::evaluateShards(const EvaluationParameters *params)
+{
+    ShardJob job(this, params, computedResults.data());
+    shardPool->run(&job, shards.size(), 1);
+
+    for (int s = 0; s < shards.size(); s++) {
+        for (int i = 0; i < nbRules; i++) {
+            arrRuleFired[i] += shards[s]->arrRuleFired.at(i);
+            arrRuleWinner[i] += shards[s]->arrRuleWinner.at(i);
+        }
+    }
+}
+
 QVector<float> FuzzySystem::doEvaluateFitness()
 {
 
@@ -683,9 +927,9 @@ float FuzzySystem::evaluateFitness()
 {
 
     CoevStats& coevStats = CoevStats::getInstance();
-    SystemParameters& sysParams = SystemParameters::getInstance();
+    const EvaluationParameters *params = getEvaluationParameters();
 
-    QVector<fitnessStruct> fitVector(nbOutVars);
+    fitVector.resize(nbOutVars);
 
     for (int i = 0; i < nbOutVars; i++) {
         fitVector[i].tPosCount = 0;
@@ -734,27 +978,20 @@ float FuzzySystem::evaluateFitness()
     computedResults.resize(nbSamples*nbOutVars);
 
     //to compute overLearn
-    arrRuleFired = new int[nbRules];
-    //arrRuleAlone = new int[nbRules];
-    arrRuleWinner = new int[nbRules];
-    //arrRuleGrade = new float[nbRules];
+    arrRuleFired.fill(0, nbRules);
+    arrRuleWinner.fill(0, nbRules);
 
+    // Evaluate all samples, in parallel ranges if the system is sharded
+    if (shards.isEmpty())
+        evaluateSampleRange(0, nbSamples, params, computedResults.data());
+    else
+        evaluateShards(params);
 
-    for(int i = 0; i < nbRules; i++)
-    {
-        arrRuleFired[i] = 0;
-        //arrRuleAlone[i] = 0;
-        arrRuleWinner[i] = 0;
-        //arrRuleGrade[i] = 0.0;
-    }
-
-    // Evaluate all samples
+    // The criteria are accumulated in the order of the samples, so that the float sums
+    // do not depend on the sharding
     for (int i = 0; i < nbSamples; i++) {
-
-        evaluateSample(i);
         for (int k = 0; k < nbOutVars; k++) {
-            const float defuzzedValue = defuzzValues.at(k);
-            computedResults.replace(i*nbOutVars + k, defuzzedValue);
+            const float defuzzedValue = computedResults.at(i*nbOutVars + k);
 
             /* Compute regression criterra : RMSE, MSE, RRSE and RAE */
             const float error = defuzzedValue - results[k][i]; /* Predict - Actual */
@@ -766,9 +1003,9 @@ float FuzzySystem::evaluateFitness()
             }
 
             /* Compute classification criterra : sensi, specy, ppv, accuracy, ADM, MDM */
-            const float resTmp = threshold(k, results[k][i]);
-            const float thresholdAtK = sysParams.getThresholdVal(k);
-            const float threshValueAtK = threshValues.at(k);
+            const float resTmp = params->threshold(k, results[k][i]);
+            const float thresholdAtK = params->getThresholdVal(k);
+            const float threshValueAtK = params->threshold(k, defuzzedValue);
 
 
             if (threshValueAtK == resTmp && resTmp == 0) { //well classified, below threshold
@@ -950,19 +1187,9 @@ float FuzzySystem::evaluateFitness()
     const float mfSometime = 0.4; // triangle
     const float mfAlways = 0.7; //trapez
 
-    const int nbRuleInGeneralityFuzzy = 4;
-
-    QVector<RuleInGeneralityFuzzy> arrTruthLvl(nbRules);
-    QVector<float> arrRuleGrade(nbRules);
-
-    for ( int i = 0; i < nbRules; i++ ) {
-        arrRuleGrade[i] = 1.0;
-#if 0 // already zeroed
-        for ( int j = 0; j < nbRuleInGeneralityFuzzy; j++) {
-            arrTruthLvl[i][j] = 0.0;
-        }
-#endif
-    }
+    // The grade of each rule is only needed to find the minimum one
+    RuleInGeneralityFuzzy truthLvl;
+    float minGrade = 1.0;
 
     for( int i = 0; i < nbRules; i++ ) {
         const float firing = (float)arrRuleFired[i] / (float)nbSamples;
@@ -1027,29 +1254,25 @@ float FuzzySystem::evaluateFitness()
         }
 
         //Generality Rule
-        arrTruthLvl[i]._0 = firingHigh;
-        arrTruthLvl[i]._1 = std::min( firingLow, winnerNever );
-        arrTruthLvl[i]._2 = std::min( firingLow, winnerSometime );
-        arrTruthLvl[i]._3 = std::min( firingLow, winnerAlways );
-
-        const float evalProduct = arrTruthLvl[i]._0 * 1.0 +  //high
-                                  arrTruthLvl[i]._1 * 0.7 +  //med high
-                                  arrTruthLvl[i]._2 * 0.3 +  //med low
-                                  arrTruthLvl[i]._3 * 0.0;   //low
-
-        const float evalSum = arrTruthLvl[i]._0 +
-                              arrTruthLvl[i]._1 +
-                              arrTruthLvl[i]._2 +
-                              arrTruthLvl[i]._3;
-
-        arrRuleGrade[i] = evalProduct / evalSum;
-    }
-
-    float minGrade = 1.0;
-    for(int i = 0; i < nbRules; i++) {
-        //std::cout << arrRuleGrade[i] << std::endl;
-        if ( arrRuleGrade[i] < minGrade ) {
-            minGrade = arrRuleGrade[i];
+        truthLvl._0 = firingHigh;
+        truthLvl._1 = std::min( firingLow, winnerNever );
+        truthLvl._2 = std::min( firingLow, winnerSometime );
+        truthLvl._3 = std::min( firingLow, winnerAlways );
+
+        const float evalProduct = truthLvl._0 * 1.0 +  //high
+                                  truthLvl._1 * 0.7 +  //med high
+                                  truthLvl._2 * 0.3 +  //med low
+                                  truthLvl._3 * 0.0;   //low
+
+        const float evalSum = truthLvl._0 +
+                              truthLvl._1 +
+                              truthLvl._2 +
+                              truthLvl._3;
+
+        const float ruleGrade = evalProduct / evalSum;
+        //std::cout << ruleGrade << std::endl;
+        if ( ruleGrade < minGrade ) {
+            minGrade = ruleGrade;
         }
     }
 
@@ -1058,30 +1281,30 @@ float FuzzySystem::evaluateFitness()
 
 
 
-    float num = sysParams.getSensiW() * sensitivity
-                + sysParams.getSpeciW() * specificity
-                + sysParams.getAccuracyW() * accuracy
-                + sysParams.getPpvW() * ppv
-                + sysParams.getRmseW() * pow( 2.0, -rmse )
-                + sysParams.getRrseW() * pow( 2.0,-rrse )
-                + sysParams.getRaeW() * pow( 2.0,-rae )
-                + sysParams.getMseW() * pow( 2.0, -mse )
+    float num = params->sensiW * sensitivity
+                + params->speciW * specificity
+                + params->accuracyW * accuracy
+                + params->ppvW * ppv
+                + params->rmseW * pow( 2.0, -rmse )
+                + params->rrseW * pow( 2.0,-rrse )
+                + params->raeW * pow( 2.0,-rae )
+                + params->mseW * pow( 2.0, -mse )
                 //+ sysParams.getDistanceThresholdW() * distanceThreshold
                 //+ sysParams.getDistanceMinThresholdW() * distanceMinThreshold
-                + sysParams.getDontCareW() * dontCare;
+                + params->dontCareW * dontCare;
                 //+ sysParams.getOverLearnW()* overLearn;
 
-    float denum = sysParams.getSensiW()
-                  + sysParams.getSpeciW()
-                  + sysParams.getAccuracyW()
-                  + sysParams.getPpvW()
-                  + sysParams.getRmseW()
-                  + sysParams.getRrseW()
-                  + sysParams.getRaeW()
-                  + sysParams.getMseW()
+    float denum = params->sensiW
+                  + params->speciW
+                  + params->accuracyW
+                  + params->ppvW
+                  + params->rmseW
+                  + params->rrseW
+                  + params->raeW
+                  + params->mseW
                   //+ sysParams.getDistanceThresholdW()
                   //+ sysParams.getDistanceMinThresholdW()
-                  + sysParams.getDontCareW();
+                  + params->dontCareW;
                   //+ sysParams.getOverLearnW();
 
     this->fitness = num / denum;
@@ -1097,12 +1320,6 @@ float FuzzySystem::evaluateFitness()
     */
 
 
-    //Delete arrRuleFired and arrRuleAlone
-    delete[] arrRuleFired;
-    //delete[] arrRuleAlone;
-    delete[] arrRuleWinner;
-    //delete[] arrRuleGrade;
-
     // Avoid crash when fitness is 0 or lower
     if (fitness <= 0.0)
         fitness = 0.001;
@@ -1177,9 +1394,7 @@ int FuzzySystem::getMembershipsBitStringSize()
 
 int FuzzySystem::getRuleBitStringSize()
 {
-    SystemParameters& sysParams = SystemParameters::getInstance();
-
-    if (sysParams.getFixedVars())
+    if (getEvaluationParameters()->fixedVars)
         return (nbVarPerRule * (inSetsCodeSize) + nbOutVars * (outSetsCodeSize));
     else
         return (nbVarPerRule * (inVarsCodeSize+inSetsCodeSize) + nbOutVars * (outVarsCodeSize+outSetsCodeSize));
@@ -1197,6 +1412,8 @@ int FuzzySystem::getDefaultRulesBitStringSize()
 
 QString FuzzySystem::getSystemDescritpion()
 {
+    if (!descriptionValid)
+        buildSystemDescription();
     return systemDescription;
 }
 
@@ -1233,14 +1450,16 @@ float FuzzySystem::getRmse()
 void FuzzySystem::saveToFile(QString fileName, float fitVal)
 {
 
-    SystemParameters& sysParams = SystemParameters::getInstance();
+    // The parameters the system was evaluated with, they may differ from the current ones.
+    // Reading them from the system parameters is not safe outside of the GUI thread.
+    const EvaluationParameters *params = getEvaluationParameters();
 
     QDomDocument doc("FUGE-LC_fuzzy_system_file");
     QDomElement fuzzySystem = doc.createElement("Fuzzy_System");
     doc.appendChild(fuzzySystem);
     QDomElement datasetName = doc.createElement("Dataset_name");
     fuzzySystem.appendChild(datasetName);
-    QDomText datasetNameText = doc.createTextNode(sysParams.getDatasetName());
+    QDomText datasetNameText = doc.createTextNode(params->datasetName);
     datasetName.appendChild(datasetNameText);
     QDomElement fit = doc.createElement("Fitness");
     fuzzySystem.appendChild(fit);
@@ -1250,61 +1469,61 @@ void FuzzySystem::saveToFile(QString fileName, float fitVal)
     fitValue.appendChild(fitValueText);
     QDomElement fitSensi = doc.createElement("SensiW");
     fit.appendChild(fitSensi);
-    QDomText sensiText = doc.createTextNode(QString::number(sysParams.getSensiW()));
+    QDomText sensiText = doc.createTextNode(QString::number(params->sensiW));
     fitSensi.appendChild(sensiText);
     QDomElement fitSpeci = doc.createElement("SpeciW");
     fit.appendChild(fitSpeci);
-    QDomText speciText = doc.createTextNode(QString::number(sysParams.getSpeciW()));
+    QDomText speciText = doc.createTextNode(QString::number(params->speciW));
     fitSpeci.appendChild(speciText);
     QDomElement fitAccu = doc.createElement("AccuW");
     fit.appendChild(fitAccu);
-    QDomText accuText = doc.createTextNode(QString::number(sysParams.getAccuracyW()));
+    QDomText accuText = doc.createTextNode(QString::number(params->accuracyW));
     fitAccu.appendChild(accuText);
 
     QDomElement fitPpv = doc.createElement("PPVW");
     fit.appendChild(fitPpv);
-    QDomText ppvText = doc.createTextNode(QString::number(sysParams.getPpvW()));
+    QDomText ppvText = doc.createTextNode(QString::number(params->ppvW));
     fitPpv.appendChild(ppvText);
 
     QDomElement fitRmse = doc.createElement("RMSEW");
     fit.appendChild(fitRmse);
-    QDomText rmseText = doc.createTextNode(QString::number(sysParams.getRmseW()));
+    QDomText rmseText = doc.createTextNode(QString::number(params->rmseW));
     fitRmse.appendChild(rmseText);
 
     // MODIF - BUJARD Alexandre - 16.04.2010
     QDomElement fitRrse = doc.createElement("RRSEW");
     fit.appendChild(fitRrse);
-    QDomText rrseText = doc.createTextNode(QString::number(sysParams.getRrseW()));
+    QDomText rrseText = doc.createTextNode(QString::number(params->rrseW));
     fitRrse.appendChild(rrseText);
 
     QDomElement fitRae = doc.createElement("RAEW");
     fit.appendChild(fitRae);
-    QDomText raeText = doc.createTextNode(QString::number(sysParams.getRaeW()));
+    QDomText raeText = doc.createTextNode(QString::number(params->raeW));
     fitRae.appendChild(raeText);
 
     QDomElement fitMse = doc.createElement("MSEW");
     fit.appendChild(fitMse);
-    QDomText mseText = doc.createTextNode(QString::number(sysParams.getMseW()));
+    QDomText mseText = doc.createTextNode(QString::number(params->mseW));
     fitMse.appendChild(mseText);
 
     QDomElement fitDistanceThreshold = doc.createElement("ADMW");
     fit.appendChild(fitDistanceThreshold);
-    QDomText distanceThresholdText = doc.createTextNode(QString::number(sysParams.getDistanceThresholdW()));
+    QDomText distanceThresholdText = doc.createTextNode(QString::number(params->distanceThresholdW));
     fitDistanceThreshold.appendChild(distanceThresholdText);
 
     QDomElement fitDistanceMinThreshold = doc.createElement("MDMW");
     fit.appendChild(fitDistanceMinThreshold);
-    QDomText distanceMinThresholdText = doc.createTextNode(QString::number(sysParams.getDistanceMinThresholdW()));
+    QDomText distanceMinThresholdText = doc.createTextNode(QString::number(params->distanceMinThresholdW));
     fitDistanceMinThreshold.appendChild(distanceMinThresholdText);
 
     QDomElement fitDontCare = doc.createElement("SizeW");
     fit.appendChild(fitDontCare);
-    QDomText dontCareText = doc.createTextNode(QString::number(sysParams.getDontCareW()));
+    QDomText dontCareText = doc.createTextNode(QString::number(params->dontCareW));
     fitDontCare.appendChild(dontCareText);
 
     QDomElement fitOverLearn = doc.createElement("OverLearnW");
     fit.appendChild(fitOverLearn);
-    QDomText overLearnText = doc.createTextNode(QString::number(sysParams.getOverLearnW()));
+    QDomText overLearnText = doc.createTextNode(QString::number(params->overLearnW));
     fitOverLearn.appendChild(overLearnText);
     // FIN - MODIF - BUJARD Alexandre - 16.04.2010
 
@@ -1313,7 +1532,7 @@ void FuzzySystem::saveToFile(QString fileName, float fitVal)
     for (int i = 0; i < this->nbOutVars; i++) {
         QDomElement var = doc.createElement("Thresh");
         fitThresh.appendChild(var);
-        QDomText threshText = doc.createTextNode(QString::number(sysParams.getThresholdVal(i)));
+        QDomText threshText = doc.createTextNode(QString::number(params->getThresholdVal(i)));
         var.appendChild(threshText);
     }
 
@@ -1436,7 +1655,12 @@ int FuzzySystem::getVarIndex(QString name)
     throw;
 }
 
-void FuzzySystem::loadFromFile(QString fileName)
+/**
+  * Load the variables, the memberships and the rules of a system saved by saveToFile().
+  *
+  * @return false if the file cannot be read or is not valid XML
+  */
+bool FuzzySystem::loadFromFile(QString fileName)
 {
 
     SystemParameters& sysParams = SystemParameters::getInstance();
@@ -1448,12 +1672,12 @@ void FuzzySystem::loadFromFile(QString fileName)
     QFile file(fileName);
 
     if (!file.open(QIODevice::ReadOnly))
-        return;
+        return false;
 
     if (!doc.setContent(&file, false, &errorMsg, &errorLine, &errorColumn)) {
         std::cout << errorMsg.toStdString() << " " <<  errorLine << " " << errorColumn << std::endl;
         file.close();
-        return;
+        return false;
     }
     file.close();
 
@@ -1522,6 +1746,8 @@ void FuzzySystem::loadFromFile(QString fileName)
     // Retrieve the number of rules and create an empty rules array
     nbRules = nodesRules.size();
     rulesArray = new FuzzyRule*[nbRules];
+    arrRuleFired.fill(0, nbRules);
+    arrRuleWinner.fill(0, nbRules);
     // Create an empty default rule array
     defaultRulesSets.resize(nbOutVars);
     // Retrieve the rules
@@ -1551,7 +1777,7 @@ void FuzzySystem::loadFromFile(QString fileName)
         ruleGen->readGenomeIntString(intString.data(), intStringSize);
 
         // Create the rule
-        rulesArray[i] = new FuzzyRule(inVarArray, outVarArray, ruleGen);
+        rulesArray[i] = new FuzzyRule(inVarArray, outVarArray, ruleGen, nbInVars, nbOutVars, sysParams.getFixedVars());
         // Update the system description
         systemDescription.append(rulesArray[i]->getDescription());
         systemDescription.append("\n");
@@ -1638,6 +1864,7 @@ void FuzzySystem::loadFromFile(QString fileName)
 
     rulesLoaded = true;
     membershipsLoaded = true;
+    return true;
 }
 
 
@@ -46,10 +46,13 @@
 #include <QMutex>
 #include <QMutexLocker>
 
+#include "evaluationparameters.h"
 #include "fuzzyset.h"
+#include "numericdataset.h"
 #include "systemparameters.h"
 #include "assert.h"
 #include "coevstats.h"
+#include "workstealingpool.h"
 
 #include "fuzzyvariable.h"
 #include "fuzzyrule.h"
@@ -68,11 +71,21 @@ public:
     void setParameters(int nbRules, int nbVarPerRule, int nbOutVars, int nbInSets, int nbOutSets, int inVarsCodeSize,
                          int outVarsCodeSize, int inSetsCodeSize, int outSetsCodeSize, int inSetsPosCodeSize, int outSetsPosCodeSize);
 
+    FuzzySystem* createEvaluationCopy(const NumericDataset *replica = NULL);
+    FuzzySystem* createDatasetCopy(QList<QStringList>* otherData);
+    void setEvaluationParameters(const EvaluationParameters *params);
+    const EvaluationParameters *getEvaluationParameters();
     void loadData(QList<QStringList>* systemData);
+    QList<QStringList>* getSystemData();
+    inline const NumericDataset *getDataset() const {return dataset;}
     void loadRulesGenome(FuzzyRuleGenome** ruleGenArray, int* defaultRuleSet);
     void loadMembershipsGenome(FuzzyMembershipsGenome* membGen);
+    void computeMembershipsPositions(FuzzyMembershipsGenome* membGen, QVector<float>* positions);
+    void loadMembershipsPositions(const QVector<float>& positions);
+    void setSampleShards(WorkStealingPool *pool, int count);
     float evaluateFitness();
     QVector<float> doEvaluateFitness();
+    void predict(const NumericDataset *samples, float *defuzzed);
     void reset();
     int getNbRules();
     int getNbVarPerRule();
@@ -131,6 +144,9 @@ public:
 
 private:
     QList<QStringList>* systemData;
+    // Parsed values of systemData, shared by the evaluation copies unless given a replica
+    const NumericDataset *dataset;
+    bool ownsDataset;
     QString systemDescription;
     FuzzyVariable** inVarArray;
     FuzzyVariable** outVarArray;
@@ -184,16 +200,32 @@ private:
     float maxActualValue;
     float dontCare;
     float overLearn;
-    int* arrRuleFired; // chaque case correspond aux nombre de fois ou la règle est enclenché pour un certain dataSet
-    int* arrRuleWinner; // chaque case correspond aux nombre de fois ou la règle est la gagnante
+    QVector<int> arrRuleFired; // chaque case correspond aux nombre de fois ou la règle est enclenché pour un certain dataSet
+    QVector<int> arrRuleWinner; // chaque case correspond aux nombre de fois ou la règle est la gagnante
+    QVector<float> maxFiredRule; // per sample scratch buffer used by evaluateSample()
+    // True when systemDescription matches the loaded rules, it is built on demand otherwise
+    bool descriptionValid;
     //les min et max et chaque sortie. outMinMax[sortie][0] pour le min et outMinMax[sortie][1] pour le max.
     double** outMinMax;
     float maxFireLevel;
 
     QHash<QString, int> hashVar; //var name map position of var in dataSet
 
+    // Parameters of the run evaluating this system, not owned. NULL for the systems of the
+    // GUI, which follow the system parameters through ownParams.
+    const EvaluationParameters *evalParams;
+    EvaluationParameters ownParams;
+
+    // Copies of the system evaluating contiguous ranges of the samples on shardPool. The
+    // genome loading functions are forwarded to them, empty to evaluate all the samples here.
+    class ShardJob;
+    QVector<FuzzySystem*> shards;
+    WorkStealingPool *shardPool;
+
     void detectVarUniverses(universeBounds* varUniArray);
-    void evaluateSample(int sampleNum);
+    void evaluateSample(int sampleNum, const EvaluationParameters *params);
+    void evaluateSampleRange(int begin, int end, const EvaluationParameters *params, float *defuzzed);
+    void evaluateShards(const EvaluationParameters *params);
     int getVarIndex(QString name);
     int getVarInDataset(const QString name);
 
@@ -221,9 +253,14 @@ private:
         float sumDistAbove; /* used to compute MDM */
     } fitnessStruct;
 
+    // Per output scratch buffer reused by every evaluateFitness() call
+    QVector<fitnessStruct> fitVector;
+
+    void buildSystemDescription();
+
 public slots:
     void saveToFile(QString fileName, float fitness);
-    void loadFromFile(QString fileName);
+    bool loadFromFile(QString fileName);
 
 signals:
     void fitnessThreshReached();
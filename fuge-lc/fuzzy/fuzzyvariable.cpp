@@ -289,9 +289,8 @@ double FuzzyVariable::defuzz(int)
         return defuzzValue;
 #endif
 
-        DefuzzMethod* defuzzMethod = new DefuzzMethodSingleton();
-        defuzzValue =  defuzzMethod->defuzzVariable(this);
-        delete defuzzMethod;
+        DefuzzMethodSingleton defuzzMethod;
+        defuzzValue =  defuzzMethod.defuzzVariable(this);
 
 
         return defuzzValue;
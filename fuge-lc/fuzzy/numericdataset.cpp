@@ -0,0 +1,52 @@
+/**
+  * @file   numericdataset.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  *
+  * @class NumericDataset
+  * @brief The values of a dataset, parsed once for the evaluation of the fuzzy systems.
+  */
+
+#include "numericdataset.h"
+
+/**
+  * Parse all the values of a dataset.
+  *
+  * @param systemData Dataset, the first row holds the names of the columns
+  */
+NumericDataset::NumericDataset(const QList<QStringList> *systemData) :
+    sampleCount(systemData->size() - 1), columnCount(systemData->at(0).size())
+{
+    values.resize((size_t) sampleCount * columnCount, 0.0);
+    missing.resize((size_t) sampleCount * columnCount, 1);
+    for (int k = 0; k < sampleCount; k++) {
+        const QStringList &row = systemData->at(k+1);
+        const int size = qMin(row.size(), columnCount);
+        for (int i = 0; i < size; i++) {
+            bool isOk;
+            const float value = row.at(i).toFloat(&isOk);
+            if (isOk) {
+                values[k*columnCount + i] = value;
+                missing[k*columnCount + i] = 0;
+            }
+        }
+    }
+}
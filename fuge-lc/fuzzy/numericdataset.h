@@ -0,0 +1,59 @@
+/**
+  * @file   numericdataset.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  *
+  * @class NumericDataset
+  * @brief The values of a dataset, parsed once for the evaluation of the fuzzy systems.
+  *
+  * Sample k is row k+1 of the dataset and a column has the index it has in the dataset,
+  * the first one being the name of the sample. The values that are not numeric are
+  * flagged as missing. The dataset is never modified once built, any number of fuzzy
+  * systems may share it. Copying it makes a replica whose memory belongs to the node of
+  * the copying thread.
+  */
+
+#ifndef NUMERICDATASET_H
+#define NUMERICDATASET_H
+
+#include <QList>
+#include <QStringList>
+#include <vector>
+
+class NumericDataset
+{
+public:
+    NumericDataset(const QList<QStringList> *systemData);
+
+    inline int getSampleCount() const {return sampleCount;}
+    inline int getColumnCount() const {return columnCount;}
+    inline bool isMissing(int sample, int column) const {return missing[sample*columnCount + column] != 0;}
+    inline float getValue(int sample, int column) const {return values[sample*columnCount + column];}
+
+private:
+    int sampleCount;
+    int columnCount;
+    // std::vector rather than QVector, a copy must own its memory to be a replica
+    std::vector<float> values;
+    std::vector<char> missing;
+};
+
+#endif // NUMERICDATASET_H
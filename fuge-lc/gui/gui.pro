@@ -0,0 +1,47 @@
+# FUGE-LC, the application with its main window, linked to the core library
+
+TARGET = FUGE-LC
+TEMPLATE = app
+
+QT += core gui widgets xml network
+
+include(../core/core.pri)
+include(../Dependencies/qwt/qwt.pri)
+
+SOURCES += ../main.cpp \
+    ../fugemain.cpp \
+    ../aboutdialog.cpp \
+    ../errordialog.cpp \
+    ../fuzzymembershipssingle.cpp \
+    ../statsplot.cpp \
+    ../statsseries.cpp \
+    ../editparamsdialog.cpp \
+    ../evalplot.cpp \
+    ../infodialog.cpp \
+    ../fuzzyeditor.cpp \
+    ../helpdialog.cpp
+
+HEADERS += ../fugemain.h \
+    ../aboutdialog.h \
+    ../errordialog.h \
+    ../fuzzymembershipssingle.h \
+    ../statsplot.h \
+    ../statsseries.h \
+    ../editparamsdialog.h \
+    ../evalplot.h \
+    ../infodialog.h \
+    ../fuzzyeditor.h \
+    ../helpdialog.h
+
+FORMS += ../fugemain.ui \
+    ../aboutdialog.ui \
+    ../errordialog.ui \
+    ../statsplot.ui \
+    ../editparamsdialog.ui \
+    ../evalplot.ui \
+    ../infodialog.ui \
+    ../evalplotframe.ui \
+    ../fuzzyeditor.ui \
+    ../helpdialog.ui
+
+RESOURCES += ../fuzzyResources.qrc
@@ -5,7 +5,11 @@ DEPENDPATH += $$PWD
 
 INCLUDEPATH += $$PWD/EvolutionEngine
 
-SOURCES += $$PWD/evolutionengine.cpp
+SOURCES += $$PWD/evolutionengine.cpp \
+    $$PWD/speciesscheduler.cpp \
+    $$PWD/migrationhub.cpp
 
-HEADERS += $$PWD/evolutionengine.h
+HEADERS += $$PWD/evolutionengine.h \
+    $$PWD/speciesscheduler.h \
+    $$PWD/migrationhub.h
 
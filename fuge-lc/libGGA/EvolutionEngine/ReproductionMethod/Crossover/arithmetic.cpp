@@ -1,5 +1,73 @@
 #include "arithmetic.h"
+#include <numeric>
 
 Arithmetic::Arithmetic() : Crossover()
 {
 }
+
+/**
+ * Append count fields of fieldSize bits to the layout of the genotype.
+ */
+void Arithmetic::addFields(quint32 count, quint32 fieldSize)
+{
+    fieldSizes.insert(fieldSizes.end(), count, fieldSize);
+    values1.resize(fieldSizes.size());
+    values2.resize(fieldSizes.size());
+}
+
+void Arithmetic::decode(const QBitArray *genotype, vector<float> &values)
+{
+    int bitIndex = 0;
+    for(quint32 f = 0; f < fieldSizes.size(); f++){
+        quint32 value = 0;
+        for(quint32 l = 0; l < fieldSizes[f]; l++, bitIndex++){
+            if(genotype->testBit(bitIndex))
+                value |= 1u << l;
+        }
+        values[f] = value;
+    }
+}
+
+void Arithmetic::encode(const vector<float> &values, QBitArray *genotype)
+{
+    int bitIndex = 0;
+    for(quint32 f = 0; f < fieldSizes.size(); f++){
+        // The blend of two fields always fits in the field, only round it
+        const quint32 value = (quint32)(values[f] + 0.5f);
+        for(quint32 l = 0; l < fieldSizes[f]; l++, bitIndex++)
+            genotype->setBit(bitIndex, (value >> l) & 1);
+    }
+}
+
+void Arithmetic::reproducePairOf(vector<PopEntity *> &pairOfEntityList, qreal probability){
+
+    const quint32 nbFields = fieldSizes.size();
+
+    for(quint32 i = 0; i + 1 < pairOfEntityList.size(); i+=2)
+    {
+        qreal entitiyLuck = RandomGenerator::getGeneratorInstance()->randomReal(0,1);
+
+        //  if goal < chance OK.
+        if(entitiyLuck < probability && nbFields > 0){
+            QBitArray *g1 = pairOfEntityList.at(i)->getGenotype()->getData();
+            QBitArray *g2 = pairOfEntityList.at(i+1)->getGenotype()->getData();
+            Q_ASSERT(accumulate(fieldSizes.begin(), fieldSizes.end(), 0u) <= (quint32)g1->size());
+            decode(g1, values1);
+            decode(g2, values2);
+
+            const float a = RandomGenerator::getGeneratorInstance()->randomReal(0,1);
+            float *v1 = &values1[0];
+            float *v2 = &values2[0];
+            // Plain loop over contiguous arrays, the compiler can vectorize it
+            for(quint32 f = 0; f < nbFields; f++){
+                const float x = v1[f];
+                const float y = v2[f];
+                v1[f] = a * x + (1.0f - a) * y;
+                v2[f] = (1.0f - a) * x + a * y;
+            }
+
+            encode(values1, g1);
+            encode(values2, g2);
+        }
+    }
+}
@@ -23,18 +23,35 @@
  * @class Artihmetic
  * @brief An arithmetic crossover
  *
- * TODO FULLDESC
+ * The genotype is read as a sequence of unsigned integer fields, stored least
+ * significant bit first, described with addFields(). Each pair of parents is
+ * replaced by two blends of their fields, c1 = a*p1 + (1-a)*p2 and
+ * c2 = (1-a)*p1 + a*p2, with a drawn uniformly in [0,1] for the pair. The bits
+ * following the last field are left untouched.
  */
 
 #ifndef ARITHMETIC_H
 #define ARITHMETIC_H
 
 #include "crossover.h"
+#include "Utility/randomgenerator.h"
 
 class Arithmetic : public Crossover
 {
 public:
     Arithmetic();
+    void addFields(quint32 count, quint32 fieldSize);
+    void reproducePairOf(vector<PopEntity *> &pairOfEntityList, qreal probability);
+
+private:
+    void decode(const QBitArray *genotype, vector<float> &values);
+    void encode(const vector<float> &values, QBitArray *genotype);
+
+    // Size in bits of each field, in genotype order
+    vector<quint32> fieldSizes;
+    // Decoded fields of the two parents, reused between pairs.
+    vector<float> values1;
+    vector<float> values2;
 };
 
 #endif // ARITHMETIC_H
@@ -1,5 +1,27 @@
 #include "crossover.h"
+#include "qbitarrayutility.h"
 
 Crossover::Crossover()
 {
 }
+
+Crossover::~Crossover()
+{
+}
+
+/**
+ * Exchange between g1 and g2 the bits set in mask.
+ *
+ * Works with whole array operators, which process the bits a byte at a time
+ * instead of testing and toggling them one by one.
+ */
+void Crossover::exchangeBits(QBitArray *g1, QBitArray *g2, const QBitArray &mask)
+{
+    if(difference.size() != g1->size())
+        difference.resize(g1->size());
+    QBitArrayUtility::copyBits(&difference, g1);
+    difference ^= *g2;
+    difference &= mask;
+    *g1 ^= difference;
+    *g2 ^= difference;
+}
@@ -36,7 +36,14 @@ class Crossover
 {
 public:
     Crossover();
-    virtual void reproducePairOf(vector<PopEntity *> pairOfEntityList, qreal probability) = 0;
+    virtual ~Crossover();
+    virtual void reproducePairOf(vector<PopEntity *> &pairOfEntityList, qreal probability) = 0;
+
+protected:
+    void exchangeBits(QBitArray *g1, QBitArray *g2, const QBitArray &mask);
+
+    // Scratch buffer of exchangeBits(), reused between pairs.
+    QBitArray difference;
 };
 
 #endif // CROSSOVER_H
@@ -4,29 +4,26 @@ OnePoint::OnePoint() : Crossover()
 {
 }
 
-void OnePoint::reproducePairOf(vector<PopEntity *> pairOfEntityList, qreal probability){
+void OnePoint::reproducePairOf(vector<PopEntity *> &pairOfEntityList, qreal probability){
 
-    for(quint32 i = 0; i < pairOfEntityList.size()-1; i+=2)
+    for(quint32 i = 0; i + 1 < pairOfEntityList.size(); i+=2)
     {
         int j=i+1; // Second entity
         qreal entitiyLuck = RandomGenerator::getGeneratorInstance()->randomReal(0,1);
 
         //  if goal < chance OK.
         if(entitiyLuck < probability){
+            QBitArray *g1 = pairOfEntityList.at(i)->getGenotype()->getData();
+            QBitArray *g2 = pairOfEntityList.at(j)->getGenotype()->getData();
             // Never exchange the whole genotype, must be at least 1bit of the other part.
-            QBitArray *temp = pairOfEntityList.at(i)->getGenotype()->getDataCopy();
-            quint32 cutPoint = RandomGenerator::getGeneratorInstance()->random(1,temp->size()-2);
+            quint32 cutPoint = RandomGenerator::getGeneratorInstance()->random(1,g1->size()-2);
 
-            for(quint32 k = cutPoint; k < pairOfEntityList.at(i)->getGenotype()->getLength()-1; k++)
-            {
-                //G2 cut go to temp
-                temp->setBit(k,pairOfEntityList.at(j)->getGenotype()->getData()->at(k));
-                //G1 cut go to G2
-                pairOfEntityList.at(j)->getGenotype()->getData()->setBit(k, pairOfEntityList.at(i)->getGenotype()->getData()->at(k));
-                //temp cut go to G1
-                pairOfEntityList.at(i)->getGenotype()->getData()->setBit(k, temp->at(k));
-            }
-            delete temp;
+            // Swap the tails in place
+            if(mask.size() != g1->size())
+                mask.resize(g1->size());
+            mask.fill(false);
+            mask.fill(true, cutPoint, pairOfEntityList.at(i)->getGenotype()->getLength()-1);
+            exchangeBits(g1, g2, mask);
         }
 
     }
@@ -35,7 +35,11 @@ class OnePoint : public Crossover
 {
 public:
     OnePoint();
-    void reproducePairOf(vector<PopEntity *> pairOfEntityList, qreal probability);
+    void reproducePairOf(vector<PopEntity *> &pairOfEntityList, qreal probability);
+
+private:
+    // Tail selected by the cut point, reused between pairs.
+    QBitArray mask;
 };
 
 #endif // ONEPOINT_H
@@ -3,3 +3,32 @@
 Uniform::Uniform() : Crossover()
 {
 }
+
+void Uniform::reproducePairOf(vector<PopEntity *> &pairOfEntityList, qreal probability){
+
+    RandomGenerator *random = RandomGenerator::getGeneratorInstance();
+    for(quint32 i = 0; i + 1 < pairOfEntityList.size(); i+=2)
+    {
+        qreal entitiyLuck = random->randomReal(0,1);
+
+        //  if goal < chance OK.
+        if(entitiyLuck < probability){
+            QBitArray *g1 = pairOfEntityList.at(i)->getGenotype()->getData();
+            QBitArray *g2 = pairOfEntityList.at(i+1)->getGenotype()->getData();
+            const int size = g1->size();
+            if(mask.size() != size)
+                mask.resize(size);
+
+            // One random word gives the next 64 bits of the mask
+            for(int k = 0; k < size; k += 64){
+                quint64 word = random->randomWord();
+                const int end = qMin(size, k + 64);
+                for(int bit = k; bit < end; bit++){
+                    mask.setBit(bit, word & 1);
+                    word >>= 1;
+                }
+            }
+            exchangeBits(g1, g2, mask);
+        }
+    }
+}
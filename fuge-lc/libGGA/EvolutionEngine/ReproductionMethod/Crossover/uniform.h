@@ -23,18 +23,27 @@
  * @class Uniform
  * @brief A uniform crossover
  *
- * TODO FULLDESC
+ * Every bit is taken from one parent or the other with the same probability.
+ * The random mask is filled from 64 bit words of RandomGenerator, so a pair
+ * costs one random word per 64 bits of genotype and the exchange itself works
+ * on whole arrays.
  */
 
 #ifndef UNIFORM_H
 #define UNIFORM_H
 
 #include "crossover.h"
+#include "Utility/randomgenerator.h"
 
 class Uniform : public Crossover
 {
 public:
     Uniform();
+    void reproducePairOf(vector<PopEntity *> &pairOfEntityList, qreal probability);
+
+private:
+    // Random exchange mask, reused between pairs.
+    QBitArray mask;
 };
 
 #endif // UNIFORM_H
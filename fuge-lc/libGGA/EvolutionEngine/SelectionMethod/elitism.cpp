@@ -5,19 +5,13 @@ Elitism::Elitism() :
 {
 }
 
-inline bool entityLesserThan(PopEntity* a, PopEntity* b){
-    return a->getFitness() < b->getFitness();
-}
-
-vector<PopEntity *> Elitism::selectEntities(quint32 quantity, vector<PopEntity *> entityList)
+void Elitism::selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected)
 {
-    vector<PopEntity *> selectedEntities;
-    sort(entityList.begin(), entityList.end(), entityLesserThan);
+    selected.clear();
+    // Only the quantity best entities need to be ordered
+    partitionByFitness(quantity, entityList);
 
-    for(quint32 i=entityList.size()-1; i > entityList.size()-1-quantity; i--){
-        selectedEntities.push_back(entityList.at(i));
+    for(quint32 i = 0; i < quantity && i < order.size(); i++){
+        selected.push_back(order[i]);
     }
-
-    return selectedEntities;
-
 }
@@ -9,7 +9,7 @@ class Elitism : public EntitySelection
 {
 public:
     Elitism();
-    vector<PopEntity *> selectEntities(quint32 quantity, vector<PopEntity *> entityList);
+    void selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected);
 };
 
 #endif // ELITISM_H
@@ -4,21 +4,19 @@ ElitismWithRandom::ElitismWithRandom():
     EntitySelection()
 {
 }
-inline bool entityLesserThan(PopEntity* a, PopEntity* b){
-    return a->getFitness() < b->getFitness();
-}
-vector<PopEntity *> ElitismWithRandom::selectEntities(quint32 quantity, vector<PopEntity *> entityList)
+
+void ElitismWithRandom::selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected)
 {
-    vector<PopEntity *> selectedEntities;
-    sort(entityList.begin(), entityList.end(), entityLesserThan);
+    selected.clear();
+    if(quantity == 0)
+        return;
+    partitionByFitness(quantity - 1, entityList);
 
-    for(quint32 i=entityList.size()-1; i > entityList.size()-quantity; i--){
-        selectedEntities.push_back(entityList.at(i));
+    // quantity-1 best entities and a random one
+    for(quint32 i = 0; i + 1 < quantity && i < order.size(); i++){
+        selected.push_back(order[i]);
     }
 
     int pos = RandomGenerator::getGeneratorInstance()->random(0,entityList.size()-1);
-    selectedEntities.push_back(entityList.at(pos));
-
-    return selectedEntities;
-
+    selected.push_back(pos);
 }
@@ -7,7 +7,7 @@ class ElitismWithRandom : public EntitySelection
 {
 public:
     ElitismWithRandom();
-    vector<PopEntity *> selectEntities(quint32 quantity, vector<PopEntity *> entityList);
+    void selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected);
 };
 
 #endif // ELITISMWITHRANDOM_H
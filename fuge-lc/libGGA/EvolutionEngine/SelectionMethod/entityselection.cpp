@@ -1,5 +1,135 @@
 #include "entityselection.h"
+#include "proportionalselection.h"
+#include "rankbasedselection.h"
+#include "roulettewheel.h"
+#include "selectionpressure.h"
+#include "tournamentselection.h"
+#include "truncatedrankbasedselection.h"
+
+namespace {
+EntitySelection *createRank(qreal parameter)
+{
+    return parameter > 1.0 ? (EntitySelection *)new SelectionPressure(parameter) : new RankBasedSelection();
+}
+
+EntitySelection *createTournament(qreal parameter)
+{
+    return new TournamentSelection(parameter >= 1.0 ? (quint32)parameter : 2);
+}
+
+EntitySelection *createSus(qreal)
+{
+    return new ProportionalSelection();
+}
+
+EntitySelection *createRoulette(qreal)
+{
+    return new RouletteWheel();
+}
+
+EntitySelection *createTruncation(qreal parameter)
+{
+    return new TruncatedRankBasedSelection(parameter > 0.0 && parameter <= 1.0 ? parameter : 0.5);
+}
+
+// The selection methods known by name, the only list of them
+const struct {
+    const char *name;
+    EntitySelection *(*create)(qreal parameter);
+} SELECTION_METHODS[] = {
+    {"rank", createRank},
+    {"tournament", createTournament},
+    {"sus", createSus},
+    {"roulette", createRoulette},
+    {"truncation", createTruncation}
+};
+const int SELECTION_METHOD_COUNT = sizeof(SELECTION_METHODS) / sizeof(SELECTION_METHODS[0]);
+
+struct FitnessGreaterThan {
+    const vector<PopEntity *> &entityList;
+    FitnessGreaterThan(const vector<PopEntity *> &entityList) : entityList(entityList) {}
+    bool operator()(quint32 a, quint32 b) const {
+        return entityList[a]->getFitness() > entityList[b]->getFitness();
+    }
+};
+}
 
 EntitySelection::EntitySelection()
 {
 }
+
+EntitySelection::~EntitySelection()
+{
+}
+
+EntitySelection *EntitySelection::fromName(const QString &name, qreal parameter)
+{
+    for(int i = 0; i < SELECTION_METHOD_COUNT; i++){
+        if(name == SELECTION_METHODS[i].name)
+            return SELECTION_METHODS[i].create(parameter);
+    }
+    return NULL;
+}
+
+/**
+  * Return true if fromName() knows name.
+  */
+bool EntitySelection::isKnownName(const QString &name)
+{
+    for(int i = 0; i < SELECTION_METHOD_COUNT; i++){
+        if(name == SELECTION_METHODS[i].name)
+            return true;
+    }
+    return false;
+}
+
+/**
+  * Convenience wrapper returning the selected entities instead of their positions.
+  */
+vector<PopEntity *> EntitySelection::selectEntities(quint32 quantity, vector<PopEntity *> entityList)
+{
+    vector<quint32> selected;
+    vector<PopEntity *> selectedEntities;
+    selectIndices(quantity, entityList, selected);
+    for(quint32 i = 0; i < selected.size(); i++)
+        selectedEntities.push_back(entityList.at(selected[i]));
+    return selectedEntities;
+}
+
+/**
+  * Fill order with the positions of the entities so that its first count elements
+  * are the count best entities, best fitness first if sorted is true. The rest is
+  * left unordered.
+  *
+  * Runs in O(n + count log count), or O(n) when not sorted, instead of the
+  * O(n log n) of a full sort.
+  */
+void EntitySelection::partitionByFitness(quint32 count, const vector<PopEntity *> &entityList, bool sorted)
+{
+    order.resize(entityList.size());
+    for(quint32 i = 0; i < order.size(); i++)
+        order[i] = i;
+    if(count >= order.size()){
+        if(sorted)
+            sort(order.begin(), order.end(), FitnessGreaterThan(entityList));
+        return;
+    }
+    if(count == 0)
+        return;
+    nth_element(order.begin(), order.begin() + count, order.end(), FitnessGreaterThan(entityList));
+    if(sorted)
+        sort(order.begin(), order.begin() + count, FitnessGreaterThan(entityList));
+}
+
+/**
+  * Shuffle the selected positions in place, so that the parents paired by the
+  * crossover do not depend on their position in the population.
+  */
+void EntitySelection::shuffle(vector<quint32> &selected)
+{
+    RandomGenerator *random = RandomGenerator::getGeneratorInstance();
+    for(quint32 i = selected.size(); i > 1; i--){
+        quint32 j = random->random(0, i - 1);
+        std::swap(selected[i - 1], selected[j]);
+    }
+}
@@ -4,6 +4,7 @@
 #include <vector>
 #include <Qt>
 #include <QList>
+#include <QString>
 
 #include "popentity.h"
 #include <algorithm>
@@ -13,9 +14,37 @@ class EntitySelection
 {
 public:
     EntitySelection();
-    virtual vector<PopEntity *> selectEntities(quint32 quantity, vector<PopEntity *> entityList) = 0;
-private:
+    virtual ~EntitySelection();
+    /**
+      * Select quantity entities of the list.
+      *
+      * The positions of the selected entities in entityList are written into selected,
+      * which is cleared first. Implementations must not allocate once selected and their
+      * own scratch buffers reached their final size.
+      */
+    virtual void selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected) = 0;
+    vector<PopEntity *> selectEntities(quint32 quantity, vector<PopEntity *> entityList);
 
+    /**
+      * Create the selection method registered under name.
+      *
+      * Known names are "rank", "tournament", "sus", "roulette" and "truncation".
+      * parameter is the selection pressure for "rank", between 1 and 2, the
+      * tournament size for "tournament" and the kept ratio of the population for
+      * "truncation", it is ignored by the other methods. Without a pressure, "rank"
+      * keeps the selection of the original implementation.
+      *
+      * @return the new selection method, NULL if the name is unknown.
+      */
+    static EntitySelection *fromName(const QString &name, qreal parameter);
+    static bool isKnownName(const QString &name);
+
+protected:
+    void partitionByFitness(quint32 count, const vector<PopEntity *> &entityList, bool sorted = true);
+    void shuffle(vector<quint32> &selected);
+
+    // Scratch buffer holding the positions of the entities, reused between generations.
+    vector<quint32> order;
 };
 
 #endif // ENTITYSELECTION_H
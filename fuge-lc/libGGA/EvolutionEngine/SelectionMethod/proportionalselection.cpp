@@ -3,3 +3,40 @@
 ProportionalSelection::ProportionalSelection() : EntitySelection()
 {
 }
+
+void ProportionalSelection::selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected)
+{
+    selected.clear();
+    if(entityList.empty() || quantity == 0)
+        return;
+
+    RandomGenerator *random = RandomGenerator::getGeneratorInstance();
+    const quint32 size = entityList.size();
+
+    qreal total = 0.0;
+    for(quint32 i = 0; i < size; i++)
+        total += qMax<qreal>(0.0, entityList[i]->getFitness());
+
+    // Without any positive fitness every entity gets the same share of the wheel
+    if(total <= 0.0){
+        for(quint32 q = 0; q < quantity; q++)
+            selected.push_back(random->random(0, size-1));
+        return;
+    }
+
+    const qreal step = total / quantity;
+    qreal pointer = random->randomReal(0.0, step);
+    qreal cumulated = qMax<qreal>(0.0, entityList[0]->getFitness());
+    quint32 pos = 0;
+    for(quint32 q = 0; q < quantity; q++){
+        while(cumulated <= pointer && pos < size - 1){
+            pos++;
+            cumulated += qMax<qreal>(0.0, entityList[pos]->getFitness());
+        }
+        selected.push_back(pos);
+        pointer += step;
+    }
+
+    // The sampling visits the population in order, mix the parents before pairing them
+    shuffle(selected);
+}
@@ -3,10 +3,18 @@
 
 #include "entityselection.h"
 
+/**
+  * Fitness proportional selection by stochastic universal sampling.
+  *
+  * A single random offset places quantity equally spaced pointers on the fitness
+  * wheel, so the number of copies of an entity never differs from its expected
+  * value by more than one. Runs in O(n + quantity).
+  */
 class ProportionalSelection : public EntitySelection
 {
 public:
     ProportionalSelection();
+    void selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected);
 };
 
 #endif // PROPORTIONALSELECTION_H
@@ -4,31 +4,22 @@ RankBasedSelection::RankBasedSelection() : EntitySelection()
 {
 }
 
-vector<PopEntity *> RankBasedSelection::selectEntities(quint32 quantity, vector<PopEntity *> entityList)
+void RankBasedSelection::selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected)
 {
     // THERE IS A SMALL CHANCE, that we get multiple copy of the same individual.
 
-    vector<PopEntity *> selectedEntities;
+    selected.clear();
+    if(entityList.empty())
+        return;
 
-    PopEntity *tempEntity;
-    quint32 pos;
-    qreal bestfitness;
-    qreal fitness;
-    for(quint32 q = 0; q < quantity; q++){
-        bestfitness = 0.0;
-        for(quint32 i = 0; i < entityList.size()/10; i++){
-            pos = RandomGenerator::getGeneratorInstance()->random(0,entityList.size()-1);
-            tempEntity = entityList.at(pos);
-            fitness = tempEntity->getFitness();
-
-            if(fitness > bestfitness){
-                bestfitness = fitness;
-                tempEntity = entityList.at(pos);
-            }
-        }
-        selectedEntities.push_back(tempEntity);
+    // The group of a tenth of the population is empty, the first entity is kept
+    if(entityList.size() < 10){
+        for(quint32 q = 0; q < quantity; q++)
+            selected.push_back(0);
+        return;
     }
 
-    return selectedEntities;
-
+    RandomGenerator *random = RandomGenerator::getGeneratorInstance();
+    for(quint32 q = 0; q < quantity; q++)
+        selected.push_back(random->random(0,entityList.size()-1));
 }
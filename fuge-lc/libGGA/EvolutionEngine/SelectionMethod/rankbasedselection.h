@@ -3,12 +3,20 @@
 
 #include "entityselection.h"
 
+/**
+  * Selection of the original implementation, kept as the default.
+  *
+  * Each entity was the last one of a group of a tenth of the population drawn at
+  * random, and the first entity for populations under ten. Only the last draw of a
+  * group decides, so a single draw gives the same selection in O(quantity). See
+  * SelectionPressure for a selection by rank.
+  */
 class RankBasedSelection : public EntitySelection
 {
 public:
     RankBasedSelection();
 
-    vector<PopEntity *> selectEntities(quint32 quantity, vector<PopEntity *> entityList);
+    void selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected);
 };
 
 #endif // RANKBASEDSELECTION_H
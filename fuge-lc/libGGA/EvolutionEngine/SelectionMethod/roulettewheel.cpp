@@ -3,3 +3,30 @@
 RouletteWheel::RouletteWheel() : EntitySelection()
 {
 }
+
+void RouletteWheel::selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected)
+{
+    selected.clear();
+    if(entityList.empty())
+        return;
+
+    RandomGenerator *random = RandomGenerator::getGeneratorInstance();
+    const quint32 size = entityList.size();
+
+    wheel.resize(size);
+    qreal total = 0.0;
+    for(quint32 i = 0; i < size; i++){
+        total += qMax<qreal>(0.0, entityList[i]->getFitness());
+        wheel[i] = total;
+    }
+
+    for(quint32 q = 0; q < quantity; q++){
+        if(total <= 0.0){
+            selected.push_back(random->random(0, size-1));
+            continue;
+        }
+        const qreal spin = random->randomReal(0.0, total);
+        quint32 pos = upper_bound(wheel.begin(), wheel.end(), spin) - wheel.begin();
+        selected.push_back(qMin(pos, size - 1));
+    }
+}
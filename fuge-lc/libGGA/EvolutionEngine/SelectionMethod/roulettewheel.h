@@ -3,10 +3,21 @@
 
 #include "entityselection.h"
 
+/**
+  * Fitness proportional selection with one independent spin per selected entity.
+  *
+  * The cumulated fitness is computed once per call and each spin is a binary
+  * search in it, O(n + quantity log n).
+  */
 class RouletteWheel : public EntitySelection
 {
 public:
     RouletteWheel();
+    void selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected);
+
+private:
+    // Cumulated fitness of the entities, reused between generations.
+    vector<qreal> wheel;
 };
 
 #endif // ROULETTEWHEEL_H
@@ -1,5 +1,42 @@
 #include "selectionpressure.h"
 
-SelectionPressure::SelectionPressure() : EntitySelection()
+SelectionPressure::SelectionPressure(qreal pressure) : EntitySelection(),
+    pressure(qBound<qreal>(1.0, pressure, 2.0))
 {
 }
+
+void SelectionPressure::selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected)
+{
+    selected.clear();
+    if(entityList.empty() || quantity == 0)
+        return;
+
+    RandomGenerator *random = RandomGenerator::getGeneratorInstance();
+    const quint32 size = entityList.size();
+    if(size == 1){
+        for(quint32 q = 0; q < quantity; q++)
+            selected.push_back(0);
+        return;
+    }
+
+    // order[i] is the entity of rank size - 1 - i, the best one first
+    partitionByFitness(size, entityList);
+
+    // The weights of the ranks sum up to size
+    const qreal slope = 2.0 * (pressure - 1.0) / (size - 1);
+    const qreal step = (qreal)size / quantity;
+    qreal pointer = random->randomReal(0.0, step);
+    qreal cumulated = pressure;
+    quint32 i = 0;
+    for(quint32 q = 0; q < quantity; q++){
+        while(cumulated <= pointer && i < size - 1){
+            i++;
+            cumulated += (2.0 - pressure) + slope * (size - 1 - i);
+        }
+        selected.push_back(order[i]);
+        pointer += step;
+    }
+
+    // The sampling visits the population by rank, mix the parents before pairing them
+    shuffle(selected);
+}
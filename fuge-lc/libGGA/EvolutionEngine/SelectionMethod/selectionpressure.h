@@ -3,10 +3,26 @@
 
 #include "entityselection.h"
 
+/**
+  * Ranking selection with a configurable selection pressure, the weight of an entity
+  * grows linearly with its rank.
+  *
+  * The entities are ranked by a single sort of their fitness. The best entity is
+  * expected to be selected pressure times per population size, the worst one
+  * 2 - pressure times, the others in between linearly with their rank. The
+  * samples are taken by stochastic universal sampling over the ranks. Because of
+  * the sort, the selection takes O(n log n + quantity) time, unlike the linear time
+  * operators : tournament, sus, roulette and truncation.
+  */
 class SelectionPressure : public EntitySelection
 {
 public:
-    SelectionPressure();
+    SelectionPressure(qreal pressure = 1.5);
+    void selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected);
+
+private:
+    // Between 1.0 (uniform) and 2.0 (the worst entity is never selected)
+    qreal pressure;
 };
 
 #endif // SELECTIONPRESSURE_H
@@ -1,18 +1,26 @@
 #include "tournamentselection.h"
 
-TournamentSelection::TournamentSelection() : EntitySelection()
+TournamentSelection::TournamentSelection(quint32 tournamentSize) : EntitySelection(),
+    tournamentSize(qMax<quint32>(1, tournamentSize))
 {
 }
 
- vector<PopEntity *> TournamentSelection::selectEntities(quint32 quantity, vector<PopEntity *> entityList)
- {
-//     uint size = entityList.size();
-//     uint pos, groupSize;
-//     for(uint popI = 0; popI < size; popI){
-//         for(uint i = 0; i < groupSize; i++)
-//         {
-//            pos = RandomGenerator::getGeneratorInstance()->random(0,size-1);
-//         }
-//     }
-     return vector<PopEntity *>();
- }
+void TournamentSelection::selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected)
+{
+    selected.clear();
+    if(entityList.empty())
+        return;
+
+    RandomGenerator *random = RandomGenerator::getGeneratorInstance();
+    const quint32 size = entityList.size();
+    quint32 winner, pos;
+    for(quint32 q = 0; q < quantity; q++){
+        winner = random->random(0, size-1);
+        for(quint32 i = 1; i < tournamentSize; i++){
+            pos = random->random(0, size-1);
+            if(entityList[pos]->getFitness() > entityList[winner]->getFitness())
+                winner = pos;
+        }
+        selected.push_back(winner);
+    }
+}
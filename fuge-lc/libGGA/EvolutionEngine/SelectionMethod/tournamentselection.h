@@ -4,11 +4,18 @@
 #include "entityselection.h"
 #include "Utility/randomgenerator.h"
 
+/**
+  * Each selected entity is the best of tournamentSize entities drawn at random,
+  * with replacement. Costs O(quantity * tournamentSize) whatever the population size.
+  */
 class TournamentSelection : public EntitySelection
 {
 public:
-    TournamentSelection();
-     vector<PopEntity *> selectEntities(quint32 quantity, vector<PopEntity *> entityList);
+    TournamentSelection(quint32 tournamentSize = 2);
+    void selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected);
+
+private:
+    quint32 tournamentSize;
 };
 
 #endif // TOURNAMENTSELECTION_H
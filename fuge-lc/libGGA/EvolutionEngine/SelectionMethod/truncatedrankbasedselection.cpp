@@ -1,5 +1,23 @@
 #include "truncatedrankbasedselection.h"
 
-TruncatedRankBasedSelection::TruncatedRankBasedSelection() : EntitySelection()
+TruncatedRankBasedSelection::TruncatedRankBasedSelection(qreal ratio) : EntitySelection(),
+    ratio(ratio)
 {
 }
+
+void TruncatedRankBasedSelection::selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected)
+{
+    selected.clear();
+    if(entityList.empty())
+        return;
+
+    const quint32 size = entityList.size();
+    const quint32 kept = qBound<quint32>(1, (quint32)(size * ratio), size);
+
+    // Only the boundary of the kept part matters, the order inside it does not
+    partitionByFitness(kept, entityList, false);
+
+    RandomGenerator *random = RandomGenerator::getGeneratorInstance();
+    for(quint32 q = 0; q < quantity; q++)
+        selected.push_back(order[random->random(0, kept-1)]);
+}
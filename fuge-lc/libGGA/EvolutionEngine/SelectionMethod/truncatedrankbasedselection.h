@@ -3,10 +3,18 @@
 
 #include "entityselection.h"
 
+/**
+  * Truncation selection: the entities are drawn uniformly among the best ratio
+  * of the population. The best part is found with a partition, O(n + quantity).
+  */
 class TruncatedRankBasedSelection : public EntitySelection
 {
 public:
-    TruncatedRankBasedSelection();
+    TruncatedRankBasedSelection(qreal ratio = 0.5);
+    void selectIndices(quint32 quantity, const vector<PopEntity *> &entityList, vector<quint32> &selected);
+
+private:
+    qreal ratio;
 };
 
 #endif // TRUNCATEDRANKBASEDSELECTION_H
@@ -1,11 +1,13 @@
 #include "evolutionengine.h"
+#include "logger.h"
 #include "../computethread.h"
 
 QMutex * EvolutionEngine::critMutex = new QMutex();
 
 
 EvolutionEngine::EvolutionEngine(Population *population, quint32 generationCount, qreal crossoverProbability, qreal mutationProbability, qreal mutationPerBitProbability) :
-    population(population), generationCount(generationCount), crossoverProbability(crossoverProbability), mutationProbability(mutationProbability), mutationPerBitProbability(mutationPerBitProbability)
+    population(population), generationCount(generationCount), crossoverProbability(crossoverProbability), mutationProbability(mutationProbability), mutationPerBitProbability(mutationPerBitProbability), migration(0), island(0),
+    saveEngine(0), saveIndex(0), resumeGeneration(0), resumeRandomState(0), genealogy(0), genealogyIndex(0), lineage(0)
 {
     //entitySelectionMethodList.push_back(new Elitism());
     entitySelectionMethodList.push_back(new ElitismWithRandom());
@@ -15,60 +17,94 @@ EvolutionEngine::EvolutionEngine(Population *population, quint32 generationCount
     mutateMethodList.push_back(new Toggling());
 }
 
-void EvolutionEngine::startEvolution(QMutex *leftLock, QMutex *rightLock, quint32 generationCount, EntitySelection *eliteSelection, quint32 eliteSelectionCount, EntitySelection *individualsSelection, quint32 individualsSelectionCount, Mutate *mutateMethod, Crossover *crossoverMethod, quint32 cooperatorsCount)
+void EvolutionEngine::startEvolution(SpeciesScheduler *scheduler, int species, quint32 generationCount, EntitySelection *eliteSelection, quint32 eliteSelectionCount, EntitySelection *individualsSelection, quint32 individualsSelectionCount, Mutate *mutateMethod, Crossover *crossoverMethod, quint32 cooperatorsCount)
 {
-    // TODO: crashes here when run under Qt 5 (but not under Qt 4) because leftLock and rightLock are invalid
-
     setEntitySelector(eliteSelection,eliteSelectionCount,individualsSelection,individualsSelectionCount);
 
     this->mutateMethod = mutateMethod;
     this->crossoverMethod = crossoverMethod;
 
-    rightLock->lock();
-    selectElites();
-    population->setRepresentativesCopy(selectedEntitiesCopy, cooperatorsCount);
-
-    qDebug() << population->getName() << " Before join";
-    // JOIN both evolution
-    leftLock->unlock();
-    rightLock->lock();
-    leftLock->unlock();
+    quint32 first = 1;
+    if(resumeGeneration > 0){
+        // The population and its representatives were restored from a checkpoint
+        RandomGenerator::getGeneratorInstance()->setState(resumeRandomState);
+        first = resumeGeneration + 1;
+    }
+    else{
+        selectElites();
+        population->setRepresentatives(eliteIndices, cooperatorsCount);
 
-    qDebug() << population->getName() << " AFTER join";
-    if(!evaluatePopulation(population, 0))
-        return;
+        // Every species publishes its first representatives before any evaluation
+        scheduler->synchronize(species, 0);
+        if(!evaluatePopulation(population, 0)){
+            scheduler->finish(species);
+            return;
+        }
+        log(0);
+        beginLineage(0, true);
+        endLineage();
+        scheduler->endGeneration(species);
+    }
 
-    for(quint32 i = 1; i <= generationCount; i++)
+    for(quint32 i = first; i <= generationCount; i++)
     {
+        // A resumed run has no archived generation to start from
+        beginLineage(i, i == first && resumeGeneration > 0);
+
         // Select elites from the population
         selectElites();
 
         // Set cooperators
-        population->setRepresentativesCopy(selectedEntitiesCopy, cooperatorsCount);
+        population->setRepresentatives(eliteIndices, cooperatorsCount);
 
         // Select non elite individuals
         selectIndividuals();
 
+        // Copy parents and elites into the back buffer
+        population->breed(parentIndices, eliteIndices);
+
         // Crossover
         crossover();
+        if(lineage != 0)
+            lineage->breed(population, parentIndices, eliteIndices);
 
         // Mutate
         mutate();
-        population->replace(selectedEntitiesCopy, evolvingEntitiesCopy);
+        if(lineage != 0)
+            lineage->diff(population);
+
+        // The offspring become the current generation
+        population->swapBuffers();
+        elitePositions.clear();
+        for(quint32 e = 0; e < eliteIndices.size(); e++)
+            elitePositions.push_back(parentIndices.size() + e);
+
+        // Exchange the best elites with the other islands, the immigrants replace offspring
+        if(migration != 0 && migration->isMigrationGeneration(i)){
+            migration->emigrate(island, species, population->getAllEntities(), elitePositions);
+            const quint32 received = migration->immigrate(island, species, population->getAllEntities(), parentIndices.size());
+            if(lineage != 0)
+                lineage->immigrants(received);
+        }
+
+        // Wait for the other species within the staleness bound, breeding did not need them
+        scheduler->synchronize(species, i);
 
         // Evaluate population
         if(!evaluatePopulation(population, i))
             break;
 
+        log(i);
+        endLineage();
+        checkpoint(i);
+        scheduler->endGeneration(species);
+
 
     }
-    rightLock->lock();
-    qDebug() << population->getName() << " Before LAST join";
-    // Join and leave
-    leftLock->unlock();
-    rightLock->lock();
-    qDebug() << population->getName() << " AFTER LAST join";
-    leftLock->unlock();
+    // A generation stopped before its evaluation is not archived
+    delete lineage;
+    lineage = 0;
+    scheduler->finish(species);
 }
 
 void EvolutionEngine::setEntitySelector(EntitySelection *eliteSelection, quint32 eliteSelectionCount, EntitySelection *entitySelection, quint32 selectionCount)
@@ -88,10 +124,90 @@ void EvolutionEngine::setCrossoverMethod(Crossover * crossoverMethod)
     this->crossoverMethod = crossoverMethod;
 }
 
+/**
+  * Make the population one of the islands of an island model. The engine does not take
+  * the ownership of migration.
+  */
+void EvolutionEngine::setMigration(MigrationHub *migration, int island)
+{
+    this->migration = migration;
+    this->island = island;
+}
+
+/**
+  * Submit the state of the population to saveEngine every checkpoint generation. The
+  * engine does not take the ownership of saveEngine.
+  *
+  * @param index Index of the population among the ones of the checkpoints
+  */
+void EvolutionEngine::setCheckpoints(SaveEngine *saveEngine, int index)
+{
+    this->saveEngine = saveEngine;
+    this->saveIndex = index;
+}
+
+/**
+  * Restore the population from a checkpoint, startEvolution() then continues after the
+  * generation of the checkpoint with the random stream it had.
+  */
+void EvolutionEngine::resume(const SaveEngine::PopulationState &state)
+{
+    state.restore(population);
+    resumeGeneration = state.generation;
+    resumeRandomState = state.randomState;
+}
+
+/**
+  * Archive the lineage of every generation of the population in genealogy. The engine
+  * does not take the ownership of genealogy.
+  *
+  * @param index Index of the population in the archive
+  */
+void EvolutionEngine::setGenealogy(GenealogyArchive *genealogy, int index)
+{
+    this->genealogy = genealogy;
+    this->genealogyIndex = index;
+}
+
+/**
+  * Log the population at the end of each generation with logger. The engine does not
+  * take the ownership of logger, which must be called by the thread of the engine only.
+  */
+void EvolutionEngine::addLogger(Logger *logger)
+{
+    loggers.push_back(logger);
+}
+
+/**
+  * Replace the selection method at position in the list returned by getEntitySelectors().
+  * The engine takes the ownership of selection.
+  */
+void EvolutionEngine::replaceEntitySelector(quint32 position, EntitySelection *selection)
+{
+    Q_ASSERT(position < entitySelectionMethodList.size());
+    delete entitySelectionMethodList[position];
+    entitySelectionMethodList[position] = selection;
+}
+
+/**
+  * Replace the crossover method at position in the list returned by getCrossoverMethods().
+  * The engine takes the ownership of crossoverMethod.
+  */
+void EvolutionEngine::replaceCrossoverMethod(quint32 position, Crossover *crossoverMethod)
+{
+    Q_ASSERT(position < crossoverMethodList.size());
+    delete crossoverMethodList[position];
+    crossoverMethodList[position] = crossoverMethod;
+}
+
 Population *EvolutionEngine::getPopulation(){
     return population;
 }
 
+int EvolutionEngine::getIsland(){
+    return island;
+}
+
 vector<EntitySelection *> EvolutionEngine::getEntitySelectors()
 {
     vector<EntitySelection *> availableSelection;
@@ -121,17 +237,14 @@ void EvolutionEngine::initializePopulation()
 }
 void EvolutionEngine::selectElites()
 {
-//    for(int i = 0; i < selectedEntitiesCopy.size(); i++)
-//        delete selectedEntitiesCopy[i];
-    selectedEntitiesCopy.clear();
-    selectedEntitiesCopy = population->getSomeEntityCopy(eliteSelection,eliteSelectionCount);
-
+    population->select(eliteSelection, eliteSelectionCount, eliteIndices);
+    elitePositions = eliteIndices;
 }
 
 bool EvolutionEngine::isElite(Genotype *genotype)
 {
-    for(quint32 i=0; i < selectedEntitiesCopy.size(); i++){
-        if(genotype->getData()->operator ==(*selectedEntitiesCopy.at(i)->getGenotype()->getData()))
+    for(quint32 i=0; i < elitePositions.size(); i++){
+        if(genotype->getData()->operator ==(*population->getEntityAt(elitePositions.at(i))->getGenotype()->getData()))
             return true;
     }
     return false;
@@ -139,31 +252,63 @@ bool EvolutionEngine::isElite(Genotype *genotype)
 
 void EvolutionEngine::selectIndividuals()
 {
-//    for(uint i = 0; i < evolvingEntitiesCopy.size(); i++)
-//        delete evolvingEntitiesCopy[i];
-    evolvingEntitiesCopy.clear();
-    evolvingEntitiesCopy = population->getSomeEntityCopy(individualsSelection,individualsSelectionCount);
+    population->select(individualsSelection, individualsSelectionCount, parentIndices);
 }
 void EvolutionEngine::crossover()
 {
     // Missing probability
     // Random list before crossover (To do if better results and not too processing time consuming)
-    crossoverMethod->reproducePairOf(evolvingEntitiesCopy, crossoverProbability);
+    crossoverMethod->reproducePairOf(population->getOffspring(), crossoverProbability);
 }
 void EvolutionEngine::mutate()
 {
-
+    vector<PopEntity *> &offspring = population->getOffspring();
     vector<PopEntity *>::iterator it;
-    for(it=evolvingEntitiesCopy.begin(); it!=evolvingEntitiesCopy.end(); it++)
+    for(it=offspring.begin(); it!=offspring.end(); it++)
     {
         qreal entitiyLuck = RandomGenerator::getGeneratorInstance()->randomReal(0,1);
         //  if goal < chance OK.
         if(entitiyLuck < mutationProbability){
             mutateMethod->mutateEntity(*it, mutationPerBitProbability);
+            if(lineage != 0)
+                lineage->mutated(it - offspring.begin());
         }
     }
 }
 
+void EvolutionEngine::checkpoint(quint32 generation)
+{
+    if(saveEngine == 0 || !saveEngine->isCheckpointGeneration(generation))
+        return;
+    SaveEngine::PopulationState *state = new SaveEngine::PopulationState();
+    state->capture(population, generation, RandomGenerator::getGeneratorInstance()->getState());
+    saveEngine->submit(saveIndex, state);
+}
+
+void EvolutionEngine::log(quint32 generation)
+{
+    for(quint32 i = 0; i < loggers.size(); i++)
+        loggers[i]->log(generation);
+}
+
+void EvolutionEngine::beginLineage(quint32 generation, bool keyframe)
+{
+    if(genealogy == 0)
+        return;
+    const vector<PopEntity *> &entities = population->getAllEntities();
+    lineage = new GenealogyArchive::Generation(genealogyIndex, generation, keyframe || genealogy->isKeyframe(generation),
+                                               entities.size(), entities[0]->getGenotype()->getData()->size());
+}
+
+void EvolutionEngine::endLineage()
+{
+    if(lineage == 0)
+        return;
+    lineage->finish(population);
+    genealogy->submit(lineage);
+    lineage = 0;
+}
+
 StatisticEngine *EvolutionEngine::getStatisticEngine(){
     return &statsEngine;
 }
@@ -7,21 +7,33 @@
 #include "population.h"
 #include "crossover.h"
 #include "onepoint.h"
+#include "uniform.h"
+#include "arithmetic.h"
 #include "mutate.h"
 #include "toggling.h"
 #include "entityselection.h"
 #include "elitism.h"
 #include "elitismwithrandom.h"
 #include "rankbasedselection.h"
+#include "tournamentselection.h"
+#include "proportionalselection.h"
+#include "roulettewheel.h"
+#include "truncatedrankbasedselection.h"
 #include "statisticengine.h"
+#include "speciesscheduler.h"
+#include "migrationhub.h"
+#include "saveengine.h"
+#include "genealogyarchive.h"
+
+class Logger;
 
 class EvolutionEngine
 {
 public:
     EvolutionEngine(Population *population, quint32 generationCount, qreal crossoverProbability, qreal mutationProbability, qreal mutationPerBitProbability);
     virtual bool evaluatePopulation(Population* population, quint32 generation) = 0;
-    void startEvolution(QMutex *leftLock,
-                                            QMutex *rightLock,
+    void startEvolution(SpeciesScheduler *scheduler,
+                                            int species,
                                             quint32 generationCount,
                                             EntitySelection *eliteSelection,
                                             quint32 eliteSelectionCount,
@@ -31,13 +43,22 @@ public:
     void setEntitySelector(EntitySelection *eliteSelection, quint32 eliteSelectionCount, EntitySelection * individualsSelection, quint32 individualsSelectionCount);
     void setMutationMethod(Mutate * mutateMethod, quint32 mutationProbability);
     void setCrossoverMethod(Crossover * crossoverMethod);
+    void setMigration(MigrationHub *migration, int island);
+    void setCheckpoints(SaveEngine *saveEngine, int index);
+    void resume(const SaveEngine::PopulationState &state);
+    void setGenealogy(GenealogyArchive *genealogy, int index);
+    void addLogger(Logger *logger);
+    void replaceEntitySelector(quint32 position, EntitySelection *selection);
+    void replaceCrossoverMethod(quint32 position, Crossover *crossoverMethod);
 
     void replacePopulation();
     void replacePopulation(Population *population);
     bool isElite(Genotype *genotype);
+    inline const vector<quint32> &getElitePositions() const {return elitePositions;}
 
     StatisticEngine *getStatisticEngine();
     Population *getPopulation();
+    int getIsland();
 
     vector<EntitySelection *> getEntitySelectors();
     vector<Mutate *> getMutationMethods();
@@ -55,6 +76,10 @@ private:
     void selectIndividuals();
     void crossover();
     void mutate();
+    void checkpoint(quint32 generation);
+    void log(quint32 generation);
+    void beginLineage(quint32 generation, bool keyframe);
+    void endLineage();
 
     Population *population;
     qreal crossoverProbability;
@@ -69,14 +94,35 @@ private:
 
     Crossover *crossoverMethod;
 
+    // Island model, NULL when the populations evolve alone
+    MigrationHub *migration;
+    int island;
+
+    // Checkpoints of the run, NULL without, and index of the population in them
+    SaveEngine *saveEngine;
+    int saveIndex;
+    // Generation and random state the evolution continues from, 0 for a new run
+    quint32 resumeGeneration;
+    quint64 resumeRandomState;
+    // Called at the end of each generation, not owned
+    vector<Logger *> loggers;
+    // Genealogy archive of the run, NULL without, index of the population in it and
+    // lineage of the generation being bred
+    GenealogyArchive *genealogy;
+    int genealogyIndex;
+    GenealogyArchive::Generation *lineage;
+
 
 
     vector<EntitySelection *> entitySelectionMethodList;
     vector<Mutate *> mutateMethodList;
     vector<Crossover *> crossoverMethodList;
 
-    vector<PopEntity *> selectedEntitiesCopy;
-    vector<PopEntity *> evolvingEntitiesCopy;
+    // Positions in the current generation of the selected elites and parents
+    vector<quint32> eliteIndices;
+    vector<quint32> parentIndices;
+    // Positions of the elites in the population, for isElite()
+    vector<quint32> elitePositions;
 };
 
 #endif // EVOLUTIONENGINE_H
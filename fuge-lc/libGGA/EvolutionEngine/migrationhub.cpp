@@ -0,0 +1,149 @@
+/**
+ * @file migrationhub.cpp
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class MigrationHub
+ * @brief Exchanges migrants between the islands of an island model.
+ */
+
+#include "migrationhub.h"
+#include "randomgenerator.h"
+
+MigrationHub::MigrationHub(int islandCount, int speciesCount, Topology topology, quint32 interval, quint32 migrantCount) :
+    islandCount(islandCount), speciesCount(speciesCount), topology(topology), interval(interval), migrantCount(migrantCount)
+{
+    // A fully connected island receives the migrants of all the others
+    const quint32 senders = (topology == FullyConnected) ? qMax(1, islandCount - 1) : 1;
+    for(int i = 0; i < islandCount * speciesCount; i++){
+        Mailbox *mailbox = new Mailbox();
+        mailbox->buffer.assign(migrantCount * senders, (PopEntity *) 0);
+        mailbox->next = 0;
+        mailbox->pending = 0;
+        mailboxes.push_back(mailbox);
+    }
+}
+
+MigrationHub::~MigrationHub()
+{
+    for(quint32 i = 0; i < mailboxes.size(); i++){
+        for(quint32 j = 0; j < mailboxes[i]->buffer.size(); j++)
+            delete mailboxes[i]->buffer[j];
+        delete mailboxes[i];
+    }
+    mailboxes.clear();
+}
+
+/**
+ * Parse the name of a topology used in the scripts : "ring", "random" or "full".
+ *
+ * @return false if the name is unknown
+ */
+bool MigrationHub::topologyFromName(QString name, Topology *topology)
+{
+    if(name == "ring")
+        *topology = Ring;
+    else if(name == "random")
+        *topology = Random;
+    else if(name == "full")
+        *topology = FullyConnected;
+    else
+        return false;
+    return true;
+}
+
+/**
+ * Return true if the populations exchange migrants at generation.
+ */
+bool MigrationHub::isMigrationGeneration(quint32 generation) const
+{
+    return islandCount > 1 && interval > 0 && migrantCount > 0 && generation % interval == 0;
+}
+
+/**
+ * Send copies of the first elites of a population to the neighbours of its island.
+ *
+ * @param island Island of the population
+ * @param species Species of the population
+ * @param entities Current generation of the population
+ * @param elites Positions of the elites in entities, the representatives first
+ */
+void MigrationHub::emigrate(int island, int species, const vector<PopEntity *> &entities, const vector<quint32> &elites)
+{
+    switch(topology){
+    case Ring:
+        post(mailboxes[((island + 1) % islandCount) * speciesCount + species], entities, elites);
+        break;
+    case Random:{
+        // Any island but the sender
+        int target = RandomGenerator::getGeneratorInstance()->random(0, islandCount - 2);
+        if(target >= island)
+            target++;
+        post(mailboxes[target * speciesCount + species], entities, elites);
+        break;
+    }
+    case FullyConnected:
+        for(int i = 0; i < islandCount; i++){
+            if(i != island)
+                post(mailboxes[i * speciesCount + species], entities, elites);
+        }
+        break;
+    }
+}
+
+/**
+ * Copy the migrants received by a population over its first count entities, the
+ * latest migrants first.
+ *
+ * @param island Island of the population
+ * @param species Species of the population
+ * @param entities Current generation of the population
+ * @param count Number of entities which may be replaced
+ * @return Number of replaced entities
+ */
+quint32 MigrationHub::immigrate(int island, int species, const vector<PopEntity *> &entities, quint32 count)
+{
+    Mailbox *mailbox = mailboxes[island * speciesCount + species];
+    QMutexLocker locker(&mailbox->lock);
+
+    const quint32 capacity = mailbox->buffer.size();
+    const quint32 received = qMin(qMin(mailbox->pending, count), (quint32) entities.size());
+    for(quint32 i = 0; i < received; i++)
+        entities[i]->copyFrom(mailbox->buffer[(mailbox->next + capacity - 1 - i) % capacity]);
+    mailbox->pending = 0;
+    return received;
+}
+
+void MigrationHub::post(Mailbox *mailbox, const vector<PopEntity *> &entities, const vector<quint32> &elites)
+{
+    QMutexLocker locker(&mailbox->lock);
+
+    const quint32 capacity = mailbox->buffer.size();
+    const quint32 count = qMin(migrantCount, (quint32) elites.size());
+    for(quint32 i = 0; i < count; i++){
+        PopEntity *migrant = entities[elites[i]];
+        PopEntity *&slot = mailbox->buffer[mailbox->next];
+        if(slot == 0)
+            slot = migrant->getCopy();
+        else
+            slot->copyFrom(migrant);
+        mailbox->next = (mailbox->next + 1) % capacity;
+    }
+    mailbox->pending = qMin(mailbox->pending + count, capacity);
+}
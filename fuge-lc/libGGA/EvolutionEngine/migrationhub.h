@@ -0,0 +1,84 @@
+/**
+ * @file migrationhub.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class MigrationHub
+ * @brief Exchanges migrants between the islands of an island model.
+ *
+ * Every island evolves its own pair of coevolving populations, one per species.
+ * Every interval generations a population sends copies of its best elites, the
+ * representatives first, to the same species of the neighbour islands given by the
+ * topology :
+ *  - Ring sends to the next island.
+ *  - Random sends to one other island drawn at each migration.
+ *  - FullyConnected sends to all the other islands.
+ * The migrants wait in the mailbox of the receiving population until its next
+ * migration, where they replace offspring before the evaluation. Islands never wait
+ * for each other, a mailbox only keeps the latest migrants of each sender.
+ */
+
+#ifndef MIGRATIONHUB_H
+#define MIGRATIONHUB_H
+
+#include <vector>
+#include <QMutex>
+#include <QString>
+
+#include "popentity.h"
+
+using namespace std;
+
+class MigrationHub
+{
+public:
+    enum Topology {Ring, Random, FullyConnected};
+
+    MigrationHub(int islandCount, int speciesCount, Topology topology, quint32 interval, quint32 migrantCount);
+    ~MigrationHub();
+
+    static bool topologyFromName(QString name, Topology *topology);
+
+    inline int getIslandCount() const {return islandCount;}
+    bool isMigrationGeneration(quint32 generation) const;
+    void emigrate(int island, int species, const vector<PopEntity *> &entities, const vector<quint32> &elites);
+    quint32 immigrate(int island, int species, const vector<PopEntity *> &entities, quint32 count);
+
+private:
+    // Migrants received by a population, its buffer is allocated once and overwritten
+    struct Mailbox
+    {
+        QMutex lock;
+        vector<PopEntity *> buffer;
+        quint32 next;
+        quint32 pending;
+    };
+
+    void post(Mailbox *mailbox, const vector<PopEntity *> &entities, const vector<quint32> &elites);
+
+    int islandCount;
+    int speciesCount;
+    Topology topology;
+    quint32 interval;
+    quint32 migrantCount;
+    // One mailbox per island and species, island major
+    vector<Mailbox *> mailboxes;
+};
+
+#endif // MIGRATIONHUB_H
@@ -0,0 +1,117 @@
+/**
+ * @file speciesscheduler.cpp
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class SpeciesScheduler
+ * @brief Synchronizes the species of a cooperative coevolution.
+ */
+
+#include "speciesscheduler.h"
+
+SpeciesScheduler::SpeciesScheduler(int speciesCount, int stalenessBound) :
+    stalenessBound(stalenessBound), barrier(speciesCount)
+{
+    reached.fill(-1, speciesCount);
+    finished.fill(false, speciesCount);
+    waitTimes.resize(speciesCount);
+}
+
+/**
+ * Mark species as ready to evaluate generation, after publishing its representatives,
+ * and wait until the other species are close enough.
+ *
+ * @return Time spent waiting, in milliseconds
+ */
+int SpeciesScheduler::synchronize(int species, quint32 generation)
+{
+    QTime timer;
+    timer.start();
+
+    if(stalenessBound == 0){
+        lock.lock();
+        reached[species] = generation;
+        lock.unlock();
+        barrier.wait();
+    }
+    else{
+        // Only the first generation waits in the unbounded mode
+        const qint64 required = stalenessBound < 0 ? 0 : qMax((qint64) 0, (qint64) generation - stalenessBound);
+        QMutexLocker locker(&lock);
+        reached[species] = generation;
+        progress.wakeAll();
+        while(!othersReached(species, required))
+            progress.wait(&lock);
+    }
+
+    const int waited = timer.elapsed();
+    QMutexLocker locker(&lock);
+    waitTimes[species].append(waited);
+    return waited;
+}
+
+/**
+ * Mark species as done evaluating its current generation. In the strict mode, wait
+ * until the others are done too before it publishes new representatives.
+ */
+void SpeciesScheduler::endGeneration(int species)
+{
+    if(stalenessBound != 0)
+        return;
+
+    QTime timer;
+    timer.start();
+    barrier.wait();
+
+    const int waited = timer.elapsed();
+    QMutexLocker locker(&lock);
+    if(!waitTimes[species].isEmpty())
+        waitTimes[species].last() += waited;
+}
+
+/**
+ * Mark species as done, the others do not wait for it anymore.
+ */
+void SpeciesScheduler::finish(int species)
+{
+    {
+        QMutexLocker locker(&lock);
+        finished[species] = true;
+        progress.wakeAll();
+    }
+    barrier.leave();
+}
+
+/**
+ * Time spent waiting by species in each of its generations, in milliseconds. Only
+ * valid once the species is finished.
+ */
+const QVector<int> &SpeciesScheduler::getWaitTimes(int species)
+{
+    return waitTimes[species];
+}
+
+bool SpeciesScheduler::othersReached(int species, qint64 generation)
+{
+    for(int i = 0; i < reached.size(); i++){
+        if(i != species && !finished[i] && reached[i] < generation)
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file speciesscheduler.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class SpeciesScheduler
+ * @brief Synchronizes the species of a cooperative coevolution.
+ *
+ * Each species publishes its representatives at the start of a generation, then
+ * calls synchronize() before evaluating its individuals against the representatives
+ * of the other species. The staleness bound is the number of generations a species
+ * may be ahead of the others :
+ *  - 0 is the strict mode, all the species evolve in lock step through a barrier.
+ *    endGeneration() also waits until every species has evaluated the generation,
+ *    so that the representatives each one reads never depend on the timing and a
+ *    seeded run is repeatable.
+ *  - k > 0 lets a species evaluate generation g as soon as the others have reached
+ *    generation g-k, the faster species uses the latest published representatives.
+ *  - A negative bound never waits once all the species have started.
+ * Generation 0 is always a full barrier, nobody evaluates before every species has
+ * published its first representatives.
+ */
+
+#ifndef SPECIESSCHEDULER_H
+#define SPECIESSCHEDULER_H
+
+#include <QMutex>
+#include <QTime>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "barrier.h"
+
+class SpeciesScheduler
+{
+public:
+    SpeciesScheduler(int speciesCount, int stalenessBound);
+
+    inline int getStalenessBound() const {return stalenessBound;}
+    int synchronize(int species, quint32 generation);
+    void endGeneration(int species);
+    void finish(int species);
+
+    const QVector<int> &getWaitTimes(int species);
+
+private:
+    bool othersReached(int species, qint64 generation);
+
+    int stalenessBound;
+    Barrier barrier;
+    QMutex lock;
+    QWaitCondition progress;
+    // Last generation synchronized by each species, -1 before the first one
+    QVector<qint64> reached;
+    QVector<bool> finished;
+    // Time spent waiting in each generation, in milliseconds
+    QVector<QVector<int> > waitTimes;
+};
+
+#endif // SPECIESSCHEDULER_H
@@ -2,9 +2,11 @@ INCLUDEPATH += $$PWD
 DEPENDPATH += $$PWD
 
 SOURCES += $$PWD/logger.cpp \
+    $$PWD/logwriter.cpp \
     $$PWD/populationlogger.cpp \
     $$PWD/statisticlogger.cpp
     
 HEADERS += $$PWD/logger.h \
+    $$PWD/logwriter.h \
     $$PWD/populationlogger.h \
     $$PWD/statisticlogger.h
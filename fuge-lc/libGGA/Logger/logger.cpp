@@ -1,8 +1,43 @@
 #include "logger.h"
 
-Logger::Logger(EvolutionEngine *evolutionEngine, LoggerLevel loggerLevel) :
+Logger::Logger(EvolutionEngine *evolutionEngine, LogWriter *writer, LoggerLevel loggerLevel) :
     evolutionEngine(evolutionEngine),
+    writer(writer),
+    ring(0),
     loggerLevel(loggerLevel)
 {
 
 }
+
+/**
+ * Ask the writer to write the records logged so far without waiting for its latency.
+ */
+void Logger::saveLogs(){
+    writer->flush();
+}
+
+/**
+ * Open the file of the logger, to be called by the subclasses the level enables.
+ */
+void Logger::open(const QString &fileName, const QString &header){
+    ring = writer->openStream(fileName, header);
+}
+
+/**
+ * Find the level named none, stats, genes or all.
+ *
+ * @return false if the name is unknown, level is then unchanged
+ */
+bool Logger::levelFromName(const QString &name, LoggerLevel *level){
+    if(name == "none")
+        *level = NONE;
+    else if(name == "stats")
+        *level = SATS_ONLY;
+    else if(name == "genes")
+        *level = GENES_ONLY;
+    else if(name == "all")
+        *level = EVERYTHING;
+    else
+        return false;
+    return true;
+}
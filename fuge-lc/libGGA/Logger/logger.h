@@ -1,25 +1,60 @@
+/**
+ * @file logger.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class Logger
+ * @brief Logs the population of an evolution engine at the end of each generation.
+ *
+ * A logger is called by the thread of its engine and only turns what it logs into
+ * records pushed into its ring, the files are written by the LogWriter. A logger the
+ * level excludes has no ring and logs nothing.
+ */
+
 #ifndef LOGGER_H
 #define LOGGER_H
 
-#include <QFile>
+#include <QString>
 
 #include "evolutionengine.h"
+#include "logwriter.h"
 
 class Logger
 {
 public:
-    enum class LoggerLevel {EVERYTHING, SATS_ONLY, STATS_AND_GENES, GENES_ONLY, NONE};
-    Logger(EvolutionEngine* evolutionEngine, LoggerLevel loggerLevel = LoggerLevel::NONE);
+    enum LoggerLevel {EVERYTHING, SATS_ONLY, STATS_AND_GENES, GENES_ONLY, NONE};
+    Logger(EvolutionEngine* evolutionEngine, LogWriter *writer, LoggerLevel loggerLevel = NONE);
+    virtual ~Logger() {}
+
+    inline bool isEnabled() const {return ring != 0;}
+    virtual void log(quint32 generation) = 0;
+    void saveLogs();
+
+    static bool levelFromName(const QString &name, LoggerLevel *level);
 
-    virtual void log() = 0;
-    virtual void saveLogs() = 0;
-    virtual void clearLogs() = 0;
 protected:
+    void open(const QString &fileName, const QString &header);
+
     EvolutionEngine* evolutionEngine;
+    LogWriter *writer;
+    LogWriter::Ring *ring;
     LoggerLevel loggerLevel;
-
-private:
-
 };
 
 #endif // LOGGER_H
@@ -0,0 +1,161 @@
+#include "logwriter.h"
+
+#include <QDebug>
+#include <QTextStream>
+
+// Records per ring, a full population of a few hundred individuals fits many times
+static const int RING_CAPACITY = 1 << 14;
+
+/**
+ * Constructor, the thread must be started before records are pushed.
+ *
+ * @param format Format of the files
+ * @param latency Time between two drains of the rings, in milliseconds
+ */
+LogWriter::LogWriter(Format format, int latency) :
+    format(format), latency(qMax(1, latency)), stopping(false), flushRequested(false)
+{
+}
+
+LogWriter::~LogWriter()
+{
+    finish();
+    for(int i = 0; i < streams.size(); i++){
+        delete streams[i]->file;
+        delete streams[i]->ring;
+        delete streams[i];
+    }
+}
+
+/**
+ * Create the file of a new stream and return the ring its records are pushed into. The
+ * ring belongs to the writer and must be used by a single thread.
+ *
+ * @param fileName File the records are written to, replaced if it exists
+ * @param header First line of a CSV file, ignored in binary format
+ * @return The ring, or NULL if the file cannot be created
+ */
+LogWriter::Ring *LogWriter::openStream(const QString &fileName, const QString &header)
+{
+    QFile *file = new QFile(fileName);
+    if(!file->open(format == CSV ? QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text : QIODevice::WriteOnly | QIODevice::Truncate)){
+        qCritical() << "Cannot create the log file" << fileName;
+        delete file;
+        return NULL;
+    }
+    if(format == CSV){
+        QTextStream out(file);
+        out << header << "\n";
+    }
+
+    Stream *stream = new Stream();
+    stream->ring = new Ring(RING_CAPACITY);
+    stream->file = file;
+    stream->fileName = fileName;
+    stream->records = 0;
+    QMutexLocker locker(&lock);
+    streams.append(stream);
+    return stream->ring;
+}
+
+/**
+ * Ask the thread to write the pending records without waiting for the latency.
+ */
+void LogWriter::flush()
+{
+    QMutexLocker locker(&lock);
+    flushRequested = true;
+    wakeUp.wakeAll();
+}
+
+/**
+ * Write the remaining records, stop the thread and print the records written and
+ * dropped for each stream.
+ */
+void LogWriter::finish()
+{
+    lock.lock();
+    const bool wasRunning = !stopping;
+    stopping = true;
+    wakeUp.wakeAll();
+    lock.unlock();
+    wait();
+    if(!wasRunning)
+        return;
+
+    drain();
+    for(int i = 0; i < streams.size(); i++){
+        streams[i]->file->close();
+        qDebug() << "Log " << streams[i]->fileName << " : " << streams[i]->records << " records, "
+                 << streams[i]->ring->getDropped() << " dropped";
+    }
+}
+
+void LogWriter::run()
+{
+    lock.lock();
+    while(!stopping){
+        if(!flushRequested)
+            wakeUp.wait(&lock, latency);
+        flushRequested = false;
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+    lock.unlock();
+}
+
+/**
+ * Write the records of every ring to its file.
+ */
+void LogWriter::drain()
+{
+    lock.lock();
+    const QVector<Stream *> current = streams;
+    lock.unlock();
+
+    Record records[256];
+    for(int i = 0; i < current.size(); i++){
+        Stream *stream = current[i];
+        QTextStream out(stream->file);
+        int count;
+        while((count = stream->ring->pop(records, 256)) > 0){
+            if(format == BINARY){
+                stream->file->write((const char *) records, count * sizeof(Record));
+            }
+            else{
+                for(int r = 0; r < count; r++)
+                    writeCsv(out, stream, records[r]);
+            }
+            stream->records += count;
+        }
+        out.flush();
+        stream->file->flush();
+    }
+}
+
+/**
+ * Write a record as CSV. An ENTITY record is written once the GENOTYPE records following
+ * it are complete.
+ */
+void LogWriter::writeCsv(QTextStream &out, Stream *stream, const Record &record)
+{
+    switch(record.kind){
+    case Record::STATISTICS:
+        out << record.generation << "," << record.index << "," << record.values[0] << "," << record.values[1]
+            << "," << record.values[2] << "," << record.values[3] << "\n";
+        break;
+    case Record::ENTITY:
+        stream->entity = record;
+        stream->genotype.clear();
+        break;
+    case Record::GENOTYPE:
+        for(quint32 i = 0; i < record.length; i++)
+            stream->genotype.append(QLatin1Char((record.bits[i / 8] >> (i % 8)) & 1 ? '1' : '0'));
+        if((quint32) stream->genotype.size() >= stream->entity.length){
+            out << stream->entity.generation << "," << stream->entity.index << "," << stream->genotype << ","
+                << stream->entity.values[0] << "," << (stream->entity.flags & 1) << "\n";
+        }
+        break;
+    }
+}
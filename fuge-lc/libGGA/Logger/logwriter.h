@@ -0,0 +1,111 @@
+/**
+ * @file logwriter.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class LogWriter
+ * @brief Writes the records of the loggers to their files, in a thread of its own.
+ *
+ * Every logger pushes fixed size records into a ring of its own, with a single
+ * producer, the thread of the logger, and a single consumer, the writer. Pushing
+ * copies the records and publishes them with one atomic store, it never takes a
+ * lock nor waits : if the ring is full, the records are dropped and counted. The
+ * writer drains all the rings every latency milliseconds, so a record reaches its
+ * file at most that long after it was pushed, and formats them as CSV or writes
+ * them as they are in binary form.
+ */
+
+#ifndef LOGWRITER_H
+#define LOGWRITER_H
+
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QTextStream>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "spscring.h"
+
+class LogWriter : public QThread
+{
+public:
+    enum Format {CSV, BINARY};
+
+    // Fixed size record, 64 bytes
+    struct Record
+    {
+        enum Kind {STATISTICS, ENTITY, GENOTYPE};
+        quint8 kind;
+        // ENTITY : 1 for an elite
+        quint8 flags;
+        quint16 reserved;
+        // ENTITY : number of bits of the genotype, GENOTYPE : number of bits in this record
+        quint32 length;
+        quint32 generation;
+        // STATISTICS : population size, ENTITY : position in the population
+        quint32 index;
+        union {
+            // STATISTICS : min, max, mean, standard deviation, ENTITY : fitness
+            qreal values[6];
+            // GENOTYPE : next bits of the genotype of the last ENTITY, LSB first
+            uchar bits[48];
+        };
+    };
+    static const int BITS_PER_RECORD = 8 * sizeof(((Record *) 0)->bits);
+
+    typedef SpscRing<Record> Ring;
+
+    LogWriter(Format format, int latency = 100);
+    ~LogWriter();
+
+    inline Format getFormat() const {return format;}
+    Ring *openStream(const QString &fileName, const QString &header);
+    void flush();
+    void finish();
+
+protected:
+    void run();
+
+private:
+    struct Stream
+    {
+        Ring *ring;
+        QFile *file;
+        QString fileName;
+        // CSV : line of the ENTITY record whose genotype is being read
+        Record entity;
+        QString genotype;
+        qint64 records;
+    };
+
+    void drain();
+    void writeCsv(QTextStream &out, Stream *stream, const Record &record);
+
+    const Format format;
+    const int latency;
+    QMutex lock;
+    QWaitCondition wakeUp;
+    bool stopping;
+    bool flushRequested;
+    QVector<Stream *> streams;
+};
+
+#endif // LOGWRITER_H
@@ -1,34 +1,52 @@
 #include "populationlogger.h"
 
-PopulationLogger::PopulationLogger(EvolutionEngine *evolutionEngine, QFile *file, LoggerLevel loggerLevel) : Logger(evolutionEngine, loggerLevel),
-    file(file)
+#include <cstring>
+
+PopulationLogger::PopulationLogger(EvolutionEngine *evolutionEngine, LogWriter *writer, const QString &fileName, LoggerLevel loggerLevel) :
+    Logger(evolutionEngine, writer, loggerLevel)
 {
-}
-void PopulationLogger::log(){
-    generationsLogs.push_back(evolutionEngine->getPopulation()->getAllEntitiesCopy());
+    if(loggerLevel == EVERYTHING || loggerLevel == STATS_AND_GENES || loggerLevel == GENES_ONLY)
+        open(fileName, "Generation,Index,Genotype,Fitness,Elite");
 }
 
-void addInformationToCurrentGeneration(QString columnName, QString content){
+void PopulationLogger::log(quint32 generation){
+    if(ring == 0)
+        return;
 
-}
+    const vector<PopEntity *> &entities = evolutionEngine->getPopulation()->getAllEntities();
+    vector<bool> elite(entities.size(), false);
+    const vector<quint32> &elitePositions = evolutionEngine->getElitePositions();
+    for(quint32 i = 0; i < elitePositions.size(); i++)
+        elite[elitePositions[i]] = true;
 
-void PopulationLogger::saveLogs(){
-    if (file->open(QIODevice::WriteOnly | QIODevice::Text))
-    {
-        QTextStream stream(file);
-        stream << "Genotype," << "Fitness," << "Elite" << endl;
+    for(quint32 i = 0; i < entities.size(); i++){
+        const QBitArray *data = entities[i]->getGenotype()->getData();
+        const int bits = data->size();
+        const int chunks = (bits + LogWriter::BITS_PER_RECORD - 1) / LogWriter::BITS_PER_RECORD;
+        records.resize(1 + chunks);
+        memset(&records[0], 0, records.size() * sizeof(LogWriter::Record));
 
-        for (vector< vector<PopEntity *> >::size_type u = 0; u < generationsLogs.size(); u++) {
-            for (vector<PopEntity *>::size_type v = 0; v < generationsLogs[u].size(); v++) {
-                QString gene = QBitArrayUtility::bitArray2String(generationsLogs[u][v]->getGenotype()->getDataCopy());
-                bool isElite = evolutionEngine->isElite(generationsLogs[u][v]->getGenotype());
-                stream << gene << "," << generationsLogs[u][v]->getFitness() << "," << (isElite? "1" : "0") << endl;
+        LogWriter::Record &entity = records[0];
+        entity.kind = LogWriter::Record::ENTITY;
+        entity.flags = elite[i] ? 1 : 0;
+        entity.length = bits;
+        entity.generation = generation;
+        entity.index = i;
+        entity.values[0] = entities[i]->getFitness();
+
+        for(int c = 0; c < chunks; c++){
+            LogWriter::Record &chunk = records[1 + c];
+            const int first = c * LogWriter::BITS_PER_RECORD;
+            chunk.kind = LogWriter::Record::GENOTYPE;
+            chunk.length = qMin(LogWriter::BITS_PER_RECORD, bits - first);
+            chunk.generation = generation;
+            chunk.index = i;
+            for(quint32 b = 0; b < chunk.length; b++){
+                if(data->testBit(first + b))
+                    chunk.bits[b / 8] |= 1 << (b % 8);
             }
         }
-        file->close();
+        // Dropped as a whole if the ring is full, the writer counts it
+        ring->push(&records[0], records.size());
     }
 }
-
-void PopulationLogger::clearLogs(){
-    generationsLogs.clear();
-}
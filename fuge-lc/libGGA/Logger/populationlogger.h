@@ -2,22 +2,22 @@
 #define POPULATIONLOGGER_H
 
 #include <vector>
-#include <QTextStream>
 
 #include "logger.h"
 #include "popentity.h"
-#include "qbitarrayutility.h"
+
+/**
+ * Logs the genotype, the fitness and the elite flag of every individual, one ENTITY
+ * record followed by the GENOTYPE records of its bits.
+ */
 class PopulationLogger : public Logger
 {
 public:
-    PopulationLogger(EvolutionEngine *evolutionEngine,  QFile *file, LoggerLevel loggerLevel = LoggerLevel::NONE);
-    void log();
-    void addInformationToCurrentGeneration(QString columnName, QString content);
-    void saveLogs();
-    void clearLogs();
+    PopulationLogger(EvolutionEngine *evolutionEngine, LogWriter *writer, const QString &fileName, LoggerLevel loggerLevel = NONE);
+    void log(quint32 generation);
 private:
-    QFile *file;
-    vector<vector<PopEntity *> > generationsLogs;
+    // Records of one individual, kept to avoid an allocation per individual
+    vector<LogWriter::Record> records;
 };
 
 #endif // POPULATIONLOGGER_H
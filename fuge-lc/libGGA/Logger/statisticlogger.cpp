@@ -1,12 +1,43 @@
 #include "statisticlogger.h"
 
-StatisticLogger::StatisticLogger(EvolutionEngine *evolutionEngine, QFile *file, LoggerLevel loggerLevel) : Logger(evolutionEngine, loggerLevel),
-    file(file)
+#include <cmath>
+#include <cstring>
+
+StatisticLogger::StatisticLogger(EvolutionEngine *evolutionEngine, LogWriter *writer, const QString &fileName, LoggerLevel loggerLevel) :
+    Logger(evolutionEngine, writer, loggerLevel)
 {
+    if(loggerLevel == EVERYTHING || loggerLevel == STATS_AND_GENES || loggerLevel == SATS_ONLY)
+        open(fileName, "Generation,Size,Min,Max,Mean,StdDev");
 }
-void StatisticLogger::log(){
 
-}
-void StatisticLogger::saveLogs(){
+void StatisticLogger::log(quint32 generation){
+    if(ring == 0)
+        return;
+
+    const vector<PopEntity *> &entities = evolutionEngine->getPopulation()->getAllEntities();
+    if(entities.empty())
+        return;
+    qreal min = entities[0]->getFitness();
+    qreal max = min;
+    qreal sum = 0.0;
+    qreal squares = 0.0;
+    for(quint32 i = 0; i < entities.size(); i++){
+        const qreal fitness = entities[i]->getFitness();
+        min = qMin(min, fitness);
+        max = qMax(max, fitness);
+        sum += fitness;
+        squares += fitness * fitness;
+    }
+    const qreal mean = sum / entities.size();
 
+    LogWriter::Record record;
+    memset(&record, 0, sizeof(record));
+    record.kind = LogWriter::Record::STATISTICS;
+    record.generation = generation;
+    record.index = entities.size();
+    record.values[0] = min;
+    record.values[1] = max;
+    record.values[2] = mean;
+    record.values[3] = sqrt(qMax((qreal) 0.0, squares / entities.size() - mean * mean));
+    ring->push(&record, 1);
 }
@@ -3,15 +3,15 @@
 
 #include "logger.h"
 
+/**
+ * Logs the size and the minimum, maximum, mean and standard deviation of the fitness
+ * of the population, one STATISTICS record per generation.
+ */
 class StatisticLogger : public Logger
 {
 public:
-    StatisticLogger(EvolutionEngine *evolutionEngine, QFile *file, LoggerLevel loggerLevel = LoggerLevel::NONE);
-    void log();
-    void saveLogs();
-
-private:
-    QFile *file;
+    StatisticLogger(EvolutionEngine *evolutionEngine, LogWriter *writer, const QString &fileName, LoggerLevel loggerLevel = NONE);
+    void log(quint32 generation);
 };
 
 #endif // STATISTICLOGGER_H
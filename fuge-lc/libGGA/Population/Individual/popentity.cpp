@@ -1,4 +1,5 @@
 #include "popentity.h"
+#include "qbitarrayutility.h"
 
 PopEntity::PopEntity()
 {
@@ -46,3 +47,13 @@ PopEntity *PopEntity::getCopy()
 {
     return new PopEntity(this);
 }
+
+/**
+ * Overwrite the genotype and fitness of this entity with the ones of popEntity,
+ * reusing the already allocated genotype.
+ */
+void PopEntity::copyFrom(PopEntity *popEntity)
+{
+    QBitArrayUtility::copyBits(genotype->getData(), popEntity->getGenotype()->getData());
+    fitness = popEntity->getFitness();
+}
@@ -25,6 +25,7 @@ public:
     qreal getFitness();
     virtual Genotype *getGenotype();
     virtual PopEntity *getCopy();
+    void copyFrom(PopEntity *popEntity);
 
 protected:
     Genotype *genotype;
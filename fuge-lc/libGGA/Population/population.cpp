@@ -1,11 +1,44 @@
 #include "population.h"
+#include "atomicops.h"
+
+/*
+ * The entities of a population live in two buffers allocated once : entityList
+ * holds the current generation and offspringList receives the next one. Each
+ * generation the selected parents and elites are copied bit by bit into the
+ * back buffer, reproduced in place, and the buffers are swapped. Once warmed up
+ * a generation does not allocate any entity, genotype or bit array.
+ *
+ * The representatives are published to the other population as immutable sets.
+ * Readers take the current set without lock or copy, by incrementing its readers
+ * count. The single writer fills a set nobody reads, claiming it by swapping its
+ * count from 0 to CLAIMED, then makes it the current one with an atomic store.
+ * Sets are recycled and only deleted with the population, so a reader racing with
+ * the writer never touches freed memory : it backs off when it sees a claimed or
+ * replaced set.
+ */
+
+static const int CLAIMED = -0x40000000;
+
+Population::Representatives::Representatives() : generation(0), readers(CLAIMED)
+{
+}
+
 Population::~Population(){
     for(int i = 0; i < entityList.size(); i++)
         delete entityList.at(i);
     entityList.clear();
+    for(int i = 0; i < offspringList.size(); i++)
+        delete offspringList.at(i);
+    offspringList.clear();
+    for(quint32 i = 0; i < representativesPool.size(); i++) {
+        for(quint32 j = 0; j < representativesPool[i]->entities.size(); j++)
+            delete representativesPool[i]->entities[j];
+        delete representativesPool[i];
+    }
+    representativesPool.clear();
 }
 
-Population::Population(QString name, quint32 size, quint32 individualsLength) : name(name)
+Population::Population(QString name, quint32 size, quint32 individualsLength) : representatives(0), publishedGeneration(0), name(name)
 {
     for(int i = 0; i < entityList.size(); i++)
         delete entityList.at(i);
@@ -14,10 +47,12 @@ Population::Population(QString name, quint32 size, quint32 individualsLength) :
     {
         entityList.push_back(new PopEntity(individualsLength));
     }
+    allocateOffspring(individualsLength);
     randomizePopulation();
+    publishRepresentatives(claimRepresentatives());
 }
 
-Population::Population(Population *population, QString name)
+Population::Population(Population *population, QString name) : representatives(0), publishedGeneration(0)
 {
     for(int i = 0; i < entityList.size(); i++)
         delete entityList.at(i);
@@ -26,17 +61,27 @@ Population::Population(Population *population, QString name)
     {
         entityList.push_back(population->getEntityCopyFrom(i));
     }
+    if(!entityList.empty())
+        allocateOffspring(entityList.at(0)->getGenotype()->getLength());
     if(name.isEmpty())
         this->name = population->getName();
+    else
+        this->name = name;
+    publishRepresentatives(claimRepresentatives());
 }
 
-void Population::setRepresentativesCopy(vector<PopEntity *> representatives, int quantity){
-    int nbCooperator = quantity;
+void Population::allocateOffspring(quint32 individualsLength)
+{
+    for(quint32 i = 0; i < entityList.size(); i++)
+        offspringList.push_back(new PopEntity(individualsLength));
+    offspringView.reserve(offspringList.size());
+}
 
-    QMutexLocker locker(&mutex);
-    for(int i = 0; i < this->representatives.size(); i++)
-        delete this->representatives[i];
-    this->representatives.clear();
+/**
+ * Publish copies of the first quantity entities as representatives.
+ */
+void Population::setRepresentativesCopy(vector<PopEntity *> representatives, int quantity){
+    quint32 count = qMin((quint32) quantity, (quint32) representatives.size());
 
     // Random Cooperator (Working but not needed cooperators are the best ones only)
     //        if(nbCooperator > 1){
@@ -45,20 +90,28 @@ void Population::setRepresentativesCopy(vector<PopEntity *> representatives, int
     //            this->representatives.push_back(new PopEntity(entityList.at(pos)));
     //        }
 
-
-    vector<PopEntity *>::iterator it;
-    for(it=representatives.begin(); it!= representatives.begin()+nbCooperator; it++){
-        this->representatives.push_back(new PopEntity(*it));
+    Representatives *set = claimRepresentatives();
+    while(set->entities.size() > count){
+        delete set->entities.back();
+        set->entities.pop_back();
     }
-
+    while(set->entities.size() < count)
+        set->entities.push_back(representatives[set->entities.size()]->getCopy());
+    for(quint32 i = 0; i < count; i++)
+        set->entities[i]->copyFrom(representatives[i]);
+    publishRepresentatives(set);
 }
 
+/**
+ * Return copies of the current representatives, to be deleted by the caller.
+ */
 vector<PopEntity *> Population::getRepresentativesCopy(){
-    QMutexLocker locker(&mutex);
+    const Representatives *set = acquireRepresentatives();
     vector<PopEntity *> temp;
-    vector<PopEntity *>::iterator it;
-    for(it=representatives.begin(); it!=representatives.end(); it++)
+    vector<PopEntity *>::const_iterator it;
+    for(it=set->entities.begin(); it!=set->entities.end(); it++)
         temp.push_back(new PopEntity(*it));
+    releaseRepresentatives(set);
     return temp;
 }
 
@@ -149,7 +202,126 @@ vector<PopEntity *> Population::getAllEntitiesCopy()
     }
     return temp;
 }
-vector<PopEntity *> Population::getAllEntities()
+const vector<PopEntity *> &Population::getAllEntities()
 {
     return entityList;
 }
+
+/**
+ * Select count entities of the current generation, returning their positions.
+ */
+void Population::select(EntitySelection *entitySelection, quint32 count, vector<quint32> &selected)
+{
+    entitySelection->selectIndices(count, entityList, selected);
+}
+
+/**
+ * Build the next generation in the back buffer : the parents first, they will be
+ * reproduced in place through getOffspring(), then the elites which are kept as is.
+ * Together they must fill the population, a slot left over would still hold an entity
+ * of the previous generation.
+ */
+void Population::breed(const vector<quint32> &parents, const vector<quint32> &elites)
+{
+    Q_ASSERT(parents.size() + elites.size() == offspringList.size());
+
+    quint32 pos = 0;
+    for(quint32 i = 0; i < parents.size() && pos < offspringList.size(); i++, pos++)
+        offspringList[pos]->copyFrom(entityList[parents[i]]);
+    offspringView.assign(offspringList.begin(), offspringList.begin() + pos);
+    for(quint32 i = 0; i < elites.size() && pos < offspringList.size(); i++, pos++)
+        offspringList[pos]->copyFrom(entityList[elites[i]]);
+}
+
+/**
+ * Return the parents copied by breed(), to be reproduced in place.
+ */
+vector<PopEntity *> &Population::getOffspring()
+{
+    return offspringView;
+}
+
+/**
+ * Make the back buffer the current generation.
+ */
+void Population::swapBuffers()
+{
+    QMutexLocker locker(&mutex);
+    entityList.swap(offspringList);
+}
+
+/**
+ * Publish the first quantity elites as representatives. Must only be called by
+ * the thread evolving this population.
+ */
+void Population::setRepresentatives(const vector<quint32> &elites, int quantity)
+{
+    quint32 count = qMin((quint32) quantity, (quint32) elites.size());
+
+    Representatives *set = claimRepresentatives();
+    while(set->entities.size() > count){
+        delete set->entities.back();
+        set->entities.pop_back();
+    }
+    while(set->entities.size() < count)
+        set->entities.push_back(entityList[elites[set->entities.size()]]->getCopy());
+    for(quint32 i = 0; i < count; i++)
+        set->entities[i]->copyFrom(entityList[elites[i]]);
+    publishRepresentatives(set);
+}
+
+/**
+ * Return the current representatives. They stay unchanged until released with
+ * releaseRepresentatives(), which must be done before acquiring them again.
+ */
+const Population::Representatives *Population::acquireRepresentatives()
+{
+    for(;;){
+        Representatives *set = currentRepresentatives();
+        // A negative count means the writer claimed the set, it is not current anymore
+        if(set->readers.fetchAndAddOrdered(1) >= 0){
+            if(currentRepresentatives() == set)
+                return set;
+        }
+        set->readers.fetchAndAddOrdered(-1);
+    }
+}
+
+/**
+ * Release representatives returned by acquireRepresentatives().
+ */
+void Population::releaseRepresentatives(const Population::Representatives *representatives)
+{
+    const_cast<Representatives *>(representatives)->readers.fetchAndAddOrdered(-1);
+}
+
+/**
+ * Return a set no reader holds, allocating one only when all of them are in use.
+ */
+Population::Representatives *Population::claimRepresentatives()
+{
+    Representatives *current = currentRepresentatives();
+    for(quint32 i = 0; i < representativesPool.size(); i++){
+        if(representativesPool[i] != current && representativesPool[i]->readers.testAndSetOrdered(0, CLAIMED))
+            return representativesPool[i];
+    }
+    Representatives *set = new Representatives();
+    representativesPool.push_back(set);
+    return set;
+}
+
+/**
+ * Make a claimed set the current one.
+ */
+void Population::publishRepresentatives(Representatives *representatives)
+{
+    representatives->generation = publishedGeneration++;
+    // Keep the transient increments of the readers which backed off meanwhile
+    representatives->readers.fetchAndAddOrdered(-CLAIMED);
+    this->representatives.fetchAndStoreOrdered(representatives);
+}
+
+Population::Representatives *Population::currentRepresentatives()
+{
+    return loadAcquire(representatives);
+}
@@ -2,6 +2,8 @@
 #define POPULATION_H
 
 #include <vector>
+#include <QAtomicInt>
+#include <QAtomicPointer>
 #include <QMutexLocker>
 #include <QDebug>
 
@@ -13,6 +15,24 @@ using namespace std;
 class Population
 {
 public:
+    /*
+     * Immutable set of representatives published by setRepresentatives(). A set
+     * stays valid until the reader releases it, the population recycles it only
+     * once no reader holds it anymore.
+     */
+    class Representatives
+    {
+    public:
+        const vector<PopEntity *> &getEntities() const {return entities;}
+        quint32 getGeneration() const {return generation;}
+    private:
+        friend class Population;
+        Representatives();
+        vector<PopEntity *> entities;
+        quint32 generation;
+        QAtomicInt readers;
+    };
+
     Population(QString name, quint32 size, quint32 individualsLength);
     Population(Population *population, QString name = QString());
     ~Population();
@@ -32,10 +52,29 @@ public:
     vector<PopEntity *> getSomeEntityCopy(EntitySelection *entitySelection, quint32 count);
     vector<PopEntity *> getSomeEntity(EntitySelection *entitySelection, quint32 count);
     vector<PopEntity *> getAllEntitiesCopy();
-    vector<PopEntity *> getAllEntities();
+    const vector<PopEntity *> &getAllEntities();
+
+    // Double buffered arena, see population.cpp
+    void select(EntitySelection *entitySelection, quint32 count, vector<quint32> &selected);
+    void breed(const vector<quint32> &parents, const vector<quint32> &elites);
+    vector<PopEntity *> &getOffspring();
+    void swapBuffers();
+    void setRepresentatives(const vector<quint32> &elites, int quantity);
+    const Representatives *acquireRepresentatives();
+    void releaseRepresentatives(const Representatives *representatives);
 private:
-    vector<PopEntity *> representatives;
+    void allocateOffspring(quint32 individualsLength);
+    Representatives *claimRepresentatives();
+    void publishRepresentatives(Representatives *representatives);
+    Representatives *currentRepresentatives();
+
+    // Published set and the sets recycled by the writer, see population.cpp
+    QAtomicPointer<Representatives> representatives;
+    vector<Representatives *> representativesPool;
+    quint32 publishedGeneration;
     vector<PopEntity *> entityList;
+    vector<PopEntity *> offspringList;
+    vector<PopEntity *> offspringView;
     QMutex mutex;
     QString name;
 
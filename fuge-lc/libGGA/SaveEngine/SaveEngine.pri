@@ -1,7 +1,10 @@
 INCLUDEPATH += $$PWD
 DEPENDPATH += $$PWD
 
-SOURCES += $$PWD/saveengine.cpp
-
-HEADERS += $$PWD/saveengine.h
+SOURCES += $$PWD/saveengine.cpp \
+    $$PWD/genealogyarchive.cpp \
+    $$PWD/genealogyreader.cpp
 
+HEADERS += $$PWD/saveengine.h \
+    $$PWD/genealogyarchive.h \
+    $$PWD/genealogyreader.h
@@ -0,0 +1,292 @@
+#include "genealogyarchive.h"
+
+#include <cstring>
+#include <QDataStream>
+#include <QDebug>
+
+// Generations waiting for the thread before the evolution threads wait for it
+static const int MAX_PENDING = 64;
+
+const quint32 GenealogyArchive::MAGIC;
+const quint32 GenealogyArchive::INDEX_MAGIC;
+const quint32 GenealogyArchive::VERSION;
+const quint32 GenealogyArchive::NO_PARENT;
+
+/**
+ * Constructor, every individual starts without parent.
+ *
+ * @param index Index of the population returned by addPopulation()
+ * @param keyframe Keep the genotypes as they are instead of their deltas
+ * @param size Number of individuals of the population
+ * @param length Number of bits of their genotypes
+ */
+GenealogyArchive::Generation::Generation(int index, quint32 generation, bool keyframe, quint32 size, int length) :
+    index(index), generation(generation), keyframe(keyframe), length(length), operators(size, ORIGIN),
+    firstParents(size, NO_PARENT), secondParents(size, NO_PARENT), fitness(size, 0.0),
+    deltas(size * ((length + 7) / 8), 0)
+{
+}
+
+/**
+ * Record the parents of the offspring, once crossed over and before their mutation.
+ * Must be called before the buffers of population are swapped, the parents are the
+ * individuals of its current generation. An offspring which differs from its first
+ * parent was crossed over with the offspring next to it, a crossover which leaves
+ * it unchanged is recorded as a copy.
+ *
+ * @param parents Positions of the parents, copied to the first offspring
+ * @param elites Positions of the elites, copied after the parents
+ */
+void GenealogyArchive::Generation::breed(Population *population, const vector<quint32> &parents, const vector<quint32> &elites)
+{
+    const vector<PopEntity *> &previous = population->getAllEntities();
+    const vector<PopEntity *> &offspring = population->getOffspring();
+    quint32 position = 0;
+    for(; position < offspring.size() && position < operators.size(); position++){
+        operators[position] = 0;
+        firstParents[position] = parents[position];
+        const quint32 partner = position ^ 1;
+        if(partner < offspring.size() &&
+                *offspring[position]->getGenotype()->getData() != *previous[parents[position]]->getGenotype()->getData()){
+            operators[position] = CROSSOVER;
+            secondParents[position] = parents[partner];
+        }
+    }
+    for(quint32 i = 0; i < elites.size() && position < operators.size(); i++, position++){
+        operators[position] = ELITE;
+        firstParents[position] = elites[i];
+    }
+}
+
+/**
+ * Compute the deltas of the offspring to their first parent. Must be called after
+ * their mutation and before the buffers of population are swapped.
+ */
+void GenealogyArchive::Generation::diff(Population *population)
+{
+    if(keyframe)
+        return;
+    const vector<PopEntity *> &previous = population->getAllEntities();
+    const vector<PopEntity *> &offspring = population->getOffspring();
+    for(quint32 i = 0; i < offspring.size() && i < operators.size(); i++)
+        pack(i, offspring[i]->getGenotype()->getData(), previous[firstParents[i]]->getGenotype()->getData());
+}
+
+/**
+ * Record that the first count individuals were replaced by immigrants.
+ */
+void GenealogyArchive::Generation::immigrants(quint32 count)
+{
+    for(quint32 i = 0; i < count && i < operators.size(); i++){
+        operators[i] = IMMIGRANT | ORIGIN;
+        firstParents[i] = NO_PARENT;
+        secondParents[i] = NO_PARENT;
+    }
+}
+
+/**
+ * Record the fitness of the individuals once evaluated, and the genotypes of the ones
+ * without parent, or of all of them for a keyframe.
+ */
+void GenealogyArchive::Generation::finish(Population *population)
+{
+    const vector<PopEntity *> &entities = population->getAllEntities();
+    for(quint32 i = 0; i < entities.size() && i < operators.size(); i++){
+        fitness[i] = entities[i]->getFitness();
+        if(keyframe || (operators[i] & ORIGIN))
+            pack(i, entities[i]->getGenotype()->getData(), NULL);
+    }
+}
+
+/**
+ * Write the delta of genotype to parent, or genotype itself if parent is NULL, at
+ * position in the deltas.
+ */
+void GenealogyArchive::Generation::pack(quint32 position, const QBitArray *genotype, const QBitArray *parent)
+{
+    const int bytes = (length + 7) / 8;
+    uchar *out = (uchar *) deltas.data() + position * bytes;
+    memset(out, 0, bytes);
+    // Elites and unchanged offspring have no delta
+    if(parent != NULL && *genotype == *parent)
+        return;
+    const int size = qMin(length, genotype->size());
+    for(int k = 0; k < size; k++){
+        const bool bit = parent == NULL ? genotype->testBit(k) : genotype->testBit(k) != parent->testBit(k);
+        if(bit)
+            out[k >> 3] |= 1 << (k & 7);
+    }
+}
+
+/**
+ * Constructor. The populations must be added before the archive is opened, then the
+ * thread must be started before the first generation is submitted.
+ *
+ * @param fileName Archive file, replaced if it exists
+ * @param run Index of the run among the runs of the script
+ * @param keyframeInterval Generations between two keyframes
+ */
+GenealogyArchive::GenealogyArchive(const QString &fileName, quint32 run, quint32 keyframeInterval) :
+    fileName(fileName), runIndex(run), keyframeInterval(qMax((quint32) 1, keyframeInterval)), rawBytes(0), stopping(false)
+{
+}
+
+GenealogyArchive::~GenealogyArchive()
+{
+    finish();
+    qDeleteAll(queue);
+}
+
+/**
+ * Add a population to the header of the archive.
+ *
+ * @return The index of the population, to be given to its generations
+ */
+int GenealogyArchive::addPopulation(const QString &name, quint32 size, int length)
+{
+    PopulationInfo population;
+    population.name = name;
+    population.size = size;
+    population.length = length;
+    populations.append(population);
+    return populations.size() - 1;
+}
+
+/**
+ * Create the file and write its header.
+ *
+ * @return false if the file cannot be created
+ */
+bool GenealogyArchive::open()
+{
+    file.setFileName(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+        qCritical() << "Cannot create the genealogy archive" << fileName;
+        return false;
+    }
+
+    QByteArray header;
+    QDataStream out(&header, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << MAGIC << VERSION << runIndex << keyframeInterval << (quint32) populations.size();
+    for(int i = 0; i < populations.size(); i++)
+        out << populations[i].name << populations[i].size << populations[i].length;
+    file.write(header);
+    return true;
+}
+
+/**
+ * Hand a complete generation over to the thread. Waits only if the thread is late by
+ * many generations.
+ *
+ * @param generation Generation, owned by the archive
+ */
+void GenealogyArchive::submit(Generation *generation)
+{
+    QMutexLocker locker(&lock);
+    while(queue.size() >= MAX_PENDING && !stopping)
+        drained.wait(&lock);
+    if(stopping){
+        delete generation;
+        return;
+    }
+    queue.enqueue(generation);
+    wakeUp.wakeAll();
+}
+
+/**
+ * Write the submitted generations and the index, then stop the thread. Prints the size
+ * of the archive.
+ */
+void GenealogyArchive::finish()
+{
+    lock.lock();
+    stopping = true;
+    wakeUp.wakeAll();
+    drained.wakeAll();
+    lock.unlock();
+    wait();
+
+    if(!file.isOpen())
+        return;
+    writeIndex();
+    const qint64 size = file.pos();
+    file.close();
+    qDebug() << "Genealogy archive" << fileName << ":" << blocks.size() << "generations," << size << "bytes,"
+             << rawBytes << "bytes before compression";
+}
+
+/**
+ * Write the submitted generations until the archive is finished.
+ */
+void GenealogyArchive::run()
+{
+    lock.lock();
+    for(;;){
+        while(queue.isEmpty() && !stopping)
+            wakeUp.wait(&lock);
+        if(queue.isEmpty())
+            break;
+        Generation *generation = queue.dequeue();
+        drained.wakeAll();
+        lock.unlock();
+
+        write(*generation);
+        delete generation;
+
+        lock.lock();
+    }
+    lock.unlock();
+}
+
+/**
+ * Compress generation and append it to the file as a block.
+ */
+void GenealogyArchive::write(const Generation &generation)
+{
+    QByteArray data;
+    QDataStream payload(&data, QIODevice::WriteOnly);
+    payload.setVersion(QDataStream::Qt_4_6);
+    const quint32 count = generation.operators.size();
+    payload << count;
+    // Each field of all the individuals in a row, similar values compress better
+    for(quint32 i = 0; i < count; i++)
+        payload << generation.operators[i];
+    for(quint32 i = 0; i < count; i++)
+        payload << generation.firstParents[i];
+    for(quint32 i = 0; i < count; i++)
+        payload << generation.secondParents[i];
+    for(quint32 i = 0; i < count; i++)
+        payload << generation.fitness[i];
+    payload << generation.deltas;
+    rawBytes += data.size();
+
+    Block block;
+    block.population = generation.index;
+    block.generation = generation.generation;
+    block.keyframe = generation.keyframe;
+    block.offset = file.pos();
+
+    QByteArray header;
+    QDataStream out(&header, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << block.population << block.generation << (quint8) generation.keyframe << qCompress(data);
+    if(file.write(header) != header.size()){
+        qCritical() << "Cannot write to the genealogy archive" << fileName;
+        return;
+    }
+    blocks.append(block);
+}
+
+void GenealogyArchive::writeIndex()
+{
+    const qint64 offset = file.pos();
+    QByteArray index;
+    QDataStream out(&index, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint32) blocks.size();
+    for(int i = 0; i < blocks.size(); i++)
+        out << blocks[i].population << blocks[i].generation << (quint8) blocks[i].keyframe << blocks[i].offset;
+    out << offset << INDEX_MAGIC;
+    file.write(index);
+}
@@ -0,0 +1,158 @@
+/**
+ * @file genealogyarchive.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class GenealogyArchive
+ * @brief Archives every generation of the populations of a run, as deltas to their parents.
+ *
+ * For each individual of a generation, the archive keeps the positions of its parents
+ * in the previous generation, the operators which produced it and its fitness. Its
+ * genotype is kept as the XOR of the genotype of its first parent, which is almost
+ * empty for the elites and the mutants, except for the keyframe generations, whose
+ * genotypes are kept as they are, so that a generation is rebuilt from the closest
+ * keyframe before it. The evolution threads only record the lineage and the deltas,
+ * the thread of the archive compresses each generation into a block and appends it to
+ * the file. An index of the blocks is written at the end of the file, GenealogyReader
+ * uses it to seek the block of any generation.
+ *
+ * The file starts with a header : the magic number, the version, the run, the keyframe
+ * interval and, for each population, its name, size and genotype length. Each block is
+ * made of the population, the generation, the keyframe flag and the size of the data
+ * compressed with qCompress(). The index lists the population, generation, keyframe
+ * flag and offset of each block and ends with its own offset and the index magic number. All the
+ * numbers are written by QDataStream, big endian.
+ */
+
+#ifndef GENEALOGYARCHIVE_H
+#define GENEALOGYARCHIVE_H
+
+#include <vector>
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QQueue>
+#include <QString>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "population.h"
+
+using namespace std;
+
+class GenealogyArchive : public QThread
+{
+public:
+    static const quint32 MAGIC = 0x4647474e;
+    static const quint32 INDEX_MAGIC = 0x46474958;
+    static const quint32 VERSION = 1;
+    // Parent of an individual which has none in the archive
+    static const quint32 NO_PARENT = 0xffffffff;
+
+    // Operators which produced an individual
+    enum Operator {
+        // Copied unchanged from its first parent
+        ELITE = 1,
+        // Exchanged bits with the offspring of its second parent
+        CROSSOVER = 2,
+        MUTATION = 4,
+        // Received from another island
+        IMMIGRANT = 8,
+        // No parent in the archive, its delta is its genotype
+        ORIGIN = 16
+    };
+
+    // Lineage and deltas of the individuals of a population at a generation, filled in
+    // by the thread evolving it along the steps of the generation
+    class Generation
+    {
+    public:
+        Generation(int index, quint32 generation, bool keyframe, quint32 size, int length);
+
+        void breed(Population *population, const vector<quint32> &parents, const vector<quint32> &elites);
+        inline void mutated(quint32 position) {operators[position] |= MUTATION;}
+        void diff(Population *population);
+        void immigrants(quint32 count);
+        void finish(Population *population);
+
+        // Index of the population in the archive
+        int index;
+        quint32 generation;
+        bool keyframe;
+        int length;
+        vector<quint8> operators;
+        vector<quint32> firstParents;
+        vector<quint32> secondParents;
+        vector<qreal> fitness;
+        // Delta of each individual, (length + 7) / 8 bytes each, LSB first
+        QByteArray deltas;
+
+    private:
+        void pack(quint32 position, const QBitArray *genotype, const QBitArray *parent);
+    };
+
+    GenealogyArchive(const QString &fileName, quint32 run, quint32 keyframeInterval);
+    ~GenealogyArchive();
+
+    int addPopulation(const QString &name, quint32 size, int length);
+    bool open();
+    // The first generation recorded by a population must be a keyframe as well
+    inline bool isKeyframe(quint32 generation) const {return generation % keyframeInterval == 0;}
+    void submit(Generation *generation);
+    void finish();
+
+protected:
+    void run();
+
+private:
+    struct PopulationInfo
+    {
+        QString name;
+        quint32 size;
+        qint32 length;
+    };
+    struct Block
+    {
+        quint32 population;
+        quint32 generation;
+        bool keyframe;
+        qint64 offset;
+    };
+
+    void write(const Generation &generation);
+    void writeIndex();
+
+    const QString fileName;
+    const quint32 runIndex;
+    const quint32 keyframeInterval;
+    QVector<PopulationInfo> populations;
+    QFile file;
+    QVector<Block> blocks;
+    // Size of the blocks before compression
+    qint64 rawBytes;
+
+    QMutex lock;
+    QWaitCondition wakeUp;
+    QWaitCondition drained;
+    bool stopping;
+    QQueue<Generation *> queue;
+};
+
+#endif // GENEALOGYARCHIVE_H
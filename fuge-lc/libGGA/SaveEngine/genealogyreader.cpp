@@ -0,0 +1,329 @@
+#include "genealogyreader.h"
+#include "genealogyarchive.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QStringList>
+
+// Size of the header of a block : population, generation, keyframe flag and data size
+static const int BLOCK_HEADER_SIZE = 13;
+// Size of the end of the index : its offset and the index magic number
+static const int INDEX_TRAILER_SIZE = 12;
+
+GenealogyReader::GenealogyReader() : run(0), keyframeInterval(1), cachedPopulation(-1)
+{
+}
+
+/**
+ * Open an archive and load its header and index.
+ *
+ * @return false if the file cannot be read or is not an archive of this version
+ */
+bool GenealogyReader::open(const QString &fileName)
+{
+    file.setFileName(fileName);
+    if(!file.open(QIODevice::ReadOnly)){
+        qCritical() << "Cannot open the genealogy archive" << fileName;
+        return false;
+    }
+
+    // The names make the header variable, read it as a whole from a generous buffer
+    QDataStream in(file.read(qMin(file.size(), (qint64) 1 << 16)));
+    in.setVersion(QDataStream::Qt_4_6);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+    in >> magic >> version;
+    if(magic != GenealogyArchive::MAGIC || version != GenealogyArchive::VERSION){
+        qCritical() << fileName << "is not a genealogy archive of this version";
+        return false;
+    }
+    in >> run >> keyframeInterval >> count;
+    qint64 headerSize = 20;
+    for(quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++){
+        PopulationInfo population;
+        in >> population.name >> population.size >> population.length;
+        populations.append(population);
+        // A QString is its size in bytes followed by its UTF-16 characters
+        headerSize += 4 + 2 * population.name.size() + 8;
+    }
+    if(in.status() != QDataStream::Ok){
+        qCritical() << "The header of the genealogy archive" << fileName << "is truncated";
+        return false;
+    }
+
+    if(!readIndex(file.size())){
+        qDebug() << "The genealogy archive" << fileName << "has no index, its run did not finish";
+        scanBlocks(headerSize, file.size());
+    }
+    return true;
+}
+
+/**
+ * Return the index of the population named name, or -1 if there is none.
+ */
+int GenealogyReader::findPopulation(const QString &name) const
+{
+    for(int i = 0; i < populations.size(); i++){
+        if(populations[i].name.compare(name, Qt::CaseInsensitive) == 0)
+            return i;
+    }
+    return -1;
+}
+
+bool GenealogyReader::hasGeneration(int population, quint32 generation) const
+{
+    return blocks.contains(key(population, generation));
+}
+
+/**
+ * Return the last generation of population in the archive, 0 if there is none.
+ */
+quint32 GenealogyReader::getLastGeneration(int population) const
+{
+    quint32 last = 0;
+    const QList<quint64> keys = blocks.keys();
+    for(int i = 0; i < keys.size(); i++){
+        if((int) (keys[i] >> 32) == population)
+            last = qMax(last, (quint32) keys[i]);
+    }
+    return last;
+}
+
+/**
+ * Read the lineage and the fitness of a generation, its genotypes are left as deltas.
+ */
+bool GenealogyReader::readLineage(int population, quint32 generation, Generation *lineage)
+{
+    return readBlock(population, generation, lineage);
+}
+
+/**
+ * Rebuild the genotypes of a generation from the closest keyframe before it, or from
+ * the last generation rebuilt if it is closer.
+ */
+bool GenealogyReader::readGeneration(int population, quint32 generation, Generation *rebuilt)
+{
+    quint32 start = generation;
+    while(!(hasGeneration(population, start) && blocks.value(key(population, start)).keyframe)){
+        if(start == 0 || !hasGeneration(population, start)){
+            qCritical() << "No keyframe before generation" << generation << "in the genealogy archive";
+            return false;
+        }
+        start--;
+    }
+
+    if(cachedPopulation == population && cached.generation >= start && cached.generation <= generation){
+        start = cached.generation + 1;
+    }
+    else{
+        cachedPopulation = -1;
+        if(!readBlock(population, start, &cached))
+            return false;
+        cachedPopulation = population;
+        start++;
+    }
+
+    Generation next;
+    for(quint32 g = start; g <= generation; g++){
+        if(!readBlock(population, g, &next)){
+            cachedPopulation = -1;
+            return false;
+        }
+        for(quint32 i = 0; i < next.genotypes.size(); i++){
+            if(next.keyframe || (next.operators[i] & GenealogyArchive::ORIGIN))
+                continue;
+            const quint32 parent = next.firstParents[i];
+            if(parent >= cached.genotypes.size()){
+                qCritical() << "Invalid parent in generation" << g << "of the genealogy archive";
+                cachedPopulation = -1;
+                return false;
+            }
+            next.genotypes[i] ^= cached.genotypes[parent];
+        }
+        swap(cached, next);
+    }
+    *rebuilt = cached;
+    return true;
+}
+
+/**
+ * Collect the ancestors of an individual, the individual first, then its parents in
+ * the previous generation and so on, back to the first generation of the archive or to
+ * individuals without parent. Each ancestor is listed once.
+ */
+bool GenealogyReader::readAncestry(int population, quint32 generation, quint32 position, QVector<Ancestor> *ancestors)
+{
+    ancestors->clear();
+    if(population < 0 || population >= populations.size() || position >= populations[population].size)
+        return false;
+
+    QVector<bool> current(populations[population].size, false);
+    current[position] = true;
+    Generation lineage;
+    for(quint32 g = generation; ; g--){
+        if(!readLineage(population, g, &lineage))
+            return false;
+        QVector<bool> parents(populations[population].size, false);
+        bool any = false;
+        for(int i = 0; i < current.size(); i++){
+            if(!current[i])
+                continue;
+            Ancestor ancestor;
+            ancestor.generation = g;
+            ancestor.position = i;
+            ancestors->append(ancestor);
+            const quint32 first = lineage.firstParents[i];
+            const quint32 second = lineage.secondParents[i];
+            if(first < (quint32) parents.size())
+                any = parents[first] = true;
+            if(second < (quint32) parents.size())
+                any = parents[second] = true;
+        }
+        if(!any || g == 0 || !hasGeneration(population, g - 1))
+            break;
+        current = parents;
+    }
+    return true;
+}
+
+/**
+ * Return the operators as words separated by +, or copy for none.
+ */
+QString GenealogyReader::operatorNames(quint8 operators)
+{
+    QStringList names;
+    if(operators & GenealogyArchive::ELITE)
+        names << "elite";
+    if(operators & GenealogyArchive::CROSSOVER)
+        names << "crossover";
+    if(operators & GenealogyArchive::MUTATION)
+        names << "mutation";
+    if(operators & GenealogyArchive::IMMIGRANT)
+        names << "immigrant";
+    else if(operators & GenealogyArchive::ORIGIN)
+        names << "origin";
+    return names.isEmpty() ? QString("copy") : names.join("+");
+}
+
+/**
+ * Load the index written at the end of the archive.
+ *
+ * @return false if the archive has no valid index
+ */
+bool GenealogyReader::readIndex(qint64 end)
+{
+    if(end < INDEX_TRAILER_SIZE || !file.seek(end - INDEX_TRAILER_SIZE))
+        return false;
+    QDataStream trailer(file.read(INDEX_TRAILER_SIZE));
+    trailer.setVersion(QDataStream::Qt_4_6);
+    qint64 offset = 0;
+    quint32 magic = 0;
+    trailer >> offset >> magic;
+    if(trailer.status() != QDataStream::Ok || magic != GenealogyArchive::INDEX_MAGIC || offset < 0 || offset >= end || !file.seek(offset))
+        return false;
+
+    QDataStream in(file.read(end - INDEX_TRAILER_SIZE - offset));
+    in.setVersion(QDataStream::Qt_4_6);
+    quint32 count = 0;
+    in >> count;
+    for(quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++){
+        quint32 population;
+        quint32 generation;
+        quint8 keyframe;
+        Block block;
+        in >> population >> generation >> keyframe >> block.offset;
+        block.keyframe = keyframe != 0;
+        blocks.insert(key(population, generation), block);
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+/**
+ * Rebuild the index from the headers of the blocks between start and end, up to the
+ * first incomplete one.
+ */
+void GenealogyReader::scanBlocks(qint64 start, qint64 end)
+{
+    blocks.clear();
+    qint64 offset = start;
+    while(offset + BLOCK_HEADER_SIZE <= end && file.seek(offset)){
+        QDataStream in(file.read(BLOCK_HEADER_SIZE));
+        in.setVersion(QDataStream::Qt_4_6);
+        quint32 population;
+        quint32 generation;
+        quint8 keyframe;
+        quint32 size;
+        in >> population >> generation >> keyframe >> size;
+        if(in.status() != QDataStream::Ok || (int) population >= populations.size() || offset + BLOCK_HEADER_SIZE + size > end)
+            break;
+        Block block;
+        block.offset = offset;
+        block.keyframe = keyframe != 0;
+        blocks.insert(key(population, generation), block);
+        offset += BLOCK_HEADER_SIZE + size;
+    }
+}
+
+/**
+ * Read and uncompress the block of a generation.
+ */
+bool GenealogyReader::readBlock(int population, quint32 generation, Generation *block)
+{
+    if(!hasGeneration(population, generation)){
+        qCritical() << "Generation" << generation << "is not in the genealogy archive";
+        return false;
+    }
+    const Block &info = blocks[key(population, generation)];
+    if(!file.seek(info.offset))
+        return false;
+    QDataStream header(file.read(BLOCK_HEADER_SIZE));
+    header.setVersion(QDataStream::Qt_4_6);
+    quint32 blockPopulation;
+    quint32 blockGeneration;
+    quint8 keyframe;
+    quint32 size;
+    header >> blockPopulation >> blockGeneration >> keyframe >> size;
+    const QByteArray data = qUncompress(file.read(size));
+    if(header.status() != QDataStream::Ok || (int) blockPopulation != population || blockGeneration != generation || data.isEmpty()){
+        qCritical() << "The block of generation" << generation << "of the genealogy archive is corrupted";
+        return false;
+    }
+
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_4_6);
+    quint32 count = 0;
+    in >> count;
+    block->generation = generation;
+    block->keyframe = keyframe != 0;
+    block->operators.resize(count);
+    block->firstParents.resize(count);
+    block->secondParents.resize(count);
+    block->fitness.resize(count);
+    for(quint32 i = 0; i < count; i++)
+        in >> block->operators[i];
+    for(quint32 i = 0; i < count; i++)
+        in >> block->firstParents[i];
+    for(quint32 i = 0; i < count; i++)
+        in >> block->secondParents[i];
+    for(quint32 i = 0; i < count; i++)
+        in >> block->fitness[i];
+    QByteArray deltas;
+    in >> deltas;
+
+    const int length = populations[population].length;
+    const int bytes = (length + 7) / 8;
+    if(in.status() != QDataStream::Ok || deltas.size() != (int) count * bytes){
+        qCritical() << "The block of generation" << generation << "of the genealogy archive is corrupted";
+        return false;
+    }
+    block->genotypes.resize(count);
+    for(quint32 i = 0; i < count; i++){
+        const uchar *bits = (const uchar *) deltas.constData() + i * bytes;
+        QBitArray &genotype = block->genotypes[i];
+        genotype.resize(length);
+        for(int k = 0; k < length; k++)
+            genotype.setBit(k, (bits[k >> 3] >> (k & 7)) & 1);
+    }
+    return true;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file genealogyreader.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class GenealogyReader
+ * @brief Rebuilds the generations and the ancestry of the individuals of a genealogy archive.
+ *
+ * The reader loads the index at the end of the archive and then reads the blocks it
+ * needs only. A generation is rebuilt from the closest keyframe before it by applying
+ * the deltas of the following generations, the last one rebuilt is kept so that the
+ * generations are read in order at the cost of one block each. The index of an archive
+ * whose run was killed is missing, it is then rebuilt by reading the headers of the
+ * blocks, up to the last complete one.
+ */
+
+#ifndef GENEALOGYREADER_H
+#define GENEALOGYREADER_H
+
+#include <vector>
+#include <QBitArray>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+using namespace std;
+
+class GenealogyReader
+{
+public:
+    struct PopulationInfo
+    {
+        QString name;
+        quint32 size;
+        qint32 length;
+    };
+
+    // A generation of a population, see GenealogyArchive::Generation
+    struct Generation
+    {
+        quint32 generation;
+        bool keyframe;
+        vector<quint8> operators;
+        vector<quint32> firstParents;
+        vector<quint32> secondParents;
+        vector<qreal> fitness;
+        // Deltas when read, genotypes when rebuilt
+        vector<QBitArray> genotypes;
+    };
+
+    // An ancestor of an individual
+    struct Ancestor
+    {
+        quint32 generation;
+        quint32 position;
+    };
+
+    GenealogyReader();
+
+    bool open(const QString &fileName);
+    inline quint32 getRun() const {return run;}
+    inline const QVector<PopulationInfo> &getPopulations() const {return populations;}
+    int findPopulation(const QString &name) const;
+    bool hasGeneration(int population, quint32 generation) const;
+    quint32 getLastGeneration(int population) const;
+
+    bool readLineage(int population, quint32 generation, Generation *lineage);
+    bool readGeneration(int population, quint32 generation, Generation *rebuilt);
+    bool readAncestry(int population, quint32 generation, quint32 position, QVector<Ancestor> *ancestors);
+
+    static QString operatorNames(quint8 operators);
+
+private:
+    struct Block
+    {
+        qint64 offset;
+        bool keyframe;
+    };
+
+    static inline quint64 key(int population, quint32 generation) {return ((quint64) population << 32) | generation;}
+    bool readIndex(qint64 end);
+    void scanBlocks(qint64 start, qint64 end);
+    bool readBlock(int population, quint32 generation, Generation *block);
+
+    QFile file;
+    quint32 run;
+    quint32 keyframeInterval;
+    QVector<PopulationInfo> populations;
+    QHash<quint64, Block> blocks;
+
+    // Last generation rebuilt, population -1 for none
+    int cachedPopulation;
+    Generation cached;
+};
+
+#endif // GENEALOGYREADER_H
@@ -1,6 +1,328 @@
 #include "saveengine.h"
 
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QTime>
 
-SaveEngine::SaveEngine(Logger *logger) : logger(logger)
+#include "fileutility.h"
+
+// Header of a checkpoint file, the version changes with the layout
+static const quint32 CHECKPOINT_MAGIC = 0x46474350;
+static const quint32 CHECKPOINT_VERSION = 1;
+
+SaveEngine::PopulationState::PopulationState() : generation(0), randomState(0)
+{
+}
+
+/**
+ * Copy the individuals and the representatives of population. Must be called by the
+ * thread evolving it, between two generations.
+ */
+void SaveEngine::PopulationState::capture(Population *population, quint32 generation, quint64 randomState)
+{
+    this->generation = generation;
+    this->randomState = randomState;
+
+    const vector<PopEntity *> &entities = population->getAllEntities();
+    genotypes.resize(entities.size());
+    fitness.resize(entities.size());
+    for(quint32 i = 0; i < entities.size(); i++){
+        genotypes[i] = *entities[i]->getGenotype()->getData();
+        fitness[i] = entities[i]->getFitness();
+    }
+
+    const Population::Representatives *set = population->acquireRepresentatives();
+    const vector<PopEntity *> &published = set->getEntities();
+    representatives.resize(published.size());
+    representativesFitness.resize(published.size());
+    for(quint32 i = 0; i < published.size(); i++){
+        representatives[i] = *published[i]->getGenotype()->getData();
+        representativesFitness[i] = published[i]->getFitness();
+    }
+    population->releaseRepresentatives(set);
+}
+
+/**
+ * Return true if the state has the size and the genotype length of population.
+ */
+bool SaveEngine::PopulationState::matches(Population *population) const
 {
+    const vector<PopEntity *> &entities = population->getAllEntities();
+    if(genotypes.size() != entities.size() || entities.empty())
+        return false;
+    const int length = entities[0]->getGenotype()->getData()->size();
+    for(quint32 i = 0; i < genotypes.size(); i++){
+        if(genotypes[i].size() != length)
+            return false;
+    }
+    for(quint32 i = 0; i < representatives.size(); i++){
+        if(representatives[i].size() != length)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Overwrite the individuals of population and publish the saved representatives. The
+ * state must match the population.
+ */
+void SaveEngine::PopulationState::restore(Population *population) const
+{
+    Q_ASSERT(matches(population));
+
+    const vector<PopEntity *> &entities = population->getAllEntities();
+    for(quint32 i = 0; i < entities.size(); i++){
+        *entities[i]->getGenotype()->getData() = genotypes[i];
+        entities[i]->setFitness(fitness[i]);
+    }
+
+    vector<PopEntity *> published;
+    for(quint32 i = 0; i < representatives.size(); i++){
+        PopEntity *entity = new PopEntity(representatives[i].size());
+        *entity->getGenotype()->getData() = representatives[i];
+        entity->setFitness(representativesFitness[i]);
+        published.push_back(entity);
+    }
+    population->setRepresentativesCopy(published, published.size());
+    for(quint32 i = 0; i < published.size(); i++)
+        delete published[i];
+}
+
+/**
+ * Constructor, the thread must be started before the first checkpoint.
+ *
+ * @param fileName Checkpoint file, replaced by each new checkpoint
+ * @param interval Generations between two checkpoints
+ * @param populationCount Number of populations submitting their state
+ * @param run Index of the run among the runs of the script
+ * @param runData Data of the application saved with the populations, NULL for none
+ */
+SaveEngine::SaveEngine(const QString &fileName, quint32 interval, int populationCount, quint32 run, RunData *runData) :
+    fileName(fileName), interval(qMax((quint32) 1, interval)), populationCount(populationCount), runIndex(run), runData(runData),
+    stopping(false), pending(NULL), written(0), writeTime(0), lastGeneration(0)
+{
+}
+
+SaveEngine::~SaveEngine()
+{
+    finish();
+
+    delete pending;
+    const QList<quint32> generations = incomplete.keys();
+    for(int i = 0; i < generations.size(); i++)
+        qDeleteAll(incomplete.take(generations[i]));
+}
+
+/**
+ * Submit the state of a population at a checkpoint generation. The state of the last
+ * population completes the checkpoint, the data of the application is then captured
+ * by the calling thread.
+ *
+ * @param population Index of the population, below the population count
+ * @param state Captured state, owned by the engine
+ */
+void SaveEngine::submit(int population, PopulationState *state)
+{
+    Q_ASSERT(population >= 0 && population < populationCount);
+    const quint32 generation = state->generation;
+
+    lock.lock();
+    QVector<PopulationState *> &states = incomplete[generation];
+    if(states.isEmpty())
+        states.fill(NULL, populationCount);
+    delete states[population];
+    states[population] = state;
+    for(int i = 0; i < populationCount; i++){
+        if(states[i] == NULL){
+            lock.unlock();
+            return;
+        }
+    }
+
+    Checkpoint *checkpoint = new Checkpoint();
+    checkpoint->run = runIndex;
+    checkpoint->generation = generation;
+    checkpoint->populations = states;
+    incomplete.remove(generation);
+    // The populations which stopped before reaching an older checkpoint never complete it
+    const QList<quint32> generations = incomplete.keys();
+    for(int i = 0; i < generations.size(); i++){
+        if(generations[i] < generation)
+            qDeleteAll(incomplete.take(generations[i]));
+    }
+    lock.unlock();
+
+    if(runData != NULL)
+        checkpoint->runData = runData->capture(generation);
+
+    lock.lock();
+    if(pending == NULL || pending->generation < generation){
+        delete pending;
+        pending = checkpoint;
+        wakeUp.wakeAll();
+    }
+    else{
+        delete checkpoint;
+    }
+    lock.unlock();
+}
+
+/**
+ * Write the last complete checkpoint, if any, and stop the thread. The states submitted
+ * afterwards are never written.
+ */
+void SaveEngine::finish()
+{
+    lock.lock();
+    stopping = true;
+    wakeUp.wakeAll();
+    lock.unlock();
+    wait();
+}
+
+/**
+ * Print the number of checkpoints written and the time spent writing them.
+ */
+void SaveEngine::report()
+{
+    QMutexLocker locker(&lock);
+    if(written == 0){
+        qDebug() << "No checkpoint written to" << fileName;
+        return;
+    }
+    qDebug() << "Checkpoints : " << written << " written to " << fileName << ", last at generation "
+             << lastGeneration << ", mean write time " << (qreal) writeTime / written << " ms";
+}
+
+/**
+ * Read a checkpoint file.
+ *
+ * @return The checkpoint, to be deleted by the caller, or NULL if the file cannot be read
+ */
+SaveEngine::Checkpoint *SaveEngine::load(const QString &fileName)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly)){
+        qCritical() << "Cannot open the checkpoint" << fileName;
+        return NULL;
+    }
+    const QByteArray data = file.readAll();
+    file.close();
+
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_4_6);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if(magic != CHECKPOINT_MAGIC || version != CHECKPOINT_VERSION){
+        qCritical() << fileName << "is not a checkpoint of this version";
+        return NULL;
+    }
+
+    Checkpoint *checkpoint = new Checkpoint();
+    quint32 populationCount = 0;
+    in >> checkpoint->run >> checkpoint->generation >> populationCount;
+    for(quint32 p = 0; p < populationCount && in.status() == QDataStream::Ok; p++){
+        PopulationState *state = new PopulationState();
+        checkpoint->populations.append(state);
+        quint32 count = 0;
+        in >> state->generation >> state->randomState >> count;
+        for(quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++){
+            QBitArray genotype;
+            qreal fitness;
+            in >> genotype >> fitness;
+            state->genotypes.push_back(genotype);
+            state->fitness.push_back(fitness);
+        }
+        in >> count;
+        for(quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++){
+            QBitArray genotype;
+            qreal fitness;
+            in >> genotype >> fitness;
+            state->representatives.push_back(genotype);
+            state->representativesFitness.push_back(fitness);
+        }
+    }
+    in >> checkpoint->runData;
+
+    if(in.status() != QDataStream::Ok){
+        qCritical() << "The checkpoint" << fileName << "is truncated";
+        delete checkpoint;
+        return NULL;
+    }
+    return checkpoint;
+}
+
+/**
+ * Write the complete checkpoints until the engine is deleted.
+ */
+void SaveEngine::run()
+{
+    lock.lock();
+    for(;;){
+        while(pending == NULL && !stopping)
+            wakeUp.wait(&lock);
+        if(pending == NULL)
+            break;
+        Checkpoint *checkpoint = pending;
+        pending = NULL;
+        lock.unlock();
+
+        QTime timer;
+        timer.start();
+        const bool done = write(serialize(*checkpoint));
+        const int elapsed = timer.elapsed();
+
+        lock.lock();
+        if(done){
+            written++;
+            writeTime += elapsed;
+            lastGeneration = checkpoint->generation;
+        }
+        delete checkpoint;
+    }
+    lock.unlock();
+}
+
+QByteArray SaveEngine::serialize(const Checkpoint &checkpoint)
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << CHECKPOINT_MAGIC << CHECKPOINT_VERSION;
+    out << checkpoint.run << checkpoint.generation << (quint32) checkpoint.populations.size();
+    for(int p = 0; p < checkpoint.populations.size(); p++){
+        const PopulationState *state = checkpoint.populations[p];
+        out << state->generation << state->randomState << (quint32) state->genotypes.size();
+        for(quint32 i = 0; i < state->genotypes.size(); i++)
+            out << state->genotypes[i] << state->fitness[i];
+        out << (quint32) state->representatives.size();
+        for(quint32 i = 0; i < state->representatives.size(); i++)
+            out << state->representatives[i] << state->representativesFitness[i];
+    }
+    out << checkpoint.runData;
+    return data;
+}
+
+/**
+ * Replace the checkpoint file with data, through a temporary file.
+ */
+bool SaveEngine::write(const QByteArray &data)
+{
+    const QString tempName = fileName + ".tmp";
+    QFile file(tempName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(data) != data.size() || !file.flush()){
+        qCritical() << "Cannot write the checkpoint" << tempName;
+        file.close();
+        QFile::remove(tempName);
+        return false;
+    }
+    file.close();
+
+    if(!FileUtility::replaceFileAtomically(tempName, fileName)){
+        qCritical() << "Cannot replace the checkpoint" << fileName;
+        return false;
+    }
+    return true;
 }
@@ -1,14 +1,132 @@
+/**
+ * @file saveengine.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class SaveEngine
+ * @brief Writes the checkpoints a run can be resumed from.
+ *
+ * Every interval generations, each population captures its state at the end of the
+ * generation : its individuals and their fitness, its representatives and the state of
+ * the random stream of its thread. Capturing only copies the bit arrays, the evolution
+ * threads never serialize nor write anything. Once all the populations have submitted
+ * the same generation, the data of the application is captured too and the thread of
+ * the engine writes the checkpoint in binary form to a temporary file, which then
+ * replaces the previous checkpoint. A crash while writing leaves the previous one
+ * intact. If the previous checkpoint is still being written when the next one is
+ * complete, only the latest is kept.
+ */
+
 #ifndef SAVEENGINE_H
 #define SAVEENGINE_H
 
-#include "logger.h"
+#include <vector>
+#include <QBitArray>
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "population.h"
 
-class SaveEngine
+using namespace std;
+
+class SaveEngine : public QThread
 {
 public:
-    SaveEngine(Logger *logger);
+    // State of a population at the end of a generation
+    class PopulationState
+    {
+    public:
+        PopulationState();
+        void capture(Population *population, quint32 generation, quint64 randomState);
+        bool matches(Population *population) const;
+        void restore(Population *population) const;
+
+        quint32 generation;
+        quint64 randomState;
+        vector<QBitArray> genotypes;
+        vector<qreal> fitness;
+        vector<QBitArray> representatives;
+        vector<qreal> representativesFitness;
+    };
+
+    // Data of the application saved with the populations, captured by the evolution
+    // thread which completes a checkpoint
+    class RunData
+    {
+    public:
+        virtual ~RunData() {}
+        virtual QByteArray capture(quint32 generation) = 0;
+    };
+
+    // Content of a checkpoint file
+    class Checkpoint
+    {
+    public:
+        Checkpoint() : run(0), generation(0) {}
+        ~Checkpoint() {qDeleteAll(populations);}
+
+        // Index of the run among the runs of the script
+        quint32 run;
+        quint32 generation;
+        QVector<PopulationState *> populations;
+        QByteArray runData;
+    };
+
+    SaveEngine(const QString &fileName, quint32 interval, int populationCount, quint32 run, RunData *runData);
+    ~SaveEngine();
+
+    inline const QString &getFileName() const {return fileName;}
+    inline bool isCheckpointGeneration(quint32 generation) const {return generation > 0 && generation % interval == 0;}
+    void submit(int population, PopulationState *state);
+    void finish();
+    void report();
+
+    static Checkpoint *load(const QString &fileName);
+
+protected:
+    void run();
+
 private:
-    Logger *logger;
+    static QByteArray serialize(const Checkpoint &checkpoint);
+    bool write(const QByteArray &data);
+
+    QString fileName;
+    quint32 interval;
+    int populationCount;
+    quint32 runIndex;
+    RunData *runData;
+
+    QMutex lock;
+    QWaitCondition wakeUp;
+    bool stopping;
+    // States of the generations not submitted by every population yet
+    QHash<quint32, QVector<PopulationState *> > incomplete;
+    // Complete checkpoint waiting for the thread, NULL if none
+    Checkpoint *pending;
+    int written;
+    qint64 writeTime;
+    quint32 lastGeneration;
 };
 
 #endif // SAVEENGINE_H
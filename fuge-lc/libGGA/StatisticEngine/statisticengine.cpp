@@ -9,7 +9,7 @@ void StatisticEngine::addFitness(qreal fitness){
     if(fitness < minfitness || minfitness == 0.0)
         minfitness = fitness;
 
-    fitnesslist.append(fitness);
+    fitnesslist.push_back(fitness);
     meanfitness += fitness;
 }
 void StatisticEngine::buildStats(){
@@ -17,8 +17,8 @@ void StatisticEngine::buildStats(){
     meanfitness /= (qreal)fitnesslist.size();
 
     qreal temp;
-    for(int i = 0; i < fitnesslist.size(); i++){
-        temp = fitnesslist.at(i) -  meanfitness;
+    for(unsigned int i = 0; i < fitnesslist.size(); i++){
+        temp = fitnesslist[i] -  meanfitness;
         standardDeviation += (temp*temp);
     }
     standardDeviation /= (qreal)fitnesslist.size();
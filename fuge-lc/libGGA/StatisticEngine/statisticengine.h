@@ -19,7 +19,8 @@ public:
     qreal getStandardDeviation();
 
 private:
-    QList<qreal> fitnesslist;
+    // std::vector keeps its capacity on clear(), no allocation once warmed up
+    std::vector<qreal> fitnesslist;
     qreal minfitness;
     qreal maxfitness;
     qreal meanfitness;
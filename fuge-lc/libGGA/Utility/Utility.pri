@@ -1,9 +1,19 @@
 INCLUDEPATH += $$PWD
 DEPENDPATH += $$PWD
 
-SOURCES += $$PWD/qbitarrayutility.cpp \
-    $$PWD/randomgenerator.cpp
+SOURCES += $$PWD/barrier.cpp \
+    $$PWD/fileutility.cpp \
+    $$PWD/qbitarrayutility.cpp \
+    $$PWD/numatopology.cpp \
+    $$PWD/randomgenerator.cpp \
+    $$PWD/workstealingpool.cpp
     
-HEADERS += $$PWD/qbitarrayutility.h \
-    $$PWD/randomgenerator.h
+HEADERS += $$PWD/atomicops.h \
+    $$PWD/barrier.h \
+    $$PWD/fileutility.h \
+    $$PWD/qbitarrayutility.h \
+    $$PWD/numatopology.h \
+    $$PWD/randomgenerator.h \
+    $$PWD/spscring.h \
+    $$PWD/workstealingpool.h
     
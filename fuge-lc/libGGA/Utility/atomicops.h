@@ -0,0 +1,63 @@
+/**
+ * @file atomicops.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @brief Acquire loads and release stores on the Qt atomic types.
+ *
+ * Qt 5 provides loadAcquire() and storeRelease(). Qt 4 only orders its read-modify-write
+ * operations, a load is then an acquire fetch and add of 0 and a store a release
+ * exchange.
+ */
+
+#ifndef ATOMICOPS_H
+#define ATOMICOPS_H
+
+#include <QAtomicInt>
+#include <QAtomicPointer>
+
+inline int loadAcquire(const QAtomicInt &value)
+{
+#if QT_VERSION >= 0x050000
+    return value.loadAcquire();
+#else
+    return const_cast<QAtomicInt &>(value).fetchAndAddAcquire(0);
+#endif
+}
+
+inline void storeRelease(QAtomicInt &value, int newValue)
+{
+#if QT_VERSION >= 0x050000
+    value.storeRelease(newValue);
+#else
+    value.fetchAndStoreRelease(newValue);
+#endif
+}
+
+template <class T>
+inline T *loadAcquire(const QAtomicPointer<T> &value)
+{
+#if QT_VERSION >= 0x050000
+    return value.loadAcquire();
+#else
+    return const_cast<QAtomicPointer<T> &>(value).fetchAndAddAcquire(0);
+#endif
+}
+
+#endif // ATOMICOPS_H
@@ -0,0 +1,63 @@
+/**
+ * @file barrier.cpp
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class Barrier
+ * @brief A reusable barrier for a fixed set of threads.
+ */
+
+#include "barrier.h"
+
+Barrier::Barrier(int count) : count(count), arrived(0), phase(0)
+{
+}
+
+/**
+ * Block until all the remaining participants have called wait().
+ */
+void Barrier::wait()
+{
+    QMutexLocker locker(&lock);
+    const quint32 current = phase;
+    if(++arrived >= count){
+        release();
+        return;
+    }
+    while(phase == current)
+        phaseDone.wait(&lock);
+}
+
+/**
+ * Remove the calling participant, releasing the others if they were only waiting for it.
+ */
+void Barrier::leave()
+{
+    QMutexLocker locker(&lock);
+    count--;
+    if(arrived > 0 && arrived >= count)
+        release();
+}
+
+void Barrier::release()
+{
+    arrived = 0;
+    phase++;
+    phaseDone.wakeAll();
+}
@@ -0,0 +1,55 @@
+/**
+ * @file barrier.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class Barrier
+ * @brief A reusable barrier for a fixed set of threads.
+ *
+ * wait() blocks until every participant has reached the barrier, then all of them
+ * are released and the barrier is ready for the next phase. A participant which
+ * stops early calls leave(), the others do not wait for it anymore.
+ */
+
+#ifndef BARRIER_H
+#define BARRIER_H
+
+#include <QMutex>
+#include <QWaitCondition>
+
+class Barrier
+{
+public:
+    Barrier(int count);
+
+    void wait();
+    void leave();
+
+private:
+    void release();
+
+    QMutex lock;
+    QWaitCondition phaseDone;
+    int count;
+    int arrived;
+    // Incremented each time the participants are released
+    quint32 phase;
+};
+
+#endif // BARRIER_H
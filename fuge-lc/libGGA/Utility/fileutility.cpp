@@ -0,0 +1,56 @@
+/**
+ * @file fileutility.cpp
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class FileUtility
+ * @brief Helpers to write the files a reader may open at any time.
+ */
+
+#include "fileutility.h"
+
+#include <cstdio>
+#include <QFile>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+/**
+ * Replace fileName with the complete file tempName. The content of tempName is flushed to
+ * the disk first, so that a crash never leaves fileName empty. The rename is atomic on
+ * POSIX systems, elsewhere it fails if fileName exists and the previous file is removed
+ * first.
+ *
+ * @return false if tempName could not be renamed, it is then left as is
+ */
+bool FileUtility::replaceFileAtomically(const QString &tempName, const QString &fileName)
+{
+#ifdef Q_OS_UNIX
+    QFile file(tempName);
+    if(file.open(QIODevice::ReadOnly)){
+        fsync(file.handle());
+        file.close();
+    }
+#endif
+    if(std::rename(QFile::encodeName(tempName).constData(), QFile::encodeName(fileName).constData()) == 0)
+        return true;
+    QFile::remove(fileName);
+    return QFile::rename(tempName, fileName);
+}
@@ -0,0 +1,142 @@
+/**
+ * @file numatopology.cpp
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class NumaTopology
+ * @brief The NUMA nodes of the machine and the CPUs of each one.
+ */
+
+#include "numatopology.h"
+
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+#include <QtAlgorithms>
+
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#endif
+
+NumaTopology::NumaTopology()
+{
+}
+
+/**
+ * Build a topology from a script setting : empty for none, "auto" for the nodes of the
+ * machine, or the CPU lists of the nodes separated by ';'. A CPU may appear in several
+ * nodes, "0;0" simulates two nodes on a single CPU.
+ *
+ * @return false if the setting is not valid, the topology is then empty
+ */
+bool NumaTopology::fromSpec(const QString &spec, NumaTopology *topology)
+{
+    topology->nodes.clear();
+    const QString trimmed = spec.trimmed();
+    if (trimmed.isEmpty())
+        return true;
+    if (trimmed == "auto") {
+        *topology = detect();
+        return true;
+    }
+
+    QStringList lists = trimmed.split(';');
+    for (int i = 0; i < lists.size(); i++) {
+        QList<int> cpus;
+        if (!parseCpuList(lists.at(i), &cpus)) {
+            topology->nodes.clear();
+            return false;
+        }
+        topology->nodes.append(cpus);
+    }
+    return true;
+}
+
+/**
+ * Read the nodes of the machine. The topology is empty if the machine has a single node
+ * or does not report any, there is nothing to place then.
+ */
+NumaTopology NumaTopology::detect()
+{
+    NumaTopology topology;
+    QDir dir("/sys/devices/system/node");
+    QStringList entries = dir.entryList(QStringList() << "node*", QDir::Dirs);
+    // Node numbers in numeric order, node10 comes after node2
+    QList<int> numbers;
+    for (int i = 0; i < entries.size(); i++) {
+        bool ok = false;
+        const int number = entries.at(i).mid(4).toInt(&ok);
+        if (ok)
+            numbers.append(number);
+    }
+    qSort(numbers);
+    for (int i = 0; i < numbers.size(); i++) {
+        QFile file(dir.filePath(QString("node%1/cpulist").arg(numbers.at(i))));
+        if (!file.open(QIODevice::ReadOnly))
+            continue;
+        QList<int> cpus;
+        if (parseCpuList(QString(file.readAll()), &cpus))
+            topology.nodes.append(cpus);
+    }
+    if (topology.nodes.size() < 2)
+        topology.nodes.clear();
+    return topology;
+}
+
+/**
+ * Parse a CPU list in the format of the kernel, such as "0-3,8,10-11".
+ */
+bool NumaTopology::parseCpuList(const QString &list, QList<int> *cpus)
+{
+    QStringList ranges = list.trimmed().split(',');
+    for (int i = 0; i < ranges.size(); i++) {
+        QStringList bounds = ranges.at(i).trimmed().split('-');
+        bool firstOk = false;
+        bool lastOk = bounds.size() == 1;
+        const int first = bounds.at(0).toInt(&firstOk);
+        const int last = bounds.size() == 2 ? bounds.at(1).toInt(&lastOk) : first;
+        if (!firstOk || !lastOk || bounds.size() > 2 || first < 0 || last < first)
+            return false;
+        for (int cpu = first; cpu <= last; cpu++)
+            cpus->append(cpu);
+    }
+    return !cpus->isEmpty();
+}
+
+/**
+ * Restrict the calling thread to the CPUs of a node. Only supported on Linux.
+ *
+ * @return true if the thread is bound
+ */
+bool NumaTopology::bindCurrentThread(int node) const
+{
+#ifdef Q_OS_LINUX
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    const QList<int> &cpus = nodes.at(node);
+    for (int i = 0; i < cpus.size(); i++) {
+        if (cpus.at(i) < CPU_SETSIZE)
+            CPU_SET(cpus.at(i), &set);
+    }
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    Q_UNUSED(node);
+    return false;
+#endif
+}
@@ -0,0 +1,60 @@
+/**
+ * @file numatopology.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class NumaTopology
+ * @brief The NUMA nodes of the machine and the CPUs of each one.
+ *
+ * The nodes are read from /sys/devices/system/node, or given as a list of CPU lists to
+ * simulate a topology, for instance "0-3;4-7" for two nodes of four CPUs. A thread bound
+ * to a node only runs on its CPUs, and Linux places the memory it touches first on that
+ * node, so the data a worker allocates after being bound is local to it. An empty
+ * topology binds nothing.
+ */
+
+#ifndef NUMATOPOLOGY_H
+#define NUMATOPOLOGY_H
+
+#include <QList>
+#include <QString>
+#include <QVector>
+
+class NumaTopology
+{
+public:
+    NumaTopology();
+
+    static bool fromSpec(const QString &spec, NumaTopology *topology);
+    static NumaTopology detect();
+
+    inline bool isEnabled() const {return !nodes.isEmpty();}
+    inline int getNodeCount() const {return nodes.size();}
+    // Workers are dealt to the nodes in turn
+    inline int getNodeOfWorker(int worker) const {return nodes.isEmpty() ? 0 : worker % nodes.size();}
+    inline const QList<int> &getCpus(int node) const {return nodes.at(node);}
+    bool bindCurrentThread(int node) const;
+
+private:
+    static bool parseCpuList(const QString &list, QList<int> *cpus);
+
+    QVector<QList<int> > nodes;
+};
+
+#endif // NUMATOPOLOGY_H
@@ -28,3 +28,16 @@ QBitArray* QBitArrayUtility::bitArrayInvert(QBitArray *array)
     }
     return array;
 }
+
+/**
+ * Copy the content of source into destination, which must have the same size.
+ * Unlike the assignment operator, the storage of destination is kept so no
+ * allocation happens when destination is later modified.
+ */
+void QBitArrayUtility::copyBits(QBitArray *destination, const QBitArray *source)
+{
+    Q_ASSERT(destination->size() == source->size());
+    // (d & s) | s == s, both operators work in place on an unshared array.
+    *destination &= *source;
+    *destination |= *source;
+}
@@ -11,6 +11,7 @@ public:
     static uint bitArray2Uint(QBitArray *array);
     static QString bitArray2String(QBitArray *array);
     static QBitArray *bitArrayInvert(QBitArray *array);
+    static void copyBits(QBitArray *destination, const QBitArray *source);
 };
 
 #endif // QBITARRAYUTILITY_H
@@ -24,8 +24,10 @@
  * @brief A random generator
  *
  * RandomGenerator is a random generator, thread safe.
- * It uses the Qt function qsrand and qrand to be multi-platform
- * compatible.
+ * Every thread draws from its own xorshift64* stream, seeded from the clock
+ * unless seed() is called, so the threads never contend for it. Two streams
+ * seeded alike give the same numbers on every platform, and the state of a
+ * stream can be saved and restored to continue the same sequence.
  * RangomGenerator works as a singleton and by so
  * no pointer of it should be kept on the user code.
  */
@@ -43,7 +45,6 @@ const qreal RandomGenerator::RANDMAX_PLUSONE = (qreal)RAND_MAX+1;
 RandomGenerator::RandomGenerator() :
     QThread()
 {
-    resetSeed();
 }
 
 RandomGenerator *RandomGenerator::getGeneratorInstance(){
@@ -58,28 +59,71 @@ RandomGenerator *RandomGenerator::getGeneratorInstance(){
 
 qint32 RandomGenerator::random(qint32 min, qint32 max){
     if(min > max){
-        return (qrand() / RANDMAX_PLUSONE) * (min-max+1);
+        return (next() / RANDMAX_PLUSONE) * (min-max+1);
     }else{
-        return (qrand() / RANDMAX_PLUSONE) * (max+1-min);
+        return (next() / RANDMAX_PLUSONE) * (max+1-min);
     }
 }
 
 qreal RandomGenerator::randomReal(qreal min, qreal max){
     if(min > max){
-        return ((qreal)qrand() / (qreal)RANDMAX_PLUSONE) * (min-max);
+        return ((qreal)next() / (qreal)RANDMAX_PLUSONE) * (min-max);
     }else{
-        return ((qreal)qrand() / (qreal)RANDMAX_PLUSONE) * (max-min);
+        return ((qreal)next() / (qreal)RANDMAX_PLUSONE) * (max-min);
     }
 }
 
 qint32 RandomGenerator::randomNoRandMax(qint32 min, qint32 max){
     if(min < max){
-        return qrand()%(max-min+1) + min;
+        return next()%(max-min+1) + min;
     }else{
-        return qrand()%(min-max+1) + max;
+        return next()%(min-max+1) + max;
     }
 }
 
+quint64 RandomGenerator::randomWord(){
+    quint64 &state = threadState();
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * Q_UINT64_C(2685821657736338717);
+}
+
 void RandomGenerator::resetSeed(){
-    qsrand(QTime::currentTime().msec());
+    // The address of the state tells apart the threads seeded in the same millisecond
+    quint64 &state = threadState();
+    seed(((quint64) QTime::currentTime().msec() << 48) ^ (quint64) (quintptr) &state);
+}
+
+void RandomGenerator::seed(quint64 value){
+    // splitmix64, so that close values give unrelated streams
+    value += Q_UINT64_C(0x9E3779B97F4A7C15);
+    value = (value ^ (value >> 30)) * Q_UINT64_C(0xBF58476D1CE4E5B9);
+    value = (value ^ (value >> 27)) * Q_UINT64_C(0x94D049BB133111EB);
+    value ^= value >> 31;
+    setState(value);
+}
+
+quint64 RandomGenerator::getState(){
+    return threadState();
+}
+
+void RandomGenerator::setState(quint64 state){
+    // The state of a xorshift generator must never be zero
+    threadState() = state != 0 ? state : Q_UINT64_C(0x9E3779B97F4A7C15);
+}
+
+/**
+ * Returns a random number between 0 and RAND_MAX.
+ */
+qint32 RandomGenerator::next(){
+    return (qint32) ((randomWord() >> 33) % ((quint64) RAND_MAX + 1));
+}
+
+quint64 &RandomGenerator::threadState(){
+    if(!states.hasLocalData()){
+        states.setLocalData(new quint64(Q_UINT64_C(0x9E3779B97F4A7C15)));
+        resetSeed();
+    }
+    return *states.localData();
 }
@@ -24,8 +24,10 @@
  * @brief A random generator
  *
  * RandomGenerator is a random generator, thread safe.
- * It uses the Qt function qsrand and qrand to be multi-platform
- * compatible.
+ * Every thread draws from its own xorshift64* stream, seeded from the clock
+ * unless seed() is called, so the threads never contend for it. Two streams
+ * seeded alike give the same numbers on every platform, and the state of a
+ * stream can be saved and restored to continue the same sequence.
  * RangomGenerator works as a singleton and by so
  * no pointer of it should be kept on the user code.
  */
@@ -38,6 +40,7 @@
 #include <QTime>
 #include <QLinkedList>
 #include <QThread>
+#include <QThreadStorage>
 #include <memory>
 
 using namespace std;
@@ -98,19 +101,56 @@ public:
       */
     qint32 randomNoRandMax(qint32 min, qint32 max);
 
+    /**
+      * Get 64 random bits.
+      *
+      * @return word
+      *     a random word.
+      */
+    quint64 randomWord();
+
     /**
       * Reset the seed.
       *
-      * Reinitialize the current seed.
+      * Reinitialize the stream of the calling thread from the clock.
       */
     void resetSeed();
 
+    /**
+      * Seed the stream of the calling thread.
+      *
+      * @param value
+      *     any value, the streams of different values are unrelated.
+      */
+    void seed(quint64 value);
+
+    /**
+      * Get the state of the stream of the calling thread.
+      *
+      * @return state
+      *     the state to give to setState() to continue the same sequence.
+      */
+    quint64 getState();
+
+    /**
+      * Restore the stream of the calling thread.
+      *
+      * @param state
+      *     a state returned by getState().
+      */
+    void setState(quint64 state);
+
 protected:
     RandomGenerator();
 
 private:
+    qint32 next();
+    quint64 &threadState();
+
     //static auto_ptr<RandomGenerator> randomGenerator;
     static RandomGenerator* randomGenerator;
+    // State of the stream of each thread, never zero
+    QThreadStorage<quint64 *> states;
 
     static const qreal RANDMAX_PLUSONE;
     static QMutex mutex;
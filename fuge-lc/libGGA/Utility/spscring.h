@@ -0,0 +1,114 @@
+/**
+ * @file spscring.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class SpscRing
+ * @brief Lock free ring of items between a single producer and a single consumer.
+ *
+ * The producer never waits : the items pushed while the ring is full are dropped and
+ * counted. The capacity is rounded up to a power of two.
+ */
+
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <QAtomicInt>
+#include <QVector>
+
+#include "atomicops.h"
+
+template <class T>
+class SpscRing
+{
+public:
+    SpscRing(int capacity);
+
+    bool push(const T *items, int count);
+    inline bool push(const T &item) {return push(&item, 1);}
+    int pop(T *items, int count);
+    inline int getDropped() const {return dropped;}
+
+private:
+    static quint32 roundCapacity(int capacity);
+
+    QVector<T> buffer;
+    const quint32 mask;
+    // Next position written by the producer and next position read by the consumer
+    QAtomicInt head;
+    QAtomicInt tail;
+    // Items dropped because the ring was full, written by the producer only
+    int dropped;
+};
+
+/**
+ * @param capacity Number of items, rounded up to a power of two
+ */
+template <class T>
+SpscRing<T>::SpscRing(int capacity) :
+    buffer(roundCapacity(capacity)), mask(roundCapacity(capacity) - 1), head(0), tail(0), dropped(0)
+{
+}
+
+template <class T>
+quint32 SpscRing<T>::roundCapacity(int capacity)
+{
+    quint32 size = 1;
+    while(size < (quint32) capacity)
+        size <<= 1;
+    return size;
+}
+
+/**
+ * Append count items, all of them or none. Called by the producer only, never waits.
+ *
+ * @return false if the ring is full, the items are then counted as dropped
+ */
+template <class T>
+bool SpscRing<T>::push(const T *items, int count)
+{
+    const quint32 position = (quint32) loadAcquire(head);
+    if((quint32) buffer.size() - (position - (quint32) loadAcquire(tail)) < (quint32) count){
+        dropped += count;
+        return false;
+    }
+    for(int i = 0; i < count; i++)
+        buffer[(position + i) & mask] = items[i];
+    storeRelease(head, (int) (position + count));
+    return true;
+}
+
+/**
+ * Remove up to count items, oldest first. Called by the consumer only.
+ *
+ * @return The number of items copied to items
+ */
+template <class T>
+int SpscRing<T>::pop(T *items, int count)
+{
+    const quint32 position = (quint32) loadAcquire(tail);
+    const quint32 available = (quint32) loadAcquire(head) - position;
+    const int n = qMin((quint32) count, available);
+    for(int i = 0; i < n; i++)
+        items[i] = buffer[(position + i) & mask];
+    storeRelease(tail, (int) (position + n));
+    return n;
+}
+
+#endif // SPSCRING_H
@@ -0,0 +1,195 @@
+/**
+ * @file workstealingpool.cpp
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class WorkStealingPool
+ * @brief A pool of worker threads running parallel loops.
+ */
+
+#include "workstealingpool.h"
+
+#include <QDebug>
+
+/**
+ * Start the workers. The setup, if any, must stay valid until the pool is deleted.
+ */
+WorkStealingPool::WorkStealingPool(int workerCount, const NumaTopology &topology, WorkerSetup *setup) :
+    topology(topology), setup(setup), queued(0), quit(false), nextQueue(0)
+{
+    for(int i = 0; i < qMax(1, workerCount); i++)
+        queues.append(new Queue());
+    for(int i = 0; i < queues.size(); i++){
+        workers.append(new Worker(this, i));
+        workers[i]->start();
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    sleepLock.lock();
+    quit = true;
+    available.wakeAll();
+    sleepLock.unlock();
+    for(int i = 0; i < workers.size(); i++){
+        workers[i]->wait();
+        delete workers[i];
+    }
+    for(int i = 0; i < queues.size(); i++)
+        delete queues[i];
+}
+
+/**
+ * Execute job on the indices [0, count), in chunks of grain indices, and wait until
+ * all of them are done. The calling thread executes the chunks no worker took yet.
+ */
+void WorkStealingPool::run(Job *job, quint32 count, quint32 grain)
+{
+    if(count == 0)
+        return;
+    grain = qMax((quint32) 1, grain);
+    const quint32 chunkCount = getChunkCount(count, grain);
+
+    Progress progress;
+    progress.remaining.fetchAndStoreOrdered(chunkCount);
+    progress.finished = false;
+
+    const int first = nextQueue.fetchAndAddOrdered(1);
+    for(quint32 i = 0; i < chunkCount; i++){
+        Chunk chunk;
+        chunk.job = job;
+        chunk.index = i;
+        chunk.begin = i * grain;
+        chunk.end = qMin(count, chunk.begin + grain);
+        chunk.progress = &progress;
+        Queue *queue = queues[(quint32) (first + i) % queues.size()];
+        QMutexLocker locker(&queue->lock);
+        queue->chunks.push_back(chunk);
+    }
+    queued.fetchAndAddOrdered(chunkCount);
+    sleepLock.lock();
+    available.wakeAll();
+    sleepLock.unlock();
+
+    // Take part in the job, then the last worker to finish a chunk of it wakes us up
+    const int self = currentWorker();
+    Chunk chunk;
+    while(takeOwn(&progress, chunk)){
+        queued.fetchAndAddOrdered(-1);
+        execute(self, chunk);
+    }
+    progress.lock.lock();
+    while(!progress.finished)
+        progress.done.wait(&progress.lock);
+    progress.lock.unlock();
+}
+
+/**
+ * Take a chunk from the back of our queue, or steal one from the front of another.
+ */
+bool WorkStealingPool::take(int worker, Chunk &chunk)
+{
+    {
+        Queue *own = queues[worker];
+        QMutexLocker locker(&own->lock);
+        if(!own->chunks.empty()){
+            chunk = own->chunks.back();
+            own->chunks.pop_back();
+            return true;
+        }
+    }
+    for(int i = 1; i < queues.size(); i++){
+        Queue *victim = queues[(worker + i) % queues.size()];
+        QMutexLocker locker(&victim->lock);
+        if(!victim->chunks.empty()){
+            chunk = victim->chunks.front();
+            victim->chunks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Take a chunk of the job of progress from any queue, for the thread running the job.
+ */
+bool WorkStealingPool::takeOwn(const Progress *progress, Chunk &chunk)
+{
+    for(int i = 0; i < queues.size(); i++){
+        Queue *queue = queues[i];
+        QMutexLocker locker(&queue->lock);
+        for(std::deque<Chunk>::iterator it = queue->chunks.begin(); it != queue->chunks.end(); ++it){
+            if(it->progress == progress){
+                chunk = *it;
+                queue->chunks.erase(it);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Return the index of the worker running the calling thread, -1 for another thread.
+ */
+int WorkStealingPool::currentWorker() const
+{
+    QThread *thread = QThread::currentThread();
+    for(int i = 0; i < workers.size(); i++){
+        if(workers[i] == thread)
+            return i;
+    }
+    return -1;
+}
+
+void WorkStealingPool::execute(int worker, const Chunk &chunk)
+{
+    chunk.job->execute(worker, chunk.index, chunk.begin, chunk.end);
+    if(chunk.progress->remaining.fetchAndAddOrdered(-1) == 1){
+        chunk.progress->lock.lock();
+        chunk.progress->finished = true;
+        chunk.progress->done.wakeAll();
+        chunk.progress->lock.unlock();
+    }
+}
+
+void WorkStealingPool::Worker::run()
+{
+    const int node = pool->topology.getNodeOfWorker(index);
+    if (pool->topology.isEnabled() && !pool->topology.bindCurrentThread(node))
+        qWarning() << "Could not bind worker" << index << "to NUMA node" << node;
+    if (pool->setup != NULL)
+        pool->setup->setupWorker(index, node);
+
+    Chunk chunk;
+    for(;;){
+        if(pool->take(index, chunk)){
+            pool->queued.fetchAndAddOrdered(-1);
+            pool->execute(index, chunk);
+            continue;
+        }
+        pool->sleepLock.lock();
+        while(!pool->quit && pool->queued.fetchAndAddOrdered(0) <= 0)
+            pool->available.wait(&pool->sleepLock);
+        const bool quit = pool->quit;
+        pool->sleepLock.unlock();
+        if(quit)
+            return;
+    }
+}
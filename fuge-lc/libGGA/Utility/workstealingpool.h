@@ -0,0 +1,128 @@
+/**
+ * @file workstealingpool.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class WorkStealingPool
+ * @brief A pool of worker threads running parallel loops.
+ *
+ * A job covers the indices [0, count) and is split in chunks of grain indices.
+ * The chunks are dealt to the per worker queues, each worker takes the chunks of
+ * its own queue from the back and steals from the front of the others once its
+ * queue is empty. Several threads can run jobs on the same pool at the same time,
+ * run() returns once all the chunks of its job are done. The calling thread executes
+ * chunks of its job too while it waits, so a worker can run a nested job on its own
+ * pool.
+ *
+ * Each chunk is executed with its own index, in [0, getChunkCount()), and the index of
+ * the worker running it, which lets the caller keep one result per chunk and one
+ * evaluation context per worker. The worker index is -1 for a chunk executed by a
+ * calling thread which is not a worker of the pool. With a NUMA topology, each worker is
+ * bound to a node before it runs anything, and the optional setup lets it allocate its
+ * context itself, on its own node.
+ */
+
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+#include <deque>
+
+#include "numatopology.h"
+
+class WorkStealingPool
+{
+public:
+    class Job
+    {
+    public:
+        virtual ~Job() {}
+        virtual void execute(int worker, quint32 chunk, quint32 begin, quint32 end) = 0;
+    };
+
+    class WorkerSetup
+    {
+    public:
+        virtual ~WorkerSetup() {}
+        // Called once by each worker, before it executes any chunk
+        virtual void setupWorker(int worker, int node) = 0;
+    };
+
+    WorkStealingPool(int workerCount, const NumaTopology &topology = NumaTopology(), WorkerSetup *setup = NULL);
+    ~WorkStealingPool();
+
+    inline int getWorkerCount() const {return workers.size();}
+    inline int getWorkerNode(int worker) const {return topology.getNodeOfWorker(worker);}
+    void run(Job *job, quint32 count, quint32 grain);
+    // Number of chunks run() splits count indices in
+    static inline quint32 getChunkCount(quint32 count, quint32 grain) {return (count + qMax((quint32) 1, grain) - 1) / qMax((quint32) 1, grain);}
+
+private:
+    struct Progress;
+    struct Chunk {
+        Job *job;
+        quint32 index;
+        quint32 begin;
+        quint32 end;
+        Progress *progress;
+    };
+    struct Progress {
+        QAtomicInt remaining;
+        // Set under lock by the last chunk, the job owner may not leave before
+        bool finished;
+        QMutex lock;
+        QWaitCondition done;
+    };
+    struct Queue {
+        QMutex lock;
+        std::deque<Chunk> chunks;
+    };
+    class Worker : public QThread
+    {
+    public:
+        Worker(WorkStealingPool *pool, int index) : pool(pool), index(index) {}
+        void run();
+    private:
+        WorkStealingPool *pool;
+        int index;
+    };
+
+    bool take(int worker, Chunk &chunk);
+    bool takeOwn(const Progress *progress, Chunk &chunk);
+    int currentWorker() const;
+    void execute(int worker, const Chunk &chunk);
+
+    NumaTopology topology;
+    WorkerSetup *setup;
+    QVector<Worker *> workers;
+    QVector<Queue *> queues;
+    // Number of queued chunks, workers sleep on available when it is 0
+    QAtomicInt queued;
+    QMutex sleepLock;
+    QWaitCondition available;
+    bool quit;
+    // Queue receiving the first chunk of the next job, to spread small jobs
+    QAtomicInt nextQueue;
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -2,7 +2,9 @@ INCLUDEPATH += $$PWD
 DEPENDPATH += $$PWD
 
 include(EvolutionEngine/EvolutionEngine.pri)
+include(Logger/Logger.pri)
 include(Population/Population.pri)
+include(SaveEngine/SaveEngine.pri)
 include(StatisticEngine/StatisticEngine.pri)
 include(Utility/Utility.pri)
 
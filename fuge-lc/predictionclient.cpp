@@ -0,0 +1,189 @@
+/**
+  * @file   predictionclient.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class PredictionClient
+  * @brief Sends requests to a prediction server and waits for their replies.
+  */
+
+#include <iostream>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QVector>
+#include <QtAlgorithms>
+#include <QDebug>
+
+#include "predictionclient.h"
+
+/**
+  * Connect to a prediction server.
+  *
+  * @param name Local socket name of the server
+  * @return false if the server does not answer
+  */
+bool PredictionClient::connectToServer(const QString &name)
+{
+    socket.connectToServer(name);
+    if (!socket.waitForConnected(TIMEOUT)) {
+        qCritical() << "Prediction client : cannot connect to" << name << ":" << socket.errorString();
+        return false;
+    }
+    return true;
+}
+
+/**
+  * Send a request and wait for its reply.
+  *
+  * @param line Request, without newline
+  * @param reply Receives the reply, without newline
+  * @return false if the server did not reply or replied an error
+  */
+bool PredictionClient::request(const QByteArray &line, QByteArray *reply)
+{
+    socket.write(line);
+    socket.write("\n", 1);
+    socket.flush();
+    while (!socket.canReadLine()) {
+        if (!socket.waitForReadyRead(TIMEOUT))
+            return false;
+    }
+    *reply = socket.readLine().trimmed();
+    return !reply->startsWith("error;");
+}
+
+/**
+  * Sends its share of the requests of a load test and records their latencies.
+  */
+class LoadTestThread : public QThread
+{
+public:
+    LoadTestThread(const QString &name, const QList<QByteArray> *lines, int first, int step, int count) :
+        name(name), lines(lines), first(first), step(step), count(count), failed(false) {}
+
+    void run()
+    {
+        PredictionClient client;
+        if (!client.connectToServer(name)) {
+            failed = true;
+            return;
+        }
+        latencies.reserve(count);
+        QByteArray reply;
+        QElapsedTimer timer;
+        for (int i = 0; i < count; i++) {
+            timer.start();
+            if (!client.request(lines->at((first + (qint64) i*step) % lines->size()), &reply)) {
+                qCritical() << "Prediction client :" << (reply.isEmpty() ? QByteArray("no reply") : reply);
+                failed = true;
+                return;
+            }
+            latencies.append(timer.nsecsElapsed());
+        }
+    }
+
+    QVector<qint64> latencies;
+    bool failed;
+
+private:
+    const QString name;
+    const QList<QByteArray> *lines;
+    const int first;
+    const int step;
+    const int count;
+};
+
+/**
+  * Send the samples of a dataset to a prediction server from several threads and print
+  * the throughput and the latencies.
+  *
+  * @param name Local socket name of the server
+  * @param model Name of the fuzzy system served
+  * @param dataset Samples, the first row holds the names of the columns
+  * @param clients Number of connections sending requests at the same time
+  * @param requests Number of requests of all the connections, the samples are reused
+  * @return The exit code of the application
+  */
+int PredictionClient::loadTest(const QString &name, const QString &model, const QList<QStringList> &dataset,
+                               int clients, int requests)
+{
+    // The server lists the inputs of the system, they are taken from the columns of the same name
+    PredictionClient client;
+    QByteArray inputs;
+    if (!client.connectToServer(name) || !client.request(model.toUtf8(), &inputs)) {
+        qCritical() << "Prediction client : the server does not serve" << model;
+        return 1;
+    }
+    const QStringList names = QString::fromUtf8(inputs.constData(), inputs.size()).split(';');
+    QList<int> columns;
+    for (int i = 0; i < names.size(); i++) {
+        const int column = dataset.isEmpty() ? -1 : dataset.at(0).indexOf(names.at(i));
+        if (column < 0) {
+            qCritical() << "Prediction client : the dataset has no column" << names.at(i);
+            return 1;
+        }
+        columns.append(column);
+    }
+    QList<QByteArray> lines;
+    for (int k = 1; k < dataset.size(); k++) {
+        QStringList row;
+        row.append(model);
+        for (int i = 0; i < columns.size(); i++)
+            row.append(dataset.at(k).value(columns.at(i)));
+        lines.append(row.join(";").toUtf8());
+    }
+    if (lines.isEmpty() || clients < 1 || requests < clients) {
+        qCritical() << "Prediction client : nothing to send";
+        return 1;
+    }
+
+    QList<LoadTestThread *> threads;
+    for (int i = 0; i < clients; i++)
+        threads.append(new LoadTestThread(name, &lines, i, clients, requests / clients + (i < requests % clients ? 1 : 0)));
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < clients; i++)
+        threads[i]->start();
+    QVector<qint64> latencies;
+    bool failed = false;
+    for (int i = 0; i < clients; i++) {
+        threads[i]->wait();
+        latencies += threads[i]->latencies;
+        failed = failed || threads[i]->failed;
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+    qDeleteAll(threads);
+    if (latencies.isEmpty())
+        return 1;
+
+    qSort(latencies);
+    qint64 total = 0;
+    for (int i = 0; i < latencies.size(); i++)
+        total += latencies[i];
+    const int last = latencies.size() - 1;
+    std::cout << "Requests : " << latencies.size() << " from " << clients << " clients in " << elapsed / 1e9 << " s" << std::endl;
+    std::cout << "Throughput : " << latencies.size() / (elapsed / 1e9) << " requests/s" << std::endl;
+    std::cout << "Latency (us) : mean " << total / latencies.size() / 1e3
+              << ", p50 " << latencies[last / 2] / 1e3
+              << ", p90 " << latencies[(int) ((qint64) last * 9 / 10)] / 1e3
+              << ", p99 " << latencies[(int) ((qint64) last * 99 / 100)] / 1e3
+              << ", max " << latencies[last] / 1e3 << std::endl;
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,55 @@
+/**
+  * @file   predictionclient.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  * @class PredictionClient
+  * @brief Sends requests to a prediction server and waits for their replies.
+  *
+  * The client blocks, it must be created in the thread using it. loadTest() measures the
+  * latency and the throughput of a server : each client thread sends one sample of a
+  * dataset at a time and waits for its reply before sending the next one, so that the
+  * server sees as many concurrent requests as there are clients.
+  */
+
+#ifndef PREDICTIONCLIENT_H
+#define PREDICTIONCLIENT_H
+
+#include <QByteArray>
+#include <QList>
+#include <QLocalSocket>
+#include <QStringList>
+
+class PredictionClient
+{
+public:
+    // Time to wait for the server, in milliseconds
+    static const int TIMEOUT = 10000;
+
+    bool connectToServer(const QString &name);
+    bool request(const QByteArray &line, QByteArray *reply);
+
+    static int loadTest(const QString &name, const QString &model, const QList<QStringList> &dataset,
+                        int clients, int requests);
+
+private:
+    QLocalSocket socket;
+};
+
+#endif // PREDICTIONCLIENT_H
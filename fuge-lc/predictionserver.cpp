@@ -0,0 +1,342 @@
+/**
+  * @file   predictionserver.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class PredictionServer
+  * @brief Serves the predictions of fuzzy systems kept loaded, on a local socket.
+  */
+
+#include <iostream>
+#include <QFile>
+#include <QFileInfo>
+#include <QDebug>
+
+#include "predictionserver.h"
+#include "fuzzysystem.h"
+#include "numericdataset.h"
+#include "systemparameters.h"
+
+// Longest request line, a client sending more without a newline is disconnected
+static const qint64 MAX_REQUEST_SIZE = 1 << 16;
+
+PredictionServer::Model::~Model()
+{
+    delete fSystem;
+}
+
+/**
+  * Constructor
+  */
+PredictionServer::PredictionServer(QObject *parent) :
+    QObject(parent), processScheduled(false)
+{
+    server = new QLocalServer(this);
+    connect(server, SIGNAL(newConnection()), this, SLOT(onNewConnection()));
+    watcher = new QFileSystemWatcher(this);
+    connect(watcher, SIGNAL(fileChanged(QString)), this, SLOT(onFileChanged(QString)));
+    reloadTimer = new QTimer(this);
+    reloadTimer->setSingleShot(true);
+    reloadTimer->setInterval(RELOAD_DELAY);
+    connect(reloadTimer, SIGNAL(timeout()), this, SLOT(reloadModels()));
+}
+
+PredictionServer::~PredictionServer()
+{
+    qDeleteAll(models);
+}
+
+/**
+  * Load a fuzzy system and serve it under the base name of its file.
+  *
+  * @return false if the file cannot be loaded or its name is already served
+  */
+bool PredictionServer::addModel(const QString &fileName)
+{
+    Model *model = loadModel(QFileInfo(fileName).absoluteFilePath());
+    if (model == NULL)
+        return false;
+    if (findModel(model->name) >= 0) {
+        qCritical() << "Prediction server : a system named" << model->name << "is already served";
+        delete model;
+        return false;
+    }
+    models.append(model);
+    watcher->addPath(model->fileName);
+    return true;
+}
+
+/**
+  * Start listening for clients.
+  *
+  * @param name Local socket name
+  * @return false if the name cannot be listened on
+  */
+bool PredictionServer::listen(const QString &name)
+{
+    // The socket of a server which crashed is left behind, a restarted server replaces it
+    QLocalServer::removeServer(name);
+    if (!server->listen(name)) {
+        qCritical() << "Prediction server : cannot listen on" << name << ":" << server->errorString();
+        return false;
+    }
+    std::cout << "Prediction server listening on " << name.toStdString() << ", serving";
+    for (int i = 0; i < models.size(); i++)
+        std::cout << " " << models[i]->name.toStdString();
+    std::cout << std::endl;
+    return true;
+}
+
+/**
+  * Load a fuzzy system file and make the columns of its requests.
+  *
+  * @return The model, or NULL if the file cannot be loaded
+  */
+PredictionServer::Model *PredictionServer::loadModel(const QString &fileName)
+{
+    Model *model = new Model();
+    model->fileName = fileName;
+    model->name = QFileInfo(fileName).completeBaseName();
+    model->fSystem = new FuzzySystem();
+    if (!model->fSystem->loadFromFile(fileName) || model->fSystem->getNbOutVars() == 0) {
+        qCritical() << "Prediction server : cannot load the fuzzy system" << fileName;
+        delete model;
+        return NULL;
+    }
+    model->params.load(SystemParameters::getInstance());
+    model->fSystem->setEvaluationParameters(&model->params);
+
+    // A request is a sample named after the system, with the input variables as columns
+    QStringList columns;
+    columns.append(model->name);
+    for (int i = 0; i < model->fSystem->getNbInVars(); i++)
+        columns.append(model->fSystem->getInVar(i)->getName());
+    model->header.append(columns);
+    model->fSystem->loadData(&model->header);
+    for (int i = 1; i < columns.size(); i++) {
+        if (i > 1)
+            model->inputNames.append(';');
+        model->inputNames.append(columns.at(i).toUtf8());
+    }
+    return model;
+}
+
+/**
+  * Return the index of the model named name, or -1 if there is none.
+  */
+int PredictionServer::findModel(const QString &name) const
+{
+    for (int i = 0; i < models.size(); i++) {
+        if (models[i]->name == name)
+            return i;
+    }
+    return -1;
+}
+
+void PredictionServer::onNewConnection()
+{
+    while (server->hasPendingConnections()) {
+        QLocalSocket *socket = server->nextPendingConnection();
+        connect(socket, SIGNAL(readyRead()), this, SLOT(onReadyRead()));
+        connect(socket, SIGNAL(disconnected()), this, SLOT(onDisconnected()));
+        connect(socket, SIGNAL(disconnected()), socket, SLOT(deleteLater()));
+    }
+}
+
+/**
+  * Drop the requests of a client which went away, they are neither evaluated nor
+  * answered. The queue keeps its order, the signal may come while the replies are written.
+  */
+void PredictionServer::onDisconnected()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    for (int i = 0; i < pending.size(); i++) {
+        if (pending[i].socket == socket) {
+            pending[i].socket = NULL;
+            pending[i].model = -1;
+        }
+    }
+}
+
+/**
+  * Queue the complete requests of a client, they are answered once the event loop has
+  * read the ones of the other clients.
+  */
+void PredictionServer::onReadyRead()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    if (socket == NULL)
+        return;
+    while (socket->canReadLine())
+        parseRequest(socket, socket->readLine());
+    if (socket->bytesAvailable() > MAX_REQUEST_SIZE) {
+        qCritical() << "Prediction server : request too long, closing the connection";
+        socket->abort();
+    }
+
+    if (!pending.isEmpty() && !processScheduled) {
+        processScheduled = true;
+        QTimer::singleShot(0, this, SLOT(processRequests()));
+    }
+}
+
+/**
+  * Queue a request, with its reply if it needs no evaluation.
+  */
+void PredictionServer::parseRequest(QLocalSocket *socket, const QByteArray &line)
+{
+    const QByteArray text = line.trimmed();
+    if (text.isEmpty())
+        return;
+
+    Request request;
+    request.socket = socket;
+    request.model = -1;
+    const QStringList row = QString::fromUtf8(text.constData(), text.size()).split(';');
+    const int model = findModel(row.at(0));
+    if (model < 0) {
+        request.reply = "error;unknown fuzzy system " + row.at(0).toUtf8();
+    }
+    else if (row.size() == 1) {
+        request.reply = models[model]->inputNames;
+    }
+    else if (row.size() != models[model]->header.at(0).size()) {
+        request.reply = "error;" + QByteArray::number(models[model]->header.at(0).size() - 1) + " values expected";
+    }
+    else {
+        request.model = model;
+        request.row = row;
+    }
+    pending.append(request);
+}
+
+/**
+  * Evaluate the queued requests, one evaluation per system, and write the replies in the
+  * order the requests came in.
+  */
+void PredictionServer::processRequests()
+{
+    processScheduled = false;
+    for (int i = 0; i < models.size(); i++)
+        evaluateModel(i);
+
+    // A client may disconnect while its replies are written, the guarded pointers of the
+    // sockets deleted meanwhile are null
+    QList<QPointer<QLocalSocket> > written;
+    for (int i = 0; i < pending.size(); i++) {
+        QLocalSocket *socket = pending[i].socket;
+        if (socket == NULL || socket->state() != QLocalSocket::ConnectedState)
+            continue;
+        pending[i].reply.append('\n');
+        socket->write(pending[i].reply);
+        if (!written.contains(socket))
+            written.append(socket);
+    }
+    // Each client gets all its replies at once
+    for (int i = 0; i < written.size(); i++) {
+        if (!written[i].isNull())
+            written[i]->flush();
+    }
+    pending.clear();
+}
+
+/**
+  * Evaluate all the queued requests of a model as the samples of one dataset.
+  */
+void PredictionServer::evaluateModel(int model)
+{
+    QList<int> requests;
+    for (int i = 0; i < pending.size(); i++) {
+        if (pending[i].model == model)
+            requests.append(i);
+    }
+    if (requests.isEmpty())
+        return;
+
+    Model *served = models[model];
+    QList<QStringList> rows;
+    rows.append(served->header.at(0));
+    for (int i = 0; i < requests.size(); i++)
+        rows.append(pending[requests[i]].row);
+    const NumericDataset samples(&rows);
+
+    const int nbOutVars = served->fSystem->getNbOutVars();
+    QVector<float> defuzzed(requests.size() * nbOutVars);
+    served->fSystem->predict(&samples, defuzzed.data());
+    for (int i = 0; i < requests.size(); i++) {
+        QByteArray &reply = pending[requests[i]].reply;
+        for (int k = 0; k < nbOutVars; k++) {
+            if (k > 0)
+                reply.append(';');
+            reply.append(QByteArray::number(served->params.threshold(k, defuzzed[i*nbOutVars + k])));
+        }
+    }
+}
+
+/**
+  * Slot called when a served file is modified, replaced or removed. A file is usually
+  * written in several steps, it is loaded once it stops changing.
+  */
+void PredictionServer::onFileChanged(const QString &fileName)
+{
+    if (!changedFiles.contains(fileName))
+        changedFiles.append(fileName);
+    reloadTimer->start();
+}
+
+/**
+  * Load the changed files again and replace their models. The files replaced by a rename
+  * are no longer watched, they are watched again.
+  */
+void PredictionServer::reloadModels()
+{
+    // The queued requests were checked against the current systems
+    if (!pending.isEmpty())
+        processRequests();
+
+    QStringList missingFiles;
+    for (int i = 0; i < changedFiles.size(); i++) {
+        const QString &fileName = changedFiles[i];
+        const int model = findModel(QFileInfo(fileName).completeBaseName());
+        if (model < 0 || models[model]->fileName != fileName)
+            continue;
+        // Removed, or not renamed to its name yet
+        if (!QFile::exists(fileName)) {
+            missingFiles.append(fileName);
+            continue;
+        }
+        if (!watcher->files().contains(fileName))
+            watcher->addPath(fileName);
+
+        Model *reloaded = loadModel(fileName);
+        if (reloaded == NULL) {
+            qCritical() << "Prediction server : keeping the previous version of" << models[model]->name;
+            continue;
+        }
+        delete models[model];
+        models[model] = reloaded;
+        std::cout << "Prediction server : " << reloaded->name.toStdString() << " reloaded" << std::endl;
+    }
+
+    // Keep the old systems until their files come back
+    changedFiles = missingFiles;
+    if (!changedFiles.isEmpty())
+        reloadTimer->start();
+}
@@ -0,0 +1,121 @@
+/**
+  * @file   predictionserver.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  * @class PredictionServer
+  * @brief Serves the predictions of fuzzy systems kept loaded, on a local socket.
+  *
+  * A server is started with "--serve socket file.ffs ..." and loads each system once,
+  * under the base name of its file. The protocol is made of lines of text :
+  *
+  *   model;value1;value2;...   predicts one sample, the values are the ones of the input
+  *                             variables of the system, in the order of its file. The
+  *                             reply is the thresholded outputs separated by semicolons.
+  *   model                     replies the names of the input variables of the system.
+  *
+  * A request which cannot be answered is replied with "error;" and the reason. All the
+  * requests are answered in the event loop of the server : the requests read during one
+  * pass of the loop are grouped by system and each group is evaluated at once, then the
+  * replies are written in the order of the requests. A file which changes on disk is
+  * loaded again a short while after its last change, the new system replaces the old one
+  * between two groups and a file which cannot be loaded leaves the old one in service.
+  */
+
+#ifndef PREDICTIONSERVER_H
+#define PREDICTIONSERVER_H
+
+#include <QByteArray>
+#include <QFileSystemWatcher>
+#include <QList>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+#include <QTimer>
+
+#include "evaluationparameters.h"
+
+class FuzzySystem;
+
+class PredictionServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Time without change before a modified file is loaded again
+    static const int RELOAD_DELAY = 200;
+
+    PredictionServer(QObject *parent = 0);
+    ~PredictionServer();
+
+    bool addModel(const QString &fileName);
+    bool listen(const QString &name);
+
+private:
+    // A fuzzy system in service, replaced as a whole when its file is loaded again
+    struct Model
+    {
+        Model() : fSystem(NULL) {}
+        ~Model();
+
+        QString name;
+        QString fileName;
+        FuzzySystem *fSystem;
+        // Parameters read from the file, the ones of the system parameters are those of
+        // the last file loaded
+        EvaluationParameters params;
+        // The dataset given to the system, the names of the columns of the requests
+        QList<QStringList> header;
+        QByteArray inputNames;
+    };
+
+    struct Request
+    {
+        QPointer<QLocalSocket> socket;
+        int model;
+        QStringList row;
+        QByteArray reply;
+    };
+
+    static Model *loadModel(const QString &fileName);
+    int findModel(const QString &name) const;
+    void parseRequest(QLocalSocket *socket, const QByteArray &line);
+    void evaluateModel(int model);
+
+    QLocalServer *server;
+    QFileSystemWatcher *watcher;
+    QTimer *reloadTimer;
+    QList<Model *> models;
+    QStringList changedFiles;
+    // Requests read since the last pass, answered by processRequests()
+    QList<Request> pending;
+    bool processScheduled;
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+    void onDisconnected();
+    void processRequests();
+    void onFileChanged(const QString &fileName);
+    void reloadModels();
+};
+
+#endif // PREDICTIONSERVER_H
@@ -29,7 +29,6 @@
 #include <iostream>
 
 #include <QFile>
-#include <QMessageBox>
 #include <QSemaphore>
 #include <QtDebug>
 #include <QDir>
@@ -37,8 +36,13 @@
 
 #include "scriptmanager.h"
 #include "systemparameters.h"
+#include "entityselection.h"
+#include "migrationhub.h"
+#include "numatopology.h"
+#include "saveengine.h"
+#include "logger.h"
 
-extern QSemaphore scriptSema;
+QSemaphore scriptSema(0);
 
 static ScriptManager* s_this = 0;
 
@@ -47,7 +51,10 @@ struct ScriptManager::Imp
     duk_context* engine;
     QString fileName;
     bool scriptReady;
-    Imp():engine(0),scriptReady(false){}
+    // Runs started by the script, and index of the run of the resumed checkpoint
+    int runCount;
+    int resumeRun;
+    Imp():engine(0),scriptReady(false),runCount(0),resumeRun(-1){}
 
     void doRun()
     {
@@ -121,6 +128,163 @@ static duk_ret_t _setParams(duk_context * ctx)
     return 0;
 }
 
+static duk_ret_t _setSelection(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setSelection(
+            duk_to_int(ctx,0), //int population
+            QString::fromUtf8(duk_safe_to_string(ctx,1)), //QString method
+            duk_to_number(ctx,2) //float param
+                );
+    return 0;
+}
+
+static duk_ret_t _setCrossover(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setCrossover(
+            duk_to_int(ctx,0), //int population
+            QString::fromUtf8(duk_safe_to_string(ctx,1)) //QString method
+                );
+    return 0;
+}
+
+static duk_ret_t _setFitnessCacheSize(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setFitnessCacheSize(duk_to_int(ctx,0));
+    return 0;
+}
+
+static duk_ret_t _setEvaluationThreads(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setEvaluationThreads(duk_to_int(ctx,0));
+    return 0;
+}
+
+static duk_ret_t _setStalenessBound(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setStalenessBound(duk_to_int(ctx,0));
+    return 0;
+}
+
+static duk_ret_t _setIslands(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setIslands(
+            duk_to_int(ctx,0), //int count
+            QString::fromUtf8(duk_safe_to_string(ctx,1)) //QString topology
+                );
+    return 0;
+}
+
+static duk_ret_t _setMigration(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setMigration(
+            duk_to_int(ctx,0), //int interval
+            duk_to_int(ctx,1) //int migrants
+                );
+    return 0;
+}
+
+static duk_ret_t _setSampleShards(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setSampleShards(duk_to_int(ctx,0));
+    return 0;
+}
+
+static duk_ret_t _setNumaNodes(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setNumaNodes(QString::fromUtf8(duk_safe_to_string(ctx,0)));
+    return 0;
+}
+
+static duk_ret_t _setValidation(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setValidation(
+            QString::fromUtf8(duk_safe_to_string(ctx,0)), //QString fileName
+            duk_to_int(ctx,1) //int patience
+                );
+    return 0;
+}
+
+static duk_ret_t _setRandomSeed(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setRandomSeed(duk_to_int(ctx,0));
+    return 0;
+}
+
+static duk_ret_t _setCheckpoint(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setCheckpoint(
+            QString::fromUtf8(duk_safe_to_string(ctx,0)), //QString fileName
+            duk_to_int(ctx,1) //int interval
+                );
+    return 0;
+}
+
+static duk_ret_t _setBestExport(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setBestExport(
+            QString::fromUtf8(duk_safe_to_string(ctx,0)), //QString fileName
+            duk_to_int(ctx,1) //int interval
+                );
+    return 0;
+}
+
+static duk_ret_t _setGenerationLog(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setGenerationLog(
+            QString::fromUtf8(duk_safe_to_string(ctx,0)), //QString prefix
+            QString::fromUtf8(duk_safe_to_string(ctx,1)), //QString level
+            QString::fromUtf8(duk_safe_to_string(ctx,2)) //QString format
+                );
+    return 0;
+}
+
+static duk_ret_t _setGenealogy(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setGenealogy(
+            QString::fromUtf8(duk_safe_to_string(ctx,0)), //QString fileName
+            duk_to_int(ctx,1) //int keyframes
+                );
+    return 0;
+}
+
+static duk_ret_t _setEvaluationWorkers(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setEvaluationWorkers(QString::fromUtf8(duk_safe_to_string(ctx,0)));
+    return 0;
+}
+
 static duk_ret_t _runEvo(duk_context * ctx)
 {
     if( s_this == 0 )
@@ -146,6 +310,54 @@ ScriptManager::ScriptManager()
     duk_push_c_function ( d_imp->engine , _setParams , 42 );
     duk_put_prop_string ( d_imp->engine , - 2 , "setParams" );
 
+    duk_push_c_function ( d_imp->engine , _setSelection , 3 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setSelection" );
+
+    duk_push_c_function ( d_imp->engine , _setCrossover , 2 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setCrossover" );
+
+    duk_push_c_function ( d_imp->engine , _setFitnessCacheSize , 1 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setFitnessCacheSize" );
+
+    duk_push_c_function ( d_imp->engine , _setEvaluationThreads , 1 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setEvaluationThreads" );
+
+    duk_push_c_function ( d_imp->engine , _setStalenessBound , 1 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setStalenessBound" );
+
+    duk_push_c_function ( d_imp->engine , _setIslands , 2 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setIslands" );
+
+    duk_push_c_function ( d_imp->engine , _setMigration , 2 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setMigration" );
+
+    duk_push_c_function ( d_imp->engine , _setSampleShards , 1 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setSampleShards" );
+
+    duk_push_c_function ( d_imp->engine , _setNumaNodes , 1 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setNumaNodes" );
+
+    duk_push_c_function ( d_imp->engine , _setValidation , 2 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setValidation" );
+
+    duk_push_c_function ( d_imp->engine , _setRandomSeed , 1 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setRandomSeed" );
+
+    duk_push_c_function ( d_imp->engine , _setCheckpoint , 2 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setCheckpoint" );
+
+    duk_push_c_function ( d_imp->engine , _setBestExport , 2 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setBestExport" );
+
+    duk_push_c_function ( d_imp->engine , _setGenerationLog , 3 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setGenerationLog" );
+
+    duk_push_c_function ( d_imp->engine , _setGenealogy , 2 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setGenealogy" );
+
+    duk_push_c_function ( d_imp->engine , _setEvaluationWorkers , 1 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setEvaluationWorkers" );
+
     duk_push_c_function ( d_imp->engine , _runEvo , 0 );
     duk_put_prop_string ( d_imp->engine , - 2 , "runEvo" );
 
@@ -171,6 +383,7 @@ void ScriptManager::run()
 {
     if( !d_imp->scriptReady )
         return;
+    d_imp->runCount = 0;
     d_imp->doRun();
     emit scriptFinished();
 }
@@ -291,6 +504,266 @@ void ScriptManager::setParams(QString experimentName,
     sysParams.setThreshActivated(threshActivated);
 }
 
+/**
+  * Select the method used to choose the parents of a population. This function
+  * can be called in the script file after setParams().
+  *
+  * @param population 1 for the membership functions, 2 for the rules.
+  * @param method One of "rank", "tournament", "sus", "roulette" or "truncation".
+  * @param param Tournament size for "tournament", kept ratio of the population for "truncation".
+  */
+void ScriptManager::setSelection(int population, QString method, float param)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+
+    if (!EntitySelection::isKnownName(method)) {
+        qCritical() << "Script error : unknown selection method" << method;
+        return;
+    }
+    if (population == 1)
+        sysParams.setSelectionPop1(method, param);
+    else if (population == 2)
+        sysParams.setSelectionPop2(method, param);
+    else
+        qCritical() << "Script error : setSelection population must be 1 or 2";
+}
+
+/**
+  * Select the crossover method of a population. This function can be called in
+  * the script file after setParams().
+  *
+  * @param population 1 for the membership functions, 2 for the rules.
+  * @param method One of "onepoint", "uniform" or "arithmetic". The arithmetic crossover
+  * blends the membership positions and is only available for the population 1.
+  */
+void ScriptManager::setCrossover(int population, QString method)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+
+    if (method != "onepoint" && method != "uniform" && method != "arithmetic") {
+        qCritical() << "Script error : unknown crossover method" << method;
+        return;
+    }
+    if (population == 1)
+        sysParams.setCrossoverPop1(method);
+    else if (population == 2 && method != "arithmetic")
+        sysParams.setCrossoverPop2(method);
+    else
+        qCritical() << "Script error : invalid population for setCrossover" << population << method;
+}
+
+/**
+  * Set the maximum number of evaluated pairs remembered by the fitness cache.
+  * 0 disables the cache.
+  *
+  * @param size Number of pairs.
+  */
+void ScriptManager::setFitnessCacheSize(int size)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    sysParams.setFitnessCacheSize(qMax(0, size));
+}
+
+/**
+  * Set the number of threads evaluating the fuzzy systems during a run.
+  * 0 uses one thread per core, 1 evaluates in the two evolution threads.
+  *
+  * @param count Number of threads.
+  */
+void ScriptManager::setEvaluationThreads(int count)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    sysParams.setEvaluationThreads(qMax(0, count));
+}
+
+/**
+  * Split the samples of the dataset in several ranges evaluated in parallel, for
+  * each evaluated fuzzy system. Meant for the datasets too large for the pairs to be
+  * evaluated in parallel only.
+  *
+  * @param count Number of ranges, 1 evaluates all the samples in one thread.
+  */
+void ScriptManager::setSampleShards(int count)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    sysParams.setSampleShards(qMax(1, count));
+}
+
+/**
+  * Bind the evaluation threads to NUMA nodes, each node evaluating with its own copy
+  * of the dataset.
+  *
+  * @param spec Empty to not bind them, "auto" for the nodes of the machine, or the CPU
+  * lists of the nodes separated by ';' to simulate a topology, such as "0-3;4-7".
+  */
+void ScriptManager::setNumaNodes(QString spec)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    NumaTopology topology;
+
+    if (!NumaTopology::fromSpec(spec, &topology)) {
+        qCritical() << "Script error : invalid NUMA nodes" << spec;
+        return;
+    }
+    sysParams.setNumaNodes(spec);
+}
+
+/**
+  * Score the best systems on a held-out dataset during the next runs.
+  *
+  * @param fileName Validation dataset, with the same columns as the training one. Empty
+  * to not validate.
+  * @param patience Generations without improvement of the validation fitness after which
+  * the run stops, 0 to never stop.
+  */
+void ScriptManager::setValidation(QString fileName, int patience)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    sysParams.setValidation(fileName, qMax(0, patience));
+}
+
+/**
+  * Seed the random streams of the next runs. A seeded run with a single island whose
+  * populations evolve in lock step is repeatable.
+  *
+  * @param seed Seed, negative to seed from the clock.
+  */
+void ScriptManager::setRandomSeed(int seed)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    sysParams.setRandomSeed(seed);
+}
+
+/**
+  * Checkpoint the next runs, so that they can be resumed with --resume.
+  *
+  * @param fileName Checkpoint file, replaced by each new checkpoint. Empty to not
+  * checkpoint.
+  * @param interval Generations between two checkpoints.
+  */
+void ScriptManager::setCheckpoint(QString fileName, int interval)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    if (!fileName.isEmpty() && interval <= 0) {
+        qCritical() << "Script error : invalid checkpoint interval" << interval;
+        return;
+    }
+    sysParams.setCheckpoint(fileName, interval);
+}
+
+/**
+  * Export the best system of the next runs each time it improves, while they go on.
+  *
+  * @param fileName .ffs file the best system is exported to, its metrics and generation
+  * are written next to it. Empty to not export.
+  * @param interval Minimum time between two exports, in seconds.
+  */
+void ScriptManager::setBestExport(QString fileName, int interval)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    sysParams.setBestExport(fileName, qMax(0, interval));
+}
+
+/**
+  * Log every generation of the populations of the next runs, in a background thread.
+  *
+  * @param prefix Prefix of the log files, followed by the name of each population.
+  * @param level none, stats, genes or all.
+  * @param format csv or binary.
+  */
+void ScriptManager::setGenerationLog(QString prefix, QString level, QString format)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    Logger::LoggerLevel loggerLevel;
+    if (!Logger::levelFromName(level, &loggerLevel)) {
+        qCritical() << "Script error : unknown log level" << level;
+        return;
+    }
+    if (format != "csv" && format != "binary") {
+        qCritical() << "Script error : unknown log format" << format;
+        return;
+    }
+    sysParams.setGenerationLog(prefix, level, format);
+}
+
+/**
+  * Archive every generation of the populations of the next runs, as deltas to their
+  * parents, in a background thread.
+  *
+  * @param fileName Archive file, replaced by each run. Empty to not archive.
+  * @param keyframes Generations between two generations archived as they are.
+  */
+void ScriptManager::setGenealogy(QString fileName, int keyframes)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    if (keyframes <= 0) {
+        qCritical() << "Script error : the genealogy keyframe interval must be positive";
+        return;
+    }
+    sysParams.setGenealogy(fileName, keyframes);
+}
+
+/**
+  * Set how many generations a population may run ahead of the other one.
+  * 0 evolves both populations in lock step, a negative value removes the bound.
+  *
+  * @param generations Staleness bound.
+  */
+void ScriptManager::setStalenessBound(int generations)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    sysParams.setStalenessBound(generations);
+}
+
+/**
+  * Run several islands, each evolving its own pair of populations.
+  *
+  * @param count Number of islands, 1 disables the island model.
+  * @param topology Migration topology : "ring", "random" or "full".
+  */
+void ScriptManager::setIslands(int count, QString topology)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    MigrationHub::Topology parsed;
+
+    if (!MigrationHub::topologyFromName(topology, &parsed)) {
+        qCritical() << "Script error : unknown migration topology" << topology;
+        return;
+    }
+    sysParams.setIslands(qMax(1, count), topology);
+}
+
+/**
+  * Set how often and how many individuals migrate between the islands.
+  *
+  * @param interval Generations between two migrations, 0 disables the migration.
+  * @param migrants Number of elites sent by each population.
+  */
+void ScriptManager::setMigration(int interval, int migrants)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    sysParams.setMigration(qMax(0, interval), qMax(0, migrants));
+}
+
+/**
+  * Evaluate the fuzzy systems on worker processes started with --worker.
+  *
+  * @param addresses Comma separated local socket names or host:port, empty to
+  * evaluate in this process.
+  */
+void ScriptManager::setEvaluationWorkers(QString addresses)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    QStringList list = addresses.split(',');
+    QStringList workers;
+
+    for (int i = 0; i < list.size(); i++) {
+        if (!list.at(i).trimmed().isEmpty())
+            workers.append(list.at(i).trimmed());
+    }
+    sysParams.setEvaluationWorkers(workers);
+}
+
 /**
   * Read the contents of the script file.
   */
@@ -299,7 +772,7 @@ void ScriptManager::readScript()
     QFile file(d_imp->fileName);
     if (! file.open(QIODevice::ReadOnly | QIODevice::Text))
     {
-        QMessageBox::critical(0, "Error", "Could not open script file!");
+        emit scriptError("Error", "Could not open script file!");
         qCritical() << "Script error : cannot find script file !";
         return;
     }
@@ -310,7 +783,9 @@ void ScriptManager::readScript()
     if( duk_peval_string( d_imp->engine, strProgram.constData() ) != DUK_EXEC_SUCCESS )
     {
         d_imp->scriptReady = false;
-        QMessageBox::critical(0, "Script error", duk_safe_to_string ( d_imp->engine , - 1 ) );
+        const QString message = duk_safe_to_string ( d_imp->engine , - 1 );
+        emit scriptError("Script error", message);
+        qCritical() << "Script error :" << message;
         duk_pop( d_imp->engine );
         return;
     }
@@ -327,7 +802,8 @@ void ScriptManager::runScript()
 {
     if( !d_imp->scriptReady )
     {
-        QMessageBox::critical(0, "Error calling doRun", "The script has errors and cannot be run");
+        emit scriptError("Error calling doRun", "The script has errors and cannot be run");
+        qCritical() << "Script error : the script has errors and cannot be run";
         return;
     }
     d_imp->doRun();
@@ -343,6 +819,23 @@ bool ScriptManager::isScriptReady() const
   */
 void ScriptManager::runEvo()
 {
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    const int run = d_imp->runCount++;
+
+    // The runs done before the one the resumed checkpoint belongs to are not done again
+    if (!sysParams.getResumeFile().isEmpty()) {
+        if (d_imp->resumeRun < 0) {
+            SaveEngine::Checkpoint *checkpoint = SaveEngine::load(sysParams.getResumeFile());
+            d_imp->resumeRun = checkpoint != NULL ? checkpoint->run : 0;
+            delete checkpoint;
+        }
+        if (run < d_imp->resumeRun) {
+            qDebug() << "Run " << run << " done before the checkpoint, skipped";
+            return;
+        }
+    }
+    sysParams.setRunIndex(run);
+
     d_imp->doSetParams();
 
     emit startRun();
@@ -29,8 +29,12 @@
 #ifndef SCRIPTMANAGER_H
 #define SCRIPTMANAGER_H
 
+#include <QSemaphore>
 #include <QThread>
 
+// Released by the runner of the script each time a run it started is finished
+extern QSemaphore scriptSema;
+
 class ScriptManager : public QThread
 {
     Q_OBJECT
@@ -50,9 +54,26 @@ protected:
 signals:
     void startRun();
     void scriptFinished();
+    void scriptError(QString title, QString message);
 
 public slots:
     void runEvo();
+    void setSelection(int population, QString method, float param);
+    void setCrossover(int population, QString method);
+    void setFitnessCacheSize(int size);
+    void setEvaluationThreads(int count);
+    void setSampleShards(int count);
+    void setNumaNodes(QString spec);
+    void setValidation(QString fileName, int patience);
+    void setRandomSeed(int seed);
+    void setCheckpoint(QString fileName, int interval);
+    void setBestExport(QString fileName, int interval);
+    void setGenerationLog(QString prefix, QString level, QString format);
+    void setGenealogy(QString fileName, int keyframes);
+    void setStalenessBound(int generations);
+    void setIslands(int count, QString topology);
+    void setMigration(int interval, int migrants);
+    void setEvaluationWorkers(QString addresses);
     void setParams(QString experimentName,
                 QString savePath,
                 bool fixedVars,
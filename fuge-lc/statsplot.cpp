@@ -27,6 +27,10 @@
   */
 #include "statsplot.h"
 
+// Milliseconds between two updates of the plot
+static const int FRAME_INTERVAL = 50;
+// Samples taken from the statistics at once
+static const int SAMPLES_PER_TAKE = 64;
 
 StatsPlot::StatsPlot(QWidget *parent) :
     QDialog(parent),
@@ -50,30 +54,40 @@ StatsPlot::StatsPlot(QWidget *parent) :
     legend = new QwtLegend();
     myPlot->setAxisTitle(QwtPlot::xBottom, "Generations");
     myPlot->setAxisTitle(QwtPlot::yLeft, "Fitness");
-    xVals = new QVector<double>();
-    yValsPop1 = new QVector<double>();
-    yValsPop2 = new QVector<double>();
-    yValsAvgPop1 = new QVector<double>();
-    yValsAvgPop2 = new QVector<double>();
     fitMaxPop1Curve = new QwtPlotCurve("Pop1 : Membership functions (max)");
     fitMaxPop2Curve = new QwtPlotCurve("Pop2 : Rules (max)");
     fitAvgPop1Curve = new QwtPlotCurve("Pop1 : Membership functions (avg)");
     fitAvgPop2Curve = new QwtPlotCurve("Pop2 : Rules (avg)");
+    fitValidationCurve = new QwtPlotCurve("Best system (validation)");
     fitMaxPop1Curve->attach(myPlot);
     fitMaxPop2Curve->attach(myPlot);
     fitAvgPop1Curve->attach(myPlot);
     fitAvgPop2Curve->attach(myPlot);
+    fitValidationCurve->attach(myPlot);
+    // The curves draw the histories as they grow, their data is set once
+    fitMaxPop1Curve->setData(StatsSeries(&maxPop1));
+    fitMaxPop2Curve->setData(StatsSeries(&maxPop2));
+    fitAvgPop1Curve->setData(StatsSeries(&avgPop1));
+    fitAvgPop2Curve->setData(StatsSeries(&avgPop2));
+    fitValidationCurve->setData(StatsSeries(&validation));
+    fitMaxPop1Curve->setPen(QPen (Qt::red,2));
+    fitMaxPop2Curve->setPen(QPen (Qt::blue,2));
+    fitAvgPop1Curve->setPen(QPen (Qt::red,1,Qt::DashLine));
+    fitAvgPop2Curve->setPen(QPen (Qt::blue,1,Qt::DashLine));
+    fitValidationCurve->setPen(QPen (Qt::darkGreen,2));
     myPlot->insertLegend(legend, QwtPlot::TopLegend);
 
     m_ui->horizontalLayout->addWidget(myPlot);
+
+    frameTimer = new QTimer(this);
+    connect(frameTimer, SIGNAL(timeout()), this, SLOT(onFrame()));
+    frameTimer->start(FRAME_INTERVAL);
 }
 
 StatsPlot::~StatsPlot()
 {
+    frameTimer->stop();
     delete m_ui;
-    delete xVals;
-    delete yValsPop1;
-    delete yValsPop2;
 }
 
 void StatsPlot::changeEvent(QEvent *e)
@@ -99,17 +113,50 @@ void StatsPlot::setLogFileName(QString fileName)
 }
 
 /**
-  * Slot called by CoevEvalOp when new statistics (each generation) are available. The plot
-  * and the temporary log file are updated.
+  * Slot called by the frame timer. The statistics of the generations published since the
+  * last frame are appended to the curves, then the labels are updated from the last
+  * generation of each population and the plot is redrawn once.
   */
-void StatsPlot::receiveData(QString name)
+void StatsPlot::onFrame()
 {
     CoevStats& stats = CoevStats::getInstance();
     SystemParameters& sysParams = SystemParameters::getInstance();
-    if(!xVals->contains(stats.getGenNumber()))
-        xVals->append(stats.getGenNumber());
+    CoevStats::Sample samples[SAMPLES_PER_TAKE];
+    CoevStats::Sample lastPop1;
+    CoevStats::Sample lastPop2;
+    bool hasPop1 = false;
+    bool hasPop2 = false;
+    const bool hasValidation = !sysParams.getValidationDataset().isEmpty();
+    int count;
+    while ((count = stats.takeSamples(samples, SAMPLES_PER_TAKE)) > 0) {
+        for (int i = 0; i < count; i++) {
+            const CoevStats::Sample &sample = samples[i];
+            if (sample.species == 1) {
+                bestFitPop2 = qMax(bestFitPop2, sample.fitMax);
+                bestDevPop2 = qMax(bestDevPop2, sample.fitStd);
+                maxPop2.append(sample.generation, sample.fitMax);
+                avgPop2.append(sample.generation, sample.fitAvg);
+                lastPop2 = sample;
+                hasPop2 = true;
+            }
+            else {
+                bestFitPop1 = qMax(bestFitPop1, sample.fitMax);
+                bestDevPop1 = qMax(bestDevPop1, sample.fitStd);
+                maxPop1.append(sample.generation, sample.fitMax);
+                avgPop1.append(sample.generation, sample.fitAvg);
+                // Zero until the best system has been scored on the validation dataset
+                if (hasValidation)
+                    validation.append(sample.generation, qMax(0.0f, sample.validationFitness));
+                lastPop1 = sample;
+                hasPop1 = true;
+            }
+        }
+    }
+    if (!hasPop1 && !hasPop2)
+        return;
+
     // These things need to be done only once
-    if (xVals->last() < 2) {
+    if ((hasPop1 && lastPop1.generation < 2) || (hasPop2 && lastPop2.generation < 2)) {
         m_ui->label_pops->setText("<font color = red>"+ QString::number(stats.getSizePop1()) +"<font>"+"\\"+"<font color = blue>"+ QString::number(stats.getSizePop2()) +"<font>");
         m_ui->label_exp->setText(sysParams.getExperimentName());
         m_ui->label_rules->setText(QString::number(sysParams.getNbRules()));
@@ -154,50 +201,19 @@ void StatsPlot::receiveData(QString name)
 
     bestSystemDesc = *stats.getBestSysDesc();
 
-    if(name == "RULES"){
-        if (stats.getFitMaxPop2() >= bestFitPop2) {
-            bestFitPop2 = stats.getFitMaxPop2();
-        }
-        if (stats.getFitStdPop2() >= bestDevPop2) {
-            bestDevPop2 = stats.getFitStdPop2();
-        }
-
-        yValsPop2->append(stats.getFitMaxPop2());
-        yValsAvgPop2->append(stats.getFitAvgPop2());
-        m_ui->label_max2->setText(QString::number(yValsPop2->last()));
-        m_ui->label_avg2->setText(QString::number(yValsAvgPop2->last()));
-        m_ui->label_min2->setText(QString::number(stats.getFitMinPop2()));
-        m_ui->label_std2->setText(QString::number(stats.getFitStdPop2()));
-        m_ui->label_gen2->setText(QString::number(xVals->last()) + " / " + QString::number(sysParams.getMaxGenPop2()));
+    if (hasPop2) {
+        m_ui->label_max2->setText(QString::number(lastPop2.fitMax));
+        m_ui->label_avg2->setText(QString::number(lastPop2.fitAvg));
+        m_ui->label_min2->setText(QString::number(lastPop2.fitMin));
+        m_ui->label_std2->setText(QString::number(lastPop2.fitStd));
+        m_ui->label_gen2->setText(QString::number(lastPop2.generation) + " / " + QString::number(sysParams.getMaxGenPop2()));
     }
-    else{
-        if (stats.getFitMaxPop1() >= bestFitPop1) {
-            bestFitPop1 = stats.getFitMaxPop1();
-        }
-        if (stats.getFitStdPop1() >= bestDevPop1) {
-            bestDevPop1 = stats.getFitStdPop1();
-        }
-
-        yValsPop1->append(stats.getFitMaxPop1());
-        yValsAvgPop1->append(stats.getFitAvgPop1());
-        m_ui->label_max1->setText(QString::number(yValsPop1->last()));
-        m_ui->label_min1->setText(QString::number(stats.getFitMinPop1()));
-        m_ui->label_avg1->setText(QString::number(yValsAvgPop1->last()));
-        m_ui->label_gen->setText(QString::number(xVals->last()) + " / " + QString::number(sysParams.getMaxGenPop1()));
-        m_ui->label_std1->setText(QString::number(stats.getFitStdPop1()));
-    }
-
-
-    if(name == "RULES"){
-        fitMaxPop2Curve->setData(*xVals, *yValsPop2);
-        fitMaxPop2Curve->setPen(QPen (Qt::blue,2));
-        fitAvgPop2Curve->setData(*xVals, *yValsAvgPop2);
-        fitAvgPop2Curve->setPen(QPen (Qt::blue,1,Qt::DashLine));
-    } else {
-        fitMaxPop1Curve->setData(*xVals, *yValsPop1);
-        fitMaxPop1Curve->setPen(QPen (Qt::red,2));
-        fitAvgPop1Curve->setData(*xVals, *yValsAvgPop1);
-        fitAvgPop1Curve->setPen(QPen (Qt::red,1,Qt::DashLine));
+    if (hasPop1) {
+        m_ui->label_max1->setText(QString::number(lastPop1.fitMax));
+        m_ui->label_min1->setText(QString::number(lastPop1.fitMin));
+        m_ui->label_avg1->setText(QString::number(lastPop1.fitAvg));
+        m_ui->label_gen->setText(QString::number(lastPop1.generation) + " / " + QString::number(sysParams.getMaxGenPop1()));
+        m_ui->label_std1->setText(QString::number(lastPop1.fitStd));
     }
 
     m_ui->lblSensi->setText(QString::number(stats.getSensi()));
@@ -217,7 +233,7 @@ void StatsPlot::receiveData(QString name)
 
     //    QTextStream out(fitLogFile);
 
-    //    out << "Gen" << xVals->last() << "; " << yValsPop1->last() << "; " << yValsPop2->last() << "; " << yValsAvgPop1->last() << "; " << yValsAvgPop2->last()
+    //    out << "Gen" << lastPop1.generation << "; " << yValsPop1->last() << "; " << yValsPop2->last() << "; " << yValsAvgPop1->last() << "; " << yValsAvgPop2->last()
     //         << "; " << stats.getSensi() << "; " << stats.getSpeci() << "; " << stats.getAccu() << "; " << stats.getPpv() << ";" << stats.getRmse() << "\n";
 
     //    out.flush();
@@ -230,11 +246,15 @@ void StatsPlot::receiveData(QString name)
   */
 void StatsPlot::onClearStats()
 {
-    xVals->clear();
-    yValsPop1->clear();
-    yValsPop2->clear();
-    yValsAvgPop1->clear();
-    yValsAvgPop2->clear();
+    // Drop the last samples of the previous run
+    CoevStats::Sample samples[SAMPLES_PER_TAKE];
+    while (CoevStats::getInstance().takeSamples(samples, SAMPLES_PER_TAKE) > 0)
+        ;
+    maxPop1.clear();
+    maxPop2.clear();
+    avgPop1.clear();
+    avgPop2.clear();
+    validation.clear();
     if (isShowed)
         myPlot->replot();
 }
@@ -340,6 +360,7 @@ void StatsPlot::onShowGraph()
 {
     this->show();
     isShowed = true;
+    myPlot->replot();
 }
 
 /**
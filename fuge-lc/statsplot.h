@@ -35,6 +35,7 @@
 #include <QDir>
 #include <QCloseEvent>
 #include <QTime>
+#include <QTimer>
 
 #include <qwt_plot.h>
 #include <qwt_plot_curve.h>
@@ -46,6 +47,7 @@
 #include "ui_statsplot.h"
 #include "systemparameters.h"
 #include "coevstats.h"
+#include "statsseries.h"
 
 namespace Ui {
     class StatsPlot;
@@ -61,7 +63,7 @@ public:
     void setLogFileName(QString fileName);
 
 public slots:
-    void receiveData(QString name);
+    void onFrame();
     void onClearStats();
     void onCloseStats();
     void onShowGraph();
@@ -72,15 +74,17 @@ protected:
 private:
     Ui::StatsPlot *m_ui;
     QwtPlot *myPlot;
-    QVector<double>* xVals;
-    QVector<double>* yValsPop1;
-    QVector<double>* yValsPop2;
-    QVector<double>* yValsAvgPop1;
-    QVector<double>* yValsAvgPop2;
+    QTimer* frameTimer;
+    StatsHistory maxPop1;
+    StatsHistory maxPop2;
+    StatsHistory avgPop1;
+    StatsHistory avgPop2;
+    StatsHistory validation;
     QwtPlotCurve* fitMaxPop1Curve;
     QwtPlotCurve* fitMaxPop2Curve;
     QwtPlotCurve* fitAvgPop1Curve;
     QwtPlotCurve* fitAvgPop2Curve;
+    QwtPlotCurve* fitValidationCurve;
     QwtLegend* legend;
     QFile* fitLogFile;
     QString logFileName;
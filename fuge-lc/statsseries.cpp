@@ -0,0 +1,140 @@
+/**
+  * @file   statsseries.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  *
+  * @class StatsSeries
+  * @brief Curve data of the statistics plot, appended to point by point.
+  */
+
+#include "statsseries.h"
+
+StatsHistory::StatsHistory()
+{
+    xs.reserve(MAX_POINTS);
+    ys.reserve(MAX_POINTS);
+    clear();
+}
+
+/**
+  * Append a point, in constant amortized time.
+  */
+void StatsHistory::append(double x, double y)
+{
+    if (isEmpty()) {
+        minX = maxX = x;
+        minY = maxY = y;
+    }
+    else {
+        minX = qMin(minX, x);
+        maxX = qMax(maxX, x);
+        minY = qMin(minY, y);
+        maxY = qMax(maxY, y);
+    }
+
+    if (++skipped < stride) {
+        hasLast = true;
+        lastX = x;
+        lastY = y;
+        return;
+    }
+    xs.append(x);
+    ys.append(y);
+    skipped = 0;
+    hasLast = false;
+    if (xs.size() >= MAX_POINTS)
+        compact();
+}
+
+void StatsHistory::clear()
+{
+    xs.clear();
+    ys.clear();
+    stride = 1;
+    skipped = 0;
+    hasLast = false;
+    lastX = lastY = 0.0;
+    minX = maxX = minY = maxY = 0.0;
+}
+
+QwtDoubleRect StatsHistory::boundingRect() const
+{
+    if (isEmpty())
+        return QwtDoubleRect(1.0, 1.0, -2.0, -2.0);
+    return QwtDoubleRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+/**
+  * Keep every other point and double the stride. The newest point dropped stays drawn as
+  * the last one until a point is kept after it.
+  */
+void StatsHistory::compact()
+{
+    const int last = xs.size() - 1;
+    int kept = 0;
+    for (int i = 0; i <= last; i += 2, kept++) {
+        xs[kept] = xs[i];
+        ys[kept] = ys[i];
+    }
+    if (last % 2 != 0) {
+        hasLast = true;
+        lastX = xs[last];
+        lastY = ys[last];
+        skipped = stride;
+    }
+    xs.resize(kept);
+    ys.resize(kept);
+    stride *= 2;
+}
+
+/**
+  * Constructor.
+  *
+  * @param history Points of the series, they must outlive it
+  */
+StatsSeries::StatsSeries(const StatsHistory *history) : QwtData(), history(history)
+{
+}
+
+QwtData *StatsSeries::copy() const
+{
+    return new StatsSeries(history);
+}
+
+size_t StatsSeries::size() const
+{
+    return history->size();
+}
+
+double StatsSeries::x(size_t i) const
+{
+    return history->x(i);
+}
+
+double StatsSeries::y(size_t i) const
+{
+    return history->y(i);
+}
+
+QwtDoubleRect StatsSeries::boundingRect() const
+{
+    return history->boundingRect();
+}
@@ -0,0 +1,92 @@
+/**
+  * @file   statsseries.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  *
+  * @class StatsSeries
+  * @brief Curve data of the statistics plot, appended to point by point.
+  *
+  * The points belong to a StatsHistory, the series given to a curve only refers to it :
+  * copying the series, as QwtPlotCurve::setData() does, copies no point, and the points
+  * appended afterwards are drawn at the next replot. The bounding rectangle is updated
+  * as the points are appended instead of being computed at each replot. A history keeps
+  * at most MAX_POINTS points : once full, every other point is dropped and only one
+  * generation out of two is kept from then on, so that appending a point and drawing
+  * the curve cost the same whatever the length of the run. The last point appended is
+  * always drawn.
+  */
+
+#ifndef STATSSERIES_H
+#define STATSSERIES_H
+
+#include <QVector>
+
+#include <qwt_data.h>
+
+class StatsHistory
+{
+public:
+    static const int MAX_POINTS = 2048;
+
+    StatsHistory();
+
+    void append(double x, double y);
+    void clear();
+
+    inline int size() const {return xs.size() + (hasLast ? 1 : 0);}
+    inline double x(int i) const {return i < xs.size() ? xs[i] : lastX;}
+    inline double y(int i) const {return i < ys.size() ? ys[i] : lastY;}
+    inline bool isEmpty() const {return size() == 0;}
+    inline double getLastY() const {return y(size() - 1);}
+    QwtDoubleRect boundingRect() const;
+
+private:
+    void compact();
+
+    // Kept points, one every stride appended points
+    QVector<double> xs;
+    QVector<double> ys;
+    int stride;
+    int skipped;
+    // Last point appended, when it is not kept
+    bool hasLast;
+    double lastX;
+    double lastY;
+    // Bounds of all the points appended
+    double minX, maxX, minY, maxY;
+};
+
+class StatsSeries : public QwtData
+{
+public:
+    StatsSeries(const StatsHistory *history);
+
+    virtual QwtData *copy() const;
+    virtual size_t size() const;
+    virtual double x(size_t i) const;
+    virtual double y(size_t i) const;
+    virtual QwtDoubleRect boundingRect() const;
+
+private:
+    const StatsHistory *history;
+};
+
+#endif // STATSSERIES_H
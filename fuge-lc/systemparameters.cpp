@@ -82,6 +82,28 @@ SystemParameters::SystemParameters()
     mutFlipIndPop2 = -1.0;
     mutFlipBitPop2 = -1.0;
     nbCooperators = 2.0;
+    selectionPop1 = "rank";
+    selectionParamPop1 = 0.0;
+    selectionPop2 = "rank";
+    selectionParamPop2 = 0.0;
+    crossoverPop1 = "onepoint";
+    crossoverPop2 = "onepoint";
+    fitnessCacheSize = 65536;
+    evaluationThreads = 0;
+    stalenessBound = -1;
+    islandCount = 1;
+    migrationTopology = "ring";
+    migrationInterval = 10;
+    migrationSize = 2;
+    sampleShards = 1;
+    validationPatience = 0;
+    randomSeed = -1;
+    checkpointInterval = 0;
+    runIndex = 0;
+    bestExportInterval = 0;
+    logLevel = "none";
+    logFormat = "csv";
+    genealogyKeyframes = 50;
 }
 
 SystemParameters::~SystemParameters()
@@ -116,6 +116,62 @@ private:
     float mutFlipIndPop2;
     float mutFlipBitPop2;
 
+    // Parents selection method of each population and its parameter
+    QString selectionPop1;
+    float selectionParamPop1;
+    QString selectionPop2;
+    float selectionParamPop2;
+
+    // Crossover method of each population
+    QString crossoverPop1;
+    QString crossoverPop2;
+
+    // Maximum number of pairs in the fitness cache, 0 to disable it
+    int fitnessCacheSize;
+    // Number of threads evaluating the pairs, 0 for one per core
+    int evaluationThreads;
+    // Generations a species may run ahead of the other, 0 for lock step, negative for no bound
+    int stalenessBound;
+    // Island model : number of islands, migration topology, generations between two
+    // migrations and number of migrants sent by each population
+    int islandCount;
+    QString migrationTopology;
+    int migrationInterval;
+    int migrationSize;
+    // Addresses of the evaluation worker processes, empty to evaluate in this process
+    QStringList evaluationWorkers;
+    // Number of ranges the samples of the dataset are split in for each evaluation, 1 to not split them
+    int sampleShards;
+    // NUMA nodes the evaluation workers are bound to : empty for none, "auto" or CPU lists separated by ';'
+    QString numaNodes;
+    // Held-out dataset the best systems are scored on during the run, empty for none, and the
+    // generations without improvement on it after which the run stops, 0 for never
+    QString validationDataset;
+    int validationPatience;
+    // Seed of the random streams, negative for a seed taken from the clock
+    int randomSeed;
+    // File the run is checkpointed to every checkpointInterval generations, empty for none
+    QString checkpointFile;
+    int checkpointInterval;
+    // Checkpoint given on the command line, the run of the script which wrote it resumes
+    // from it and the runs before it are skipped
+    QString resumeFile;
+    // Index of the current run among the runs of the script
+    int runIndex;
+    // File the best system is exported to while the run goes on, at most every
+    // bestExportInterval seconds, empty for none
+    QString bestExportFile;
+    int bestExportInterval;
+    // Prefix of the generation log files, empty for none, the level and the format of the
+    // logs, see Logger::levelFromName()
+    QString logPrefix;
+    QString logLevel;
+    QString logFormat;
+    // Genealogy archive of the populations, empty for none, and the generations between
+    // two of its keyframes
+    QString genealogyFile;
+    int genealogyKeyframes;
+
 signals:
     void startRun();
     void scriptEnd();
@@ -182,6 +238,26 @@ public:
     inline void setMutFlipIndPop2(float value) {mutFlipIndPop2 = value;}
     inline void setMutFlipBitPop2(float value) {mutFlipBitPop2 = value;}
     inline void setNbCooperators(int value) {nbCooperators = value;}
+    inline void setSelectionPop1(QString method, float param) {selectionPop1 = method; selectionParamPop1 = param;}
+    inline void setSelectionPop2(QString method, float param) {selectionPop2 = method; selectionParamPop2 = param;}
+    inline void setCrossoverPop1(QString method) {crossoverPop1 = method;}
+    inline void setCrossoverPop2(QString method) {crossoverPop2 = method;}
+    inline void setFitnessCacheSize(int value) {fitnessCacheSize = value;}
+    inline void setEvaluationThreads(int value) {evaluationThreads = value;}
+    inline void setStalenessBound(int value) {stalenessBound = value;}
+    inline void setIslands(int count, QString topology) {islandCount = count; migrationTopology = topology;}
+    inline void setMigration(int interval, int size) {migrationInterval = interval; migrationSize = size;}
+    inline void setEvaluationWorkers(QStringList addresses) {evaluationWorkers = addresses;}
+    inline void setSampleShards(int value) {sampleShards = value;}
+    inline void setNumaNodes(QString spec) {numaNodes = spec;}
+    inline void setValidation(QString fileName, int patience) {validationDataset = fileName; validationPatience = patience;}
+    inline void setRandomSeed(int seed) {randomSeed = seed;}
+    inline void setCheckpoint(QString fileName, int interval) {checkpointFile = fileName; checkpointInterval = interval;}
+    inline void setResumeFile(QString fileName) {resumeFile = fileName;}
+    inline void setRunIndex(int index) {runIndex = index;}
+    inline void setBestExport(QString fileName, int interval) {bestExportFile = fileName; bestExportInterval = interval;}
+    inline void setGenerationLog(QString prefix, QString level, QString format) {logPrefix = prefix; logLevel = level; logFormat = format;}
+    inline void setGenealogy(QString fileName, int keyframes) {genealogyFile = fileName; genealogyKeyframes = keyframes;}
 
     inline QString getExperimentName() {return experimentName;}
     inline QString getDatasetName() {return datasetName;}
@@ -239,6 +315,36 @@ public:
     inline float getMutFlipIndPop2() {return mutFlipIndPop2;}
     inline float getMutFlipBitPop2() {return mutFlipBitPop2;}
     inline int getNbCooperators() {return nbCooperators;}
+    inline QString getSelectionPop1() {return selectionPop1;}
+    inline float getSelectionParamPop1() {return selectionParamPop1;}
+    inline QString getSelectionPop2() {return selectionPop2;}
+    inline float getSelectionParamPop2() {return selectionParamPop2;}
+    inline QString getCrossoverPop1() {return crossoverPop1;}
+    inline QString getCrossoverPop2() {return crossoverPop2;}
+    inline int getFitnessCacheSize() {return fitnessCacheSize;}
+    inline int getEvaluationThreads() {return evaluationThreads;}
+    inline int getStalenessBound() {return stalenessBound;}
+    inline int getIslandCount() {return islandCount;}
+    inline QString getMigrationTopology() {return migrationTopology;}
+    inline int getMigrationInterval() {return migrationInterval;}
+    inline int getMigrationSize() {return migrationSize;}
+    inline QStringList getEvaluationWorkers() {return evaluationWorkers;}
+    inline int getSampleShards() {return sampleShards;}
+    inline QString getNumaNodes() {return numaNodes;}
+    inline QString getValidationDataset() {return validationDataset;}
+    inline int getValidationPatience() {return validationPatience;}
+    inline int getRandomSeed() {return randomSeed;}
+    inline QString getCheckpointFile() {return checkpointFile;}
+    inline int getCheckpointInterval() {return checkpointInterval;}
+    inline QString getResumeFile() {return resumeFile;}
+    inline int getRunIndex() {return runIndex;}
+    inline QString getBestExportFile() {return bestExportFile;}
+    inline int getBestExportInterval() {return bestExportInterval;}
+    inline QString getLogPrefix() {return logPrefix;}
+    inline QString getLogLevel() {return logLevel;}
+    inline QString getLogFormat() {return logFormat;}
+    inline QString getGenealogyFile() {return genealogyFile;}
+    inline int getGenealogyKeyframes() {return genealogyKeyframes;}
 };
 
 #endif // SYSTEMPARAMETERS_H